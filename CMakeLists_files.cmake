@@ -266,9 +266,11 @@ if(ENABLE_ECL_INPUT)
     src/opm/input/eclipse/Schedule/UDQ/UDQFunction.cpp
     src/opm/input/eclipse/Schedule/UDQ/UDQFunctionTable.cpp
     src/opm/input/eclipse/Schedule/UDQ/UDQInput.cpp
+    src/opm/input/eclipse/Schedule/UDQ/UDQProgram.cpp
     src/opm/input/eclipse/Schedule/UDQ/UDQState.cpp
     src/opm/input/eclipse/Schedule/VFPInjTable.cpp
     src/opm/input/eclipse/Schedule/VFPProdTable.cpp
+    src/opm/input/eclipse/Parser/DeckCache.cpp
     src/opm/input/eclipse/Parser/ErrorGuard.cpp
     src/opm/input/eclipse/Parser/InputErrorAction.cpp
     src/opm/input/eclipse/Parser/ParseContext.cpp
@@ -362,6 +364,7 @@ if(ENABLE_ECL_OUTPUT)
           src/opm/io/eclipse/ESmry_write_rsm.cpp
           src/opm/io/eclipse/OutputStream.cpp
           src/opm/io/eclipse/ExtSmryOutput.cpp
+          src/opm/io/eclipse/SmryCompression.cpp
           src/opm/io/eclipse/RestartFileView.cpp
           src/opm/io/eclipse/SummaryNode.cpp
           src/opm/io/eclipse/rst/action.cpp
@@ -1048,6 +1051,7 @@ if(ENABLE_ECL_INPUT)
        opm/input/eclipse/Units/UnitSystem.hpp
        opm/input/eclipse/Units/Units.hpp
        opm/input/eclipse/Units/Dimension.hpp
+       opm/input/eclipse/Parser/DeckCache.hpp
        opm/input/eclipse/Parser/ErrorGuard.hpp
        opm/input/eclipse/Parser/ParserItem.hpp
        opm/input/eclipse/Parser/Parser.hpp
@@ -1277,6 +1281,7 @@ if(ENABLE_ECL_INPUT)
        opm/input/eclipse/Schedule/UDQ/UDQEnums.hpp
        opm/input/eclipse/Schedule/UDQ/UDQParams.hpp
        opm/input/eclipse/Schedule/UDQ/UDQInput.hpp
+       opm/input/eclipse/Schedule/UDQ/UDQProgram.hpp
        opm/input/eclipse/Schedule/UDQ/UDQActive.hpp
        opm/input/eclipse/Schedule/UDQ/UDQSet.hpp
        opm/input/eclipse/Schedule/UDQ/UDQToken.hpp
@@ -1313,6 +1318,7 @@ if(ENABLE_ECL_OUTPUT)
         opm/io/eclipse/PaddedOutputString.hpp
         opm/io/eclipse/OutputStream.hpp
         opm/io/eclipse/ExtSmryOutput.hpp
+        opm/io/eclipse/SmryCompression.hpp
         opm/io/eclipse/RestartFileView.hpp
         opm/io/eclipse/SummaryNode.hpp
         opm/io/eclipse/rst/action.hpp
@@ -4,6 +4,7 @@
 # HAS_ATTRIBUTE_UNUSED             True if attribute unused is supported
 # HAS_ATTRIBUTE_DEPRECATED         True if attribute deprecated is supported
 # HAS_ATTRIBUTE_DEPRECATED_MSG     True if attribute deprecated("msg") is supported
+# HAVE_FLOATING_POINT_CHARCONV     True if std::from_chars and std::to_chars support double
 
 include(CheckCXXSourceCompiles)
 
@@ -92,6 +93,20 @@ CHECK_CXX_SOURCE_COMPILES("
 "  HAS_ATTRIBUTE_DEPRECATED_MSG
 )
 
+# std::from_chars() and std::to_chars() for floating point values
+CHECK_CXX_SOURCE_COMPILES("
+#include <charconv>
+   int main(void)
+   {
+     char buffer[32];
+     double value = 0.0;
+     std::from_chars(buffer, buffer + sizeof buffer, value);
+     std::to_chars(buffer, buffer + sizeof buffer, value, std::chars_format::scientific, 8);
+     return 0;
+   };
+"  HAVE_FLOATING_POINT_CHARCONV
+)
+
 if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
   if (CMAKE_CXX_COMPILER_VERSION VERSION_LESS 9.0)
     list(APPEND ${project}_LIBRARIES stdc++fs)
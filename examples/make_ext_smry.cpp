@@ -39,6 +39,7 @@ static void printHelp() {
     std::cout << "\nThis program create one or more lodsmry files, designed for effective load on the demand.   \n"
               << "These files are created with input from the smspec and unsmry file. \n"
               << "\nIn addition, the program takes these options (which must be given before the arguments):\n\n"
+              << "-c Compress the summary vectors. Compressed files can only be read by ExtESmry.\n"
               << "-f if ESMRY file exist, this will be replaced. Default behaviour is that existing file is kept.\n"
               << "-n Maximum number of threads to be used if mulitple files should be created.\n"
               << "-h Print help and exit.\n\n";
@@ -52,9 +53,13 @@ int main(int argc, char **argv) {
     int max_threads = -1;
 #endif
     bool force                     = false;
+    bool compressed                = false;
 
-    while ((c = getopt(argc, argv, "fn:h")) != -1) {
+    while ((c = getopt(argc, argv, "cfn:h")) != -1) {
         switch (c) {
+        case 'c':
+            compressed = true;
+            break;
         case 'f':
             force = true;
             break;
@@ -106,7 +111,7 @@ int main(int argc, char **argv) {
 
         try {
             Opm::EclIO::ESmry smry{ argv[f + argOffset] };
-            status[f] = smry.make_esmry_file();
+            status[f] = smry.make_esmry_file(compressed);
             if (! status[f]) {
                 std::cerr << "\n! Warning, smspec already have one esmry file, existing kept use option -f to replace this\n";
             }
@@ -9,6 +9,7 @@ set (opm-common_CONFIG_VAR
 	HAVE_FINAL
 	HAVE_ECL_INPUT
 	HAVE_CXA_DEMANGLE
+	HAVE_FLOATING_POINT_CHARCONV
 	)
 
 # dependencies
@@ -20,18 +20,65 @@
 #ifndef OPM_UTILITY_SHMATCH_HPP
 #define OPM_UTILITY_SHMATCH_HPP
 
+#include <bitset>
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace Opm {
 
 /*
-  The shmatch() function is an implementation of the shell matching algorithm
-  used in posix function fnmatch(). It is implemented here based on std::regex
-  to avoid using a posix function.
+  The ShellPattern class is a compiled shell pattern, with the matching rules
+  of the posix function fnmatch(): '*' matches an arbitrary string, '?' an
+  arbitrary character and '[...]' one character from a set, which can be
+  negated with a leading '!' or '^' and contain ranges like '0-9'. A
+  backslash quotes the following character, all other characters match
+  themselves.
+
+  The pattern should be compiled once and reused when it is matched against
+  many names. The literal prefix of the pattern, i.e. the part before the
+  first wildcard, can be used to narrow down the candidates in a sorted name
+  list.
+*/
+
+class ShellPattern {
+public:
+    explicit ShellPattern(const std::string& pattern);
+
+    bool match(std::string_view symbol) const;
+
+    const std::string& pattern() const;
+    const std::string& literalPrefix() const;
+    bool isLiteral() const;
+
+private:
+    enum class Kind { Literal, AnyChar, AnyString, CharSet };
+
+    struct Element {
+        Kind kind;
+        std::string literal{};
+        std::bitset<256> chars{};
+    };
+
+    std::string m_pattern;
+    std::string m_prefix;
+    std::vector<Element> m_elements;
+    bool m_literal = true;
+
+    bool match_element(const Element& element, std::string_view symbol, std::size_t pos) const;
+};
+
+
+/*
+  The shmatch() function matches one name against a shell pattern. The
+  compiled patterns are kept in a small per thread cache, but when many names
+  are matched against the same pattern a ShellPattern instance should be used
+  directly.
 */
 
 bool shmatch(const std::string& pattern, const std::string& symbol);
 
 
 }
-#endif //OPM_UTILITY_STRING_HPP
+#endif //OPM_UTILITY_SHMATCH_HPP
@@ -25,6 +25,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -107,7 +108,10 @@ namespace Opm {
                 serializer(activeUnits);
                 serializer(m_dataFile);
                 serializer(input_path);
+                serializer(file_tree);
                 serializer(unit_system_access_count);
+                if (!serializer.isSerializing())
+                    this->rebuild_index();
             }
 
             bool hasKeyword( const std::string& keyword ) const;
@@ -119,9 +123,7 @@ namespace Opm {
 
 
 
-            const std::vector<std::size_t> index(const std::string& keyword) const {
-                return this->global_view().index(keyword);
-            }
+            const std::vector<std::size_t> index(const std::string& keyword) const;
 
             template< class Keyword >
             std::size_t count() const {
@@ -142,8 +144,14 @@ namespace Opm {
             DeckTree file_tree;
             mutable std::size_t unit_system_access_count = 0;
 
-            const DeckView& global_view() const;
-            mutable std::unique_ptr<DeckView> m_global_view{nullptr};
+            /*
+              Positions in keywordList for every keyword name. The index is
+              maintained incrementally in addKeyword(), so lookups from the
+              parser do not have to rescan the whole keyword list.
+            */
+            std::unordered_map<std::string, std::vector<std::size_t>> keyword_index;
+
+            void rebuild_index();
     };
 }
 #endif  /* DECK_HPP */
@@ -21,6 +21,7 @@
 #define DECKITEM_HPP
 
 #include <string>
+#include <variant>
 #include <vector>
 #include <memory>
 #include <iosfwd>
@@ -46,6 +47,13 @@ namespace Opm {
         DeckItem( const std::string&, UDAValue, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim);
         DeckItem( const std::string&, double, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim);
 
+        // The name is shared with the ParserItem which created the item.
+        DeckItem( std::shared_ptr<const std::string>, int);
+        DeckItem( std::shared_ptr<const std::string>, RawString);
+        DeckItem( std::shared_ptr<const std::string>, std::string);
+        DeckItem( std::shared_ptr<const std::string>, UDAValue, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim);
+        DeckItem( std::shared_ptr<const std::string>, double, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim);
+
         static DeckItem serializationTestObject();
 
         const std::string& name() const;
@@ -132,18 +140,17 @@ namespace Opm {
         bool is_string() { return  type == get_type< std::string >(); };
         bool is_raw_string() { return  type == get_type< RawString >(); };
 
-        UDAValue& get_uda() { return uval[0]; };
+        UDAValue& get_uda();
 
         template<class Serializer>
         void serializeOp(Serializer& serializer)
         {
-            serializer(dval);
-            serializer(ival);
-            serializer(sval);
-            serializer(rsval);
-            serializer(uval);
+            std::string name = this->name();
+            serializer(values);
             serializer(type);
-            serializer(item_name);
+            serializer(name);
+            if (!serializer.isSerializing())
+                item_name = std::make_shared<const std::string>(std::move(name));
             serializer(value_status);
             serializer(raw_data);
             serializer(active_dimensions);
@@ -152,24 +159,33 @@ namespace Opm {
 
         void reserve_additionalRawString(std::size_t);
     private:
-        mutable std::vector< double > dval;
-        std::vector< int > ival;
-        std::vector< std::string > sval;
-        std::vector< RawString > rsval;
-        std::vector< UDAValue > uval;
-
-        type_tag type = type_tag::unknown;
+        /*
+          Only the vector corresponding to the type member is in use, so the
+          values are stored in a variant instead of one vector per type.
+        */
+        using value_vector = std::variant< std::vector< double >,
+                                           std::vector< int >,
+                                           std::vector< std::string >,
+                                           std::vector< RawString >,
+                                           std::vector< UDAValue > >;
+        mutable value_vector values;
 
-        std::string item_name;
+        /*
+          All the items created from the same ParserItem share the name
+          string.
+        */
+        std::shared_ptr<const std::string> item_name;
         std::vector<value::status> value_status;
+        std::vector< Dimension > active_dimensions;
+        std::vector< Dimension > default_dimensions;
+
+        type_tag type = type_tag::unknown;
         /*
-          To save space we mutate the dval object in place when asking for SI
-          data; the current state of of the dval member is tracked with the
+          To save space we mutate the double values in place when asking for
+          SI data; the current state of the values is tracked with the
           raw_data bool member.
         */
         mutable bool raw_data = true;
-        std::vector< Dimension > active_dimensions;
-        std::vector< Dimension > default_dimensions;
 
         template< typename T > std::vector< T >& value_ref();
         template< typename T > const std::vector< T >& value_ref() const;
@@ -140,6 +140,17 @@ namespace Opm {
       pass a field in the solution section which Eclipse does not recognize you
       will end up with a restart file which Eclipse can not read, even if you
       have set ecl_compatible_restart to true.
+
+
+      ESMRY layout
+      ============
+
+      By default the ESMRY file written alongside the summary output has the
+      classic layout, which is rewritten completely on every flush. With
+      chunked_esmry set the file is append-only, and with compressed_esmry
+      set the chunks are also compressed - which implies the chunked layout.
+      Files with the chunked layout can not be read by older versions of
+      ExtESmry, so both options are off by default. See ExtSmryOutput.hpp.
     */
 
 
@@ -156,6 +167,10 @@ namespace Opm {
 
         void setEclCompatibleRST(bool ecl_rst);
         bool getEclCompatibleRST() const;
+        void setChunkedESMRY(bool chunked);
+        bool getChunkedESMRY() const;
+        void setCompressedESMRY(bool compressed);
+        bool getCompressedESMRY() const;
         bool getWriteEGRIDFile() const;
         bool getWriteINITFile() const;
         bool getUNIFOUT() const;
@@ -205,6 +220,8 @@ namespace Opm {
             serializer(m_nosim);
             serializer(m_base_name);
             serializer(ecl_compatible_rst);
+            serializer(chunked_esmry);
+            serializer(compressed_esmry);
         }
 
     private:
@@ -220,6 +237,8 @@ namespace Opm {
         bool            m_nosim;
         std::string     m_base_name;
         bool            ecl_compatible_rst = true;
+        bool            chunked_esmry = false;
+        bool            compressed_esmry = false;
 
         IOConfig( const GRIDSection&,
                   const RUNSPECSection&,
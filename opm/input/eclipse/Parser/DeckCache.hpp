@@ -0,0 +1,100 @@
+/*
+  Copyright 2026 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_DECK_CACHE_HPP
+#define OPM_DECK_CACHE_HPP
+
+#include <opm/input/eclipse/Deck/Deck.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+/*
+  Binary on-disk cache of parsed decks. The cache entry for a deck is a file
+  in the cache directory with
+
+    1. A header with the format version, a key describing the parser
+       configuration, the content hash of every input file - i.e. the
+       DATA file, all INCLUDE files and all IMPORT files - and the
+       ParseContext warnings which were raised when the deck was parsed.
+
+    2. The Deck, packed with the Serializer and MemPacker.
+
+  A cache entry is only used if the format version and the key match, and
+  all the input files still have the same content. Changing any include file
+  will therefore invalidate the cache entry, and the deck will be parsed
+  again.
+*/
+
+class DeckCache {
+public:
+    // Pairs of (ParseContext key, message), as in the ErrorGuard.
+    using Warnings = std::vector<std::pair<std::string, std::string>>;
+
+    // Pairs of (input file, content hash).
+    using InputFiles = std::vector<std::pair<std::filesystem::path, std::uint64_t>>;
+
+    struct Entry {
+        Deck deck;
+        Warnings warnings;
+    };
+
+    explicit DeckCache(const std::filesystem::path& directory);
+
+    /*
+      Returns the cached deck for the data file, or an empty optional if
+      there is no valid cache entry. The data_file argument must be the
+      same string which was passed to store().
+    */
+    std::optional<Entry> load(const std::string& data_file, std::uint64_t key) const;
+
+    /*
+      Writes a cache entry for the deck. The input_files argument should
+      list all files which were read when creating the deck, together with
+      the hash of the content as it was read by the parser - the files are
+      not read again here, so a file which is modified while the deck is
+      parsed will not be validated against the new content. Will return
+      false if the entry could not be written.
+    */
+    bool store(const Deck& deck,
+               const std::string& data_file,
+               const InputFiles& input_files,
+               const Warnings& warnings,
+               std::uint64_t key) const;
+
+    std::filesystem::path cacheFile(const std::string& data_file) const;
+
+    // The content hash of a file equals hash() of the file content.
+    static std::uint64_t contentHash(const std::filesystem::path& file);
+    static std::uint64_t hash(std::string_view data, std::uint64_t seed = 0);
+
+private:
+    std::filesystem::path directory;
+};
+
+}
+
+#endif
@@ -20,12 +20,16 @@
 #ifndef OPM_PARSER_HPP
 #define OPM_PARSER_HPP
 
+#include <cstdint>
 #include <filesystem>
 #include <iosfwd>
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -87,10 +91,30 @@ namespace Opm {
 
         Deck parseStream(std::unique_ptr<std::istream>&& inputStream , const ParseContext& parseContext, ErrorGuard& errors) const;
 
+        /// Opt-in multi-threaded parsing. With more than one thread the large
+        /// data keywords (PORO, ZCORN, ...) are converted to DeckKeywords on
+        /// worker threads while the main thread continues reading the input
+        /// files. The resulting deck is the same as with a single thread.
+        void setNumThreads(std::size_t num_threads);
+        std::size_t numThreads() const;
+
+        /// Use a binary deck cache in the given directory for parseFile().
+        /// An unchanged deck is then loaded from the cache instead of being
+        /// parsed; the cache entry is invalidated when the content of the
+        /// DATA file or any of the included files changes.
+        void setDeckCache(const std::filesystem::path& directory);
+
         /// Method to add ParserKeyword instances, these holding type and size information about the keywords and their data.
         void addParserKeyword(const Json::JsonObject& jsonKeyword);
         void addParserKeyword(ParserKeyword parserKeyword);
 
+        /// Registers a keyword which is only constructed by the factory the
+        /// first time it is looked up. This is used by the generated
+        /// addDefaultKeywords(), so that constructing a Parser does not
+        /// build all the builtin keywords. The keyword must be recognized by
+        /// its name only, and the name must refer to static storage.
+        void addLazyParserKeyword(std::string_view name, ParserKeyword (*factory)());
+
         /*!
          * \brief Returns whether the parser knows about a keyword
          */
@@ -99,6 +123,11 @@ namespace Opm {
 
         bool isRecognizedKeyword( const std::string_view& deckKeywordName) const;
         const ParserKeyword& getParserKeywordFromDeckName(const std::string_view& deckKeywordName) const;
+
+        /// Returns the keyword for the deck name, or nullptr if the deck
+        /// name is not recognized; a single lookup replacing the pair
+        /// isRecognizedKeyword() and getParserKeywordFromDeckName().
+        const ParserKeyword* findParserKeyword(const std::string_view& deckKeywordName) const;
         std::vector<std::string> getAllDeckNames () const;
 
         void loadKeywords(const Json::JsonObject& jsonKeywords);
@@ -148,19 +177,33 @@ namespace Opm {
     private:
         bool hasWildCardKeyword(const std::string& keyword) const;
         const ParserKeyword* matchingKeyword(const std::string_view& keyword) const;
+        const ParserKeyword* storedKeyword(const std::string_view& deckKeywordName) const;
         void addDefaultKeywords();
+        std::uint64_t deckCacheKey(const ParseContext& parseContext) const;
+
+        // Hash of the builtin keyword definitions; implemented in the
+        // generated ParserInit.cpp.
+        static std::uint64_t builtinKeywordsHash();
 
         // std::vector< std::unique_ptr< const ParserKeyword > > keyword_storage;
         std::list<ParserKeyword> keyword_storage;
 
         // associative map of deck names and the corresponding ParserKeyword object
-        std::map< std::string_view, const ParserKeyword* > m_deckParserKeywords;
+        std::unordered_map< std::string_view, const ParserKeyword* > m_deckParserKeywords;
+
+        // keywords registered with addLazyParserKeyword(); the entries are
+        // shared between copies of the Parser
+        struct LazyKeyword;
+        std::unordered_map< std::string_view, std::shared_ptr<LazyKeyword> > m_lazyKeywords;
 
         // associative map of the parser internal names and the corresponding
         // ParserKeyword object for keywords which match a regular expression
         std::map< std::string_view, const ParserKeyword* > m_wildCardKeywords;
 
         std::vector<std::pair<std::string,std::string>> code_keywords;
+
+        std::size_t num_threads = 1;
+        std::optional<std::filesystem::path> deck_cache_directory;
     };
 
 } // namespace Opm
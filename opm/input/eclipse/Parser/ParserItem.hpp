@@ -110,7 +110,8 @@ namespace Opm {
         UDAValue uval{};
         std::vector< std::string > m_dimensions;
 
-        std::string m_name;
+        // shared with the DeckItems created by scan()
+        std::shared_ptr<const std::string> m_name;
         item_size m_sizeType = item_size::SINGLE;
         std::string m_description;
 
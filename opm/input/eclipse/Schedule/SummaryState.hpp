@@ -23,11 +23,15 @@
 #include <opm/common/utility/TimeService.hpp>
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
+#include <iterator>
 #include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Opm {
@@ -63,11 +67,69 @@ class UDQSet;
 //     // accessible through the specialized st.has_well_var("OPY", "WGOR").
 //     st.has("WGOR:OPY") => True
 //     st.has_well_var("OPY", "WGOR") => False
+//
+// The values are stored in a contiguous array, and every key is assigned a
+// slot in the array when it is first updated. The slot of a specialized
+// value is linked to the slot of the general key, so that updates of the
+// specialized value are applied to both. A Handle to the slot of a key can
+// be used to read and update the value without any string lookups:
+//
+//     st.update_well_var("OPX", "WOPR", 100);
+//     auto wopr = *st.well_var_handle("OPX", "WOPR");
+//     st.update(wopr, 120);
+//     st.get(wopr) => 120
+//
+// Slots are never moved, but the slot of an erased key is reused for keys
+// which are added later. A handle is valid for the SummaryState it was
+// created from and for all copies of it, as long as the layout_id() is
+// unchanged; the handle of a key which is erased must not be used. The
+// layout_id() changes whenever keys are added or erased; two states with
+// the same layout_id() have the same slot for every key.
 
 class SummaryState
 {
+    using SlotMap = std::unordered_map<std::string, std::size_t>;
+
 public:
-    typedef std::unordered_map<std::string, double>::const_iterator const_iterator;
+    struct Handle
+    {
+        std::size_t slot;
+    };
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::pair<std::string, double>;
+        using reference         = std::pair<const std::string&, double>;
+        using difference_type   = std::ptrdiff_t;
+
+        // The elements are created on the fly, operator->() returns a
+        // proxy holding the element.
+        struct pointer
+        {
+            reference elm;
+            const reference* operator->() const { return &this->elm; }
+        };
+
+        const_iterator() = default;
+
+        const_iterator(SlotMap::const_iterator iter, const std::vector<double>& values)
+            : m_iter(iter), m_values(&values)
+        {}
+
+        reference operator*() const { return { this->m_iter->first, (*this->m_values)[this->m_iter->second] }; }
+        pointer operator->() const { return { **this }; }
+        const_iterator& operator++() { ++this->m_iter; return *this; }
+        const_iterator operator++(int) { auto prev = *this; ++this->m_iter; return prev; }
+        bool operator==(const const_iterator& other) const { return this->m_iter == other.m_iter; }
+        bool operator!=(const const_iterator& other) const { return this->m_iter != other.m_iter; }
+
+    private:
+        SlotMap::const_iterator m_iter{};
+        const std::vector<double>* m_values{nullptr};
+    };
+
     explicit SummaryState(time_point sim_start_arg);
 
     // The std::time_t constructor is only for export to Python
@@ -115,6 +177,21 @@ public:
     double get_conn_var(const std::string& conn, const std::string& var, std::size_t global_index, double) const;
     double get_segment_var(const std::string& well, const std::string& var, std::size_t segment, double) const;
 
+    std::optional<Handle> handle(const std::string& key) const;
+    std::optional<Handle> well_var_handle(const std::string& well, const std::string& var) const;
+    std::optional<Handle> group_var_handle(const std::string& group, const std::string& var) const;
+    std::optional<Handle> conn_var_handle(const std::string& well, const std::string& var, std::size_t global_index) const;
+    std::optional<Handle> segment_var_handle(const std::string& well, const std::string& var, std::size_t segment) const;
+
+    // Accumulates or assigns like the update_xxx() methods, an update of a
+    // specialized value is also applied to the linked general value.
+    void update(Handle handle, double value);
+    double get(Handle handle) const;
+
+    // All values, indexed by Handle::slot.
+    const std::vector<double>& slot_values() const;
+    std::uint64_t layout_id() const;
+
     const std::vector<std::string>& wells() const;
     std::vector<std::string> wells(const std::string& var) const;
     const std::vector<std::string>& groups() const;
@@ -131,6 +208,10 @@ public:
     {
       serializer(sim_start);
       serializer(elapsed);
+      serializer(m_values);
+      serializer(m_flags);
+      serializer(m_link);
+      serializer(m_free);
       serializer(values);
       serializer(well_values);
       serializer(m_wells);
@@ -140,6 +221,7 @@ public:
       serializer(group_names);
       serializer(conn_values);
       serializer(segment_values);
+      this->m_layout_id = next_layout_id();
     }
 
     static SummaryState serializationTestObject();
@@ -147,25 +229,59 @@ public:
 private:
     time_point sim_start;
     double elapsed = 0;
-    std::unordered_map<std::string,double> values;
+
+    // The values of all slots. Per slot a combination of the flags below,
+    // and for specialized values the slot of the general key. Slots which
+    // are no longer in use are kept in m_free.
+    std::vector<double> m_values;
+    std::vector<unsigned char> m_flags;
+    std::vector<std::size_t> m_link;
+    std::vector<std::size_t> m_free;
+    std::uint64_t m_layout_id;
+
+    static constexpr unsigned char total_flag = 1;
+    static constexpr unsigned char general_flag = 2;
+    static constexpr std::size_t no_link = static_cast<std::size_t>(-1);
+
+    // The maps below all map to slots in m_values.
+    SlotMap values;
 
     // The first key is the variable and the second key is the well.
-    std::unordered_map<std::string, std::unordered_map<std::string, double>> well_values;
+    std::unordered_map<std::string, SlotMap> well_values;
     std::set<std::string> m_wells;
     mutable std::optional<std::vector<std::string>> well_names;
 
     // The first key is the variable and the second key is the group.
-    std::unordered_map<std::string, std::unordered_map<std::string, double>> group_values;
+    std::unordered_map<std::string, SlotMap> group_values;
     std::set<std::string> m_groups;
     mutable std::optional<std::vector<std::string>> group_names;
 
     // The first key is the variable and the second key is the well and the
     // third is the global index. NB: The global_index has offset 1!
-    std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<std::size_t, double>>> conn_values;
+    std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<std::size_t, std::size_t>>> conn_values;
 
     // The first key is the variable and the second key is the well and the
     // third is the one-based segment number.
-    std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<std::size_t, double>>> segment_values;
+    std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<std::size_t, std::size_t>>> segment_values;
+
+    static std::uint64_t next_layout_id();
+
+    std::size_t add_slot(const std::string& var);
+    void release_slot(std::size_t slot);
+    void drop_stale_links();
+    std::size_t key_slot(const std::string& key);
+    std::size_t var_slot(std::unordered_map<std::string, SlotMap>& var_values,
+                         std::set<std::string>& names,
+                         std::optional<std::vector<std::string>>& name_list,
+                         const std::string& name,
+                         const std::string& var);
+    std::size_t indexed_slot(std::unordered_map<std::size_t, std::size_t>& slots,
+                             const std::string& well,
+                             const std::string& var,
+                             std::size_t index);
+    bool is_linked(std::size_t slot) const;
+    std::size_t link_slot(std::size_t slot, const std::string& key);
+    void update_slot(std::size_t slot, double value);
 };
 
 std::ostream& operator<<(std::ostream& stream, const SummaryState& st);
@@ -75,6 +75,8 @@ public:
     }
 
 private:
+    friend class UDQProgram;
+
     UDQTokenType type;
 
     std::variant<std::string, double> value;
@@ -40,6 +40,7 @@
 namespace Opm {
 
 class UDQASTNode;
+class UDQProgram;
 class ParseContext;
 class ErrorGuard;
 
@@ -101,6 +102,10 @@ public:
         serializer(string_data);
         serializer(m_update_status);
         serializer(m_report_step);
+
+        // The compiled program belongs to the previous expression tree.
+        if (!serializer.isSerializing())
+            this->program.reset();
     }
 
 private:
@@ -112,6 +117,7 @@ private:
     std::size_t m_report_step;
     UDQUpdate m_update_status;
     mutable std::optional<std::string> string_data;
+    mutable std::shared_ptr<const UDQProgram> program;
 
     UDQSet scatter_scalar_value(UDQSet&& res, const UDQContext& context) const;
     UDQSet scatter_scalar_well_value(const UDQContext& context, const std::optional<double>& value) const;
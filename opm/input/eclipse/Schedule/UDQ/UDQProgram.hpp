@@ -0,0 +1,112 @@
+/*
+  Copyright 2026 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef UDQ_PROGRAM_HPP
+#define UDQ_PROGRAM_HPP
+
+#include <opm/input/eclipse/Schedule/UDQ/UDQEnums.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+class UDQASTNode;
+class UDQContext;
+class UDQSet;
+
+/// Compiled form of a UDQ DEFINE expression.
+///
+/// The expression tree is flattened into a linear sequence of instructions
+/// evaluated on a stack of dense columns.  A column holds one value and one
+/// defined flag per element, where the elements are aligned with the well
+/// or group order of the UDQ context, so no name matching is needed when
+/// combining two columns.  The elementwise and reduction kernels replicate
+/// the operations of UDQSet and UDQFunction exactly, including the order of
+/// the floating point operations in the reductions.
+///
+/// Expressions involving the random number functions or table lookups are
+/// not compiled, and any irregular condition encountered during evaluation,
+/// like mismatched set sizes or invalid function arguments, makes eval()
+/// return nullopt.  The caller is expected to evaluate the expression tree
+/// with UDQASTNode::eval() in that case, which then produces the same
+/// result or diagnostic as before.
+class UDQProgram
+{
+public:
+    /// Compile expression tree.
+    ///
+    /// \param[in] ast Expression tree of UDQ DEFINE statement.
+    ///
+    /// \param[in] target_type Variable type of the UDQ being defined.
+    UDQProgram(const UDQASTNode& ast, UDQVarType target_type);
+
+    /// Whether or not the expression could be compiled.
+    bool valid() const;
+
+    /// Number of instructions in compiled program.
+    std::size_t size() const;
+
+    /// Evaluate compiled program.
+    ///
+    /// \param[in] context Source of summary and UDQ values, and of the
+    ///    current well and group names.
+    ///
+    /// \return Result set.  Nullopt if the program is not valid, or if the
+    ///    expression must be evaluated by the expression tree.
+    std::optional<UDQSet> eval(const UDQContext& context) const;
+
+private:
+    enum class OpCode
+    {
+        WellVariable,
+        WellVariableSet,
+        WellScalar,
+        GroupVariable,
+        GroupScalar,
+        FieldVariable,
+        Scalar,
+        Number,
+        Scale,
+        ScalarFunction,
+        UnaryFunction,
+        BinaryFunction,
+    };
+
+    struct Instruction
+    {
+        OpCode op;
+        UDQTokenType func = UDQTokenType::error;
+        double value = 0.0;
+        std::string keyword{};
+        std::string selector{};
+    };
+
+    UDQVarType m_target_type;
+    std::vector<Instruction> m_code;
+    bool m_valid = false;
+
+    bool compile(const UDQASTNode& node);
+};
+
+} // namespace Opm
+
+#endif // UDQ_PROGRAM_HPP
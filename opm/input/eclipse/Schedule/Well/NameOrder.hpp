@@ -28,8 +28,13 @@
 
 namespace Opm {
 
+class ShellPattern;
+
 // The purpose of this small class is to ensure that well and group name
-// always come in the order they are defined in the deck.
+// always come in the order they are defined in the deck. In addition the
+// classes maintain an index of the names in lexicographical order, so that
+// the names matching a shell pattern can be found by looking only at the
+// names starting with the literal prefix of the pattern.
 
 class NameOrder
 {
@@ -41,6 +46,7 @@ public:
     void add(const std::string& name);
     std::vector<std::string> sort(std::vector<std::string> names) const;
     const std::vector<std::string>& names() const;
+    std::vector<std::string> names(const ShellPattern& pattern) const;
     bool has(const std::string& wname) const;
     std::size_t size() const;
 
@@ -49,6 +55,8 @@ public:
     {
         serializer(m_index_map);
         serializer(m_name_list);
+        if (!serializer.isSerializing())
+            this->build_sorted_index();
     }
 
     static NameOrder serializationTestObject();
@@ -61,6 +69,9 @@ public:
 private:
     std::unordered_map<std::string, std::size_t> m_index_map;
     std::vector<std::string> m_name_list;
+    std::vector<std::size_t> m_sorted_index;
+
+    void build_sorted_index();
 };
 
 class GroupOrder
@@ -71,6 +82,7 @@ public:
 
     void add(const std::string& name);
     const std::vector<std::string>& names() const;
+    std::vector<std::string> names(const ShellPattern& pattern) const;
     bool has(const std::string& wname) const;
     std::vector<std::optional<std::string>> restart_groups() const;
 
@@ -79,6 +91,8 @@ public:
     {
         serializer(m_name_list);
         serializer(m_max_groups);
+        if (!serializer.isSerializing())
+            this->build_sorted_index();
     }
 
     static GroupOrder serializationTestObject();
@@ -90,6 +104,9 @@ public:
 private:
     std::vector<std::string> m_name_list;
     std::size_t m_max_groups;
+    std::vector<std::size_t> m_sorted_index;
+
+    void build_sorted_index();
 };
 
 } // namespace Opm
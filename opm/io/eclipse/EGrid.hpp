@@ -22,8 +22,12 @@
 #include <opm/io/eclipse/EclFile.hpp>
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <map>
 
@@ -45,6 +49,10 @@ public:
     void getCellCorners(int globindex, std::array<double,8>& X, std::array<double,8>& Y, std::array<double,8>& Z);
     void getCellCorners(const std::array<int, 3>& ijk, std::array<double,8>& X, std::array<double,8>& Y, std::array<double,8>& Z);
 
+    // corners of all cells in ijk_list, X, Y and Z are resized to the number of cells
+    void getCellCorners(const std::vector<std::array<int, 3>>& ijk_list, std::vector<std::array<double,8>>& X,
+                        std::vector<std::array<double,8>>& Y, std::vector<std::array<double,8>>& Z);
+
     std::vector<std::array<float, 3>> getXYZ_layer(int layer, bool bottom=false);
     std::vector<std::array<float, 3>> getXYZ_layer(int layer, const std::array<int, 4>& box, bool bottom=false);
 
@@ -53,6 +61,13 @@ public:
 
     void load_grid_data();
     void load_nnc_data();
+
+    // With a geometry cache, getCellCorners() and getXYZ_layer() read COORD
+    // and ZCORN for the rows of cells they need from an unformatted EGRID
+    // file, instead of loading the complete arrays. The least recently used
+    // parts are dropped when the cache uses more than max_bytes. The default
+    // is no cache; not used for formatted files or after load_grid_data().
+    void setGeometryCacheSize(std::size_t max_bytes);
     bool is_radial() const { return m_radial; }
 
     const std::vector<int>& hostCellsGlobalIndex() const { return host_cells; }
@@ -100,8 +115,25 @@ private:
     int nnc1_array_index;
     int nnc2_array_index;
 
+    // COORD for a range of pillar rows or ZCORN for a range of rows in one layer
+    struct GeometryTile {
+        std::vector<float> data;
+        uint64_t last_use;
+    };
+
+    std::size_t m_cache_max_bytes = 0;
+    std::size_t m_cache_bytes = 0;
+    uint64_t m_tile_use_count = 0;
+    std::unordered_map<int64_t, GeometryTile> m_geometry_tiles;
+
     std::vector<float> get_zcorn_from_disk(int layer, bool bottom);
 
+    bool use_geometry_cache() const;
+    const std::vector<float>& geometry_tile(std::fstream& fileH, bool zcorn, int layer, int tile);
+    void evict_geometry_tiles(std::size_t num_keep);
+    void cached_cell_geometry(std::fstream& fileH, const std::array<int, 3>& ijk,
+                              std::array<const float*, 4>& pillars, std::array<double,8>& Z);
+
     void getCellCorners(const std::array<int, 3>& ijk, const std::vector<float>& zcorn_layer,
                            std::array<double,4>& X, std::array<double,4>& Y, std::array<double,4>& Z);
 
@@ -20,6 +20,7 @@
 #define OPM_IO_ESMRY_HPP
 
 #include <chrono>
+#include <cstddef>
 #include <filesystem>
 #include <iosfwd>
 #include <string>
@@ -59,7 +60,8 @@ public:
     void loadData(const std::vector<std::string>& vectList) const;
     void loadData() const;
 
-    bool make_esmry_file();
+    // compressed esmry files are written in chunks, see SmryCompression.hpp
+    bool make_esmry_file(bool compressed = false);
 
     time_point startdate() const { return tp_startdat; }
     std::vector<int> start_v() const { return start_vect; }
@@ -82,6 +84,12 @@ public:
     std::string rootname() { return inputFileName.stem(); }
     std::tuple<double, double> get_io_elapsed() const;
 
+    // Follow mode for summary files from an active run. Reads the time steps
+    // which have been appended to the summary data files since the object
+    // was created or last updated, and extends the vectors which are already
+    // loaded. Returns the number of new time steps.
+    std::size_t update();
+
 private:
     std::filesystem::path inputFileName;
     RstEntry restart_info;
@@ -106,6 +114,14 @@ private:
     std::vector<int> seqIndex;
     std::vector<int> mini_steps;
 
+    // data file and position of the first array not yet consumed, used by update()
+    std::string followFile;
+    uint64_t followPos = 0;
+
+    // true if the last time step is in seqIndex only because it was the last
+    // time step in the file
+    bool provisionalReportStep = false;
+
     void ijk_from_global_index(int glob, int &i, int &j, int &k) const;
 
     std::vector<SummaryNode> summaryNodes;
@@ -147,10 +163,13 @@ private:
         return result;
     }
 
-    std::vector<std::tuple <std::string, uint64_t>> getListOfArrays(std::string filename, bool formatted);
+    std::vector<std::tuple <std::string, uint64_t>> getListOfArrays(const std::string& filename, bool formatted,
+                                                                    uint64_t fromPos, uint64_t& endPos) const;
     std::vector<int> makeKeywPosVector(int speInd) const;
     std::string read_string_from_disk(std::fstream& fileH, uint64_t size) const;
 
+    void readParams(const std::vector<int>& keywIndVect, std::size_t fromStep) const;
+
     void read_ministeps_from_disk();
     int read_ministep_formatted(std::fstream& fileH);
 };
@@ -21,6 +21,8 @@
 
 #include <opm/io/eclipse/EclIOdata.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <ios>
 #include <map>
 #include <string>
@@ -47,6 +49,12 @@ public:
     void loadData(int arrIndex);                // load data based on array indices in vector arrIndex
     void loadData(const std::vector<int>& arrIndex);   // load data based on array indices in vector arrIndex
 
+    // Load binary arrays concurrently with this number of threads when
+    // more than one array is loaded, and parse large formatted arrays
+    // with this number of threads; the default is a single thread.
+    void setNumThreads(std::size_t numThreads) { num_threads = std::max(numThreads, std::size_t{1}); }
+    std::size_t numThreads() const { return num_threads; }
+
     void clearData()
     {
       inte_array.clear();
@@ -103,8 +111,12 @@ protected:
 
 private:
     std::vector<bool> arrayLoaded;
+    std::size_t num_threads = 1;
 
     void loadBinaryArray(std::fstream& fileH, std::size_t arrIndex);
+    void createArray(std::size_t arrIndex);
+    void readBinaryArrayData(std::fstream& fileH, std::size_t arrIndex);
+    void loadBinaryArraysParallel(const std::vector<int>& arrIndex);
     void loadFormattedArray(const std::string& fileStr, std::size_t arrIndex, int64_t fromPos);
     void load(bool preload);
 
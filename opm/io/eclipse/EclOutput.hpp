@@ -18,6 +18,8 @@
 #ifndef OPM_IO_ECLOUTPUT_HPP
 #define OPM_IO_ECLOUTPUT_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <fstream>
 #include <ios>
 #include <string>
@@ -84,6 +86,9 @@ public:
 
     void set_ix() { ix_standard = true; }
 
+    // Number of threads used to format large arrays in formatted files.
+    void setNumThreads(std::size_t numThreads) { num_threads = std::max(numThreads, std::size_t{1}); }
+
     friend class OutputStream::Restart;
     friend class OutputStream::SummarySpecification;
 
@@ -111,6 +116,7 @@ private:
     std::string make_doub_string_ix(double value) const;
 
     bool isFormatted, ix_standard;
+    std::size_t num_threads = 1;
     std::ofstream ofileH;
 };
 
@@ -21,6 +21,7 @@
 
 #include <opm/io/eclipse/EclIOdata.hpp>
 
+#include <cstddef>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -81,16 +82,20 @@ namespace Opm { namespace EclIO {
     std::vector<T> readFormattedArray(const std::string& file_str, const int size, int64_t fromPos,
                                        std::function<T(const std::string&)>& process);
 
-    std::vector<int> readFormattedInteArray(const std::string& file_str, const int64_t size, int64_t fromPos);
+    std::vector<int> readFormattedInteArray(const std::string& file_str, const int64_t size, int64_t fromPos,
+                                            std::size_t num_threads = 1);
 
     std::vector<std::string> readFormattedCharArray(const std::string& file_str, const int64_t size,
                                                     int64_t fromPos, int elementSize);
 
-    std::vector<float> readFormattedRealArray(const std::string& file_str, const int64_t size, int64_t fromPos);
+    std::vector<float> readFormattedRealArray(const std::string& file_str, const int64_t size, int64_t fromPos,
+                                              std::size_t num_threads = 1);
     std::vector<std::string> readFormattedRealRawStrings(const std::string& file_str, const int64_t size, int64_t fromPos);
 
-    std::vector<bool> readFormattedLogiArray(const std::string& file_str, const int64_t size, int64_t fromPos);
-    std::vector<double> readFormattedDoubArray(const std::string& file_str, const int64_t size, int64_t fromPos);
+    std::vector<bool> readFormattedLogiArray(const std::string& file_str, const int64_t size, int64_t fromPos,
+                                             std::size_t num_threads = 1);
+    std::vector<double> readFormattedDoubArray(const std::string& file_str, const int64_t size, int64_t fromPos,
+                                               std::size_t num_threads = 1);
 
 }} // namespace Opm::EclIO
 
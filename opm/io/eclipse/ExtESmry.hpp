@@ -20,6 +20,7 @@
 #define OPM_IO_ExtESmry_HPP
 
 #include <chrono>
+#include <cstddef>
 #include <filesystem>
 #include <string>
 #include <unordered_map>
@@ -35,6 +36,10 @@ using ArrSourceEntry = std::tuple<std::string, std::string, int, uint64_t>;
 using TimeStepEntry = std::tuple<int, int, uint64_t>;
 using RstEntry = std::tuple<std::string, int>;
 
+// file offset of the V0 array (VINDEX if compressed) in a chunk, number of
+// time steps in the chunk, codec
+using SmryChunkEntry = std::tuple<uint64_t, int64_t, int>;
+
 // start, rstart + rstnum, keycheck, units, rstep, tstep
 using ExtSmryHeadType = std::tuple<time_point, RstEntry, std::vector<std::string>, std::vector<std::string>,
                                     std::vector<int>, std::vector<int>>;
@@ -70,6 +75,12 @@ public:
     std::string rootname() { return m_inputFileName.stem(); }
     std::tuple<double, double> get_io_elapsed() const;
 
+    // Follow mode for ESMRY files from an active run. Reads the chunks which
+    // have been appended to the file since the object was created or last
+    // updated, and extends the vectors which are already loaded. Returns the
+    // number of new time steps, always zero for files not written in chunks.
+    std::size_t update();
+
 private:
     std::filesystem::path m_inputFileName;
     std::vector<std::filesystem::path> m_esmry_files;
@@ -93,16 +104,23 @@ private:
 
     std::vector<uint64_t> m_rstep_offset;
 
+    // empty for ESMRY files which are not written in chunks
+    std::vector<std::vector<SmryChunkEntry>> m_chunks;
+
+    // file offset after the last chunk read from the input file, used by update()
+    uint64_t m_chunks_end = 0;
+
     time_point m_startdat;
     std::vector<int> m_start_vect;
 
     double m_io_opening;
     double m_io_loading;
 
-    bool open_esmry(const std::filesystem::path& inputFileName, ExtSmryHeadType& ext_smry_head, uint64_t& rstep_offset);
+    bool open_esmry(const std::filesystem::path& inputFileName, ExtSmryHeadType& ext_smry_head, uint64_t& rstep_offset,
+                    std::vector<SmryChunkEntry>& chunks, uint64_t& chunks_end);
 
     bool load_esmry(const std::vector<std::string>& stringVect, const std::vector<int>& keyIndexVect,
-                               const std::vector<int>& loadKeyIndex, int ind, int to_ind );
+                               const std::vector<int>& loadKeyIndex, int ind, int to_ind, std::size_t first_chunk = 0);
 
     void updatePathAndRootName(std::filesystem::path& dir, std::filesystem::path& rootN);
 };
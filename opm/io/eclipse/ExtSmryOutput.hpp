@@ -21,6 +21,8 @@
 
 #include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -31,13 +33,44 @@ class GridDims;
 
 namespace EclIO {
 
+/*
+  Writes the summary data of a running simulation to an ESMRY file. By
+  default the file has the classic layout
+
+      START, RESTART/RSTNUM, KEYCHECK, UNITS, RSTEP, TSTEP, V0 .. Vn
+
+  and the complete file is rewritten on every flush.
+
+  With the chunked layout the file is append-only; after the header (START,
+  RESTART/RSTNUM, KEYCHECK and UNITS) the time steps are written in chunks
+
+      CHUNK   INTE  [number of time steps, number of vectors]
+      RSTEP   INTE  report step flags for the time steps in the chunk
+      TSTEP   INTE  time step indices for the time steps in the chunk
+      V0 .. Vn REAL one array for each vector
+
+  Every flush appends one chunk with the time steps seen since the previous
+  flush, and only these time steps are kept in memory. Readers only use
+  chunks which are completely written, so the file is always consistent
+  even if the simulation is stopped in the middle of a write.
+
+  With compression enabled the chunks are compressed, see SmryCompression.hpp,
+  and have a fixed number of time steps; only the last chunk, written with
+  the final summary, can be smaller. Compression implies the chunked layout.
+
+  The chunked layout can only be read by ExtESmry from this version on, and
+  is only supported for unformatted output. The summary output selects the
+  layout with IOConfig::setChunkedESMRY() and IOConfig::setCompressedESMRY().
+*/
 class ExtSmryOutput
 {
 public:
     ExtSmryOutput(const std::vector<std::string>& valueKeys,
                   const std::vector<std::string>& valueUnits,
                   const EclipseState& es,
-                  const time_t start_time);
+                  const time_t start_time,
+                  bool compressed = false,
+                  bool chunked = false);
 
     void write(const std::vector<float>& ts_data,
                int report_step,
@@ -51,12 +84,18 @@ private:
     int m_nTimeSteps;
     int m_nVect;
     bool m_fmt;
+    bool m_compressed;
+    bool m_chunked;
 
     std::vector<int> m_start_date_vect;
     std::string m_restart_rootn;
     int m_restart_step;
     std::vector<std::string> m_smry_keys;
     std::vector<std::string> m_smryUnits;
+    std::uintmax_t m_committed_size;
+
+    // time steps which have not yet been written to file; with the classic
+    // layout all time steps
     std::vector<int> m_rstep;
     std::vector<int> m_tstep;
     std::vector<std::vector<float>> m_smrydata;
@@ -65,7 +104,9 @@ private:
                                              int globInd) const;
     std::vector<std::string> make_modified_keys(const std::vector<std::string>& valueKeys,
                                                 const GridDims& dims);
-    bool rename_tmpfile(const std::string& tmp_fname);
+    bool write_classic();
+    bool write_chunk(std::size_t num_tstep);
+    std::uintmax_t chunk_size_on_disk() const;
 };
 
 
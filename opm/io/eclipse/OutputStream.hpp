@@ -226,6 +226,10 @@ namespace Opm { namespace EclIO { namespace OutputStream {
         /// Restart output stream.
         std::unique_ptr<EclOutput> stream_;
 
+        /// Absolute filename of unified output stream.  Empty for
+        /// separate output files.
+        std::string unifiedFileName_{};
+
         /// Open unified output file and place stream's output indicator
         /// in appropriate location.
         ///
@@ -242,6 +246,10 @@ namespace Opm { namespace EclIO { namespace OutputStream {
                          const bool         formatted,
                          const int          seqnum);
 
+        /// Close unified output stream and record the file's size in
+        /// the process' index of SEQNUM positions.
+        void closeUnified();
+
         /// Open new output stream.
         ///
         /// Handles the case of separate output files or unified output file
@@ -0,0 +1,75 @@
+/*
+   Copyright 2026 Equinor ASA.
+
+   This file is part of the Open Porous Media project (OPM).
+
+   OPM is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   OPM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+   */
+
+
+#ifndef OPM_IO_SMRYCOMPRESSION_HPP
+#define OPM_IO_SMRYCOMPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Opm { namespace EclIO {
+
+class EclOutput;
+
+/*
+  Compression of summary vectors in ESMRY files. A compressed chunk of an
+  ESMRY file has the layout
+
+      CHUNK   INTE  [number of time steps, number of vectors, codec]
+      RSTEP   INTE  report step flags for the time steps in the chunk
+      TSTEP   INTE  time step indices for the time steps in the chunk
+      VINDEX  INTE  start of each vector in VDATA, number of vectors + 1 values
+      VDATA   INTE  the compressed vectors
+
+  such that a single vector can be decoded without reading the others.
+
+  The vectors are compressed with XOR encoding of consecutive values; the
+  bits of a value which are equal to the previous value are not stored. A
+  constant vector is stored with one bit for each time step, and slowly
+  varying vectors, like cumulatives, only store the changing low order bits
+  of the mantissa. The encoding is lossless.
+*/
+
+enum class SmryCodec : int {
+    None = 0,
+    XorFloat = 1
+};
+
+// maximum number of time steps in one compressed chunk
+constexpr std::size_t compressedSmryChunkSize = 256;
+
+std::vector<int> compressSmryVector(const float* data, std::size_t size);
+
+// appends the decoded values to result
+void decompressSmryVector(const int* words, std::size_t num_words, std::size_t size,
+                          std::vector<float>& result);
+
+// Writes the first num_tstep time steps as compressed chunks with at most
+// compressedSmryChunkSize time steps each. Returns the size of the chunks
+// in a binary file.
+std::uintmax_t writeCompressedSmryChunks(EclOutput& outFile,
+                                         const std::vector<int>& rstep,
+                                         const std::vector<int>& tstep,
+                                         const std::vector<std::vector<float>>& data,
+                                         std::size_t num_tstep);
+
+}} // namespace Opm::EclIO
+
+#endif // OPM_IO_SMRYCOMPRESSION_HPP
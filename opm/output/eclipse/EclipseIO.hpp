@@ -22,6 +22,7 @@
 #ifndef OPM_ECLIPSE_WRITER_HPP
 #define OPM_ECLIPSE_WRITER_HPP
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
@@ -232,6 +233,30 @@ public:
     RestartValue loadRestart(Action::State& action_state, SummaryState& summary_state, const std::vector<RestartKey>& solution_keys, const std::vector<RestartKey>& extra_keys = {}) const;
     const out::Summary& summary();
 
+    /*
+      Opt-in asynchronous output. With a positive max_pending_steps the
+      summary, restart and RFT files are written by a dedicated I/O thread;
+      writeTimeStep() takes a copy of the state objects, moves the
+      RestartValue into a queue and returns. When max_pending_steps time
+      steps are already waiting to be written writeTimeStep() blocks until
+      the I/O thread has caught up. Passing zero - the default - restores
+      synchronous output after the pending steps have been written.
+
+      The output is written from the EclipseState, Schedule and grid held
+      by reference, so flushOutput() must be called before the simulator
+      modifies any of these, e.g. when applying ACTIONX results.
+    */
+    void setAsyncOutput(std::size_t max_pending_steps);
+
+    /*
+      Blocks until all queued time steps have been written. An exception
+      thrown by the I/O thread is rethrown here, or from the next call to
+      writeTimeStep(). The output is flushed automatically after the final
+      report step, before loadRestart() and summary(), and when the
+      EclipseIO object is destroyed.
+    */
+    void flushOutput();
+
     EclipseIO( const EclipseIO& ) = delete;
     ~EclipseIO();
 
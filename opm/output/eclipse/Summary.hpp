@@ -85,6 +85,10 @@ public:
 
     void write(const bool is_final_summary = false) const;
 
+    // Evaluate the summary vectors on numThreads threads.  The default is
+    // sequential evaluation.
+    void setNumThreads(std::size_t numThreads);
+
     PAvgCalculatorCollection wbp_calculators(std::size_t report_step) const;
 
 private:
@@ -17,31 +17,198 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <regex>
-
 #include <opm/common/utility/shmatch.hpp>
 
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+/*
+  Parses the character set starting with the '[' at position pos. Returns the
+  position after the closing ']', or pos if the set is not terminated, in
+  which case the '[' is an ordinary character.
+*/
+std::size_t parse_charset(const std::string& pattern, std::size_t pos, std::bitset<256>& chars)
+{
+    auto index = pos + 1;
+    bool negate = false;
+    if (index < pattern.size() && (pattern[index] == '!' || pattern[index] == '^')) {
+        negate = true;
+        index += 1;
+    }
 
-bool Opm::shmatch(const std::string& pattern, const std::string& symbol) {
-    // Shell patterns should implicitly be interpreted as anchored at beginning
-    // and end.
-    std::string re_pattern = "^" + pattern + "$";
+    const auto first = index;
+    while (index < pattern.size()) {
+        const auto c = static_cast<unsigned char>(pattern[index]);
+        if (c == ']' && index > first) {
+            if (negate)
+                chars.flip();
+            return index + 1;
+        }
 
-    {
-        // Shell wildcard '*' should be regular expression arbitrary character '.'
-        // repeated arbitrary number of times '*'
-        std::regex re("\\*");
-        re_pattern = std::regex_replace(re_pattern, re, ".*");
+        if (index + 2 < pattern.size() && pattern[index + 1] == '-' && pattern[index + 2] != ']') {
+            const auto last = static_cast<unsigned char>(pattern[index + 2]);
+            for (unsigned int r = c; r <= last; r++)
+                chars.set(r);
+            index += 3;
+        } else {
+            chars.set(c);
+            index += 1;
+        }
     }
 
-    {
-        // Shell wildcard '?' should be regular expression one arbitrary character
-        // '.'
-        std::regex re("\\?");
-        re_pattern = std::regex_replace(re_pattern, re, ".");
+    chars.reset();
+    return pos;
+}
+
+constexpr std::size_t max_cached_patterns = 128;
+
+}
+
+
+namespace Opm {
+
+ShellPattern::ShellPattern(const std::string& pattern)
+    : m_pattern(pattern)
+{
+    auto add_literal = [this](char c) {
+        if (this->m_elements.empty() || this->m_elements.back().kind != Kind::Literal)
+            this->m_elements.push_back( Element{Kind::Literal} );
+        this->m_elements.back().literal.push_back(c);
+    };
+
+    std::size_t pos = 0;
+    while (pos < pattern.size()) {
+        const auto c = pattern[pos];
+        if (c == '*') {
+            // Consecutive '*' are equivalent to one.
+            if (this->m_elements.empty() || this->m_elements.back().kind != Kind::AnyString)
+                this->m_elements.push_back( Element{Kind::AnyString} );
+            pos += 1;
+        } else if (c == '?') {
+            this->m_elements.push_back( Element{Kind::AnyChar} );
+            pos += 1;
+        } else if (c == '[') {
+            Element element{Kind::CharSet};
+            const auto end = parse_charset(pattern, pos, element.chars);
+            if (end == pos) {
+                add_literal(c);
+                pos += 1;
+            } else {
+                this->m_elements.push_back( std::move(element) );
+                pos = end;
+            }
+        } else if (c == '\\' && pos + 1 < pattern.size()) {
+            add_literal(pattern[pos + 1]);
+            pos += 2;
+        } else {
+            add_literal(c);
+            pos += 1;
+        }
     }
 
-    std::regex regexp(re_pattern);
-    return std::regex_search(symbol, regexp);
+    if (!this->m_elements.empty() && this->m_elements.front().kind == Kind::Literal)
+        this->m_prefix = this->m_elements.front().literal;
+
+    this->m_literal = this->m_elements.empty() ||
+        (this->m_elements.size() == 1 && this->m_elements.front().kind == Kind::Literal);
+}
+
+
+bool ShellPattern::match_element(const Element& element, std::string_view symbol, std::size_t pos) const
+{
+    switch (element.kind) {
+    case Kind::Literal:
+        return symbol.compare(pos, element.literal.size(), element.literal) == 0;
+    case Kind::AnyChar:
+        return pos < symbol.size();
+    case Kind::CharSet:
+        return pos < symbol.size() && element.chars.test(static_cast<unsigned char>(symbol[pos]));
+    default:
+        return false;
+    }
 }
 
+
+/*
+  Greedy matching with backtracking to the last '*' only; since all other
+  elements have a fixed width this finds a match if there is one.
+*/
+bool ShellPattern::match(std::string_view symbol) const
+{
+    if (this->m_literal)
+        return symbol == this->m_prefix;
+
+    const auto npos = std::string_view::npos;
+    const auto num_elements = this->m_elements.size();
+    std::size_t element = 0;
+    std::size_t pos = 0;
+    std::size_t star_element = npos;
+    std::size_t star_pos = 0;
+
+    while (true) {
+        if (element < num_elements) {
+            const auto& current = this->m_elements[element];
+            if (current.kind == Kind::AnyString) {
+                element += 1;
+                star_element = element;
+                star_pos = pos;
+                continue;
+            }
+
+            if (this->match_element(current, symbol, pos)) {
+                pos += (current.kind == Kind::Literal) ? current.literal.size() : 1;
+                element += 1;
+                continue;
+            }
+        } else if (pos == symbol.size() || star_element == num_elements)
+            return true;
+
+        if (star_element == npos || star_pos >= symbol.size())
+            return false;
+
+        star_pos += 1;
+        pos = star_pos;
+        element = star_element;
+    }
+}
+
+
+const std::string& ShellPattern::pattern() const
+{
+    return this->m_pattern;
+}
+
+
+const std::string& ShellPattern::literalPrefix() const
+{
+    return this->m_prefix;
+}
+
+
+bool ShellPattern::isLiteral() const
+{
+    return this->m_literal;
+}
+
+
+bool shmatch(const std::string& pattern, const std::string& symbol)
+{
+    thread_local std::unordered_map<std::string, ShellPattern> patterns;
+
+    auto iter = patterns.find(pattern);
+    if (iter == patterns.end()) {
+        if (patterns.size() >= max_cached_patterns)
+            patterns.clear();
+
+        iter = patterns.emplace(pattern, ShellPattern(pattern)).first;
+    }
+
+    return iter->second.match(symbol);
+}
+
+}
@@ -29,9 +29,12 @@ namespace Opm {
 
     std::vector< const DeckKeyword* > Deck::getKeywordList( const std::string& keyword ) const {
         std::vector<const DeckKeyword *> pointers;
-        auto view = this->global_view().operator[](keyword);
-        for (const auto& kw : view)
-            pointers.push_back(&kw);
+        auto iter = this->keyword_index.find(keyword);
+        if (iter != this->keyword_index.end()) {
+            pointers.reserve(iter->second.size());
+            for (const auto& kw_index : iter->second)
+                pointers.push_back(&this->keywordList[kw_index]);
+        }
         return pointers;
     }
 
@@ -45,21 +48,36 @@ namespace Opm {
 
 
 std::size_t Deck::count(const std::string& keyword) const {
-    return this->global_view().count(keyword);
+    auto iter = this->keyword_index.find(keyword);
+    if (iter == this->keyword_index.end())
+        return 0;
+
+    return iter->second.size();
 }
 
-const DeckView& Deck::global_view() const {
-    if (!this->m_global_view) {
-        this->m_global_view = std::make_unique<DeckView>();
-        for (const auto& kw : this->keywordList)
-            this->m_global_view->add_keyword(kw);
-    }
-    return *this->m_global_view;
+const std::vector<std::size_t> Deck::index(const std::string& keyword) const {
+    auto iter = this->keyword_index.find(keyword);
+    if (iter != this->keyword_index.end())
+        return iter->second;
+
+    return {};
+}
+
+void Deck::rebuild_index() {
+    this->keyword_index.clear();
+    for (std::size_t kw_index = 0; kw_index < this->keywordList.size(); kw_index++)
+        this->keyword_index[this->keywordList[kw_index].name()].push_back(kw_index);
 }
 
     Opm::DeckView Deck::operator[](const std::string& keyword) const {
-        return this->global_view()[keyword];
-    } 
+        DeckView view;
+        auto iter = this->keyword_index.find(keyword);
+        if (iter != this->keyword_index.end()) {
+            for (const auto& kw_index : iter->second)
+                view.add_keyword(this->keywordList[kw_index]);
+        }
+        return view;
+    }
 
     const DeckKeyword& Deck::operator[](std::size_t index) const {
         return this->keywordList.at(index);
@@ -74,6 +92,7 @@ const DeckView& Deck::global_view() const {
         , input_path( d.input_path )
         , file_tree( d.file_tree )
         , unit_system_access_count(d.unit_system_access_count)
+        , keyword_index( d.keyword_index )
     {
     }
 
@@ -85,6 +104,7 @@ const DeckView& Deck::global_view() const {
         , input_path( d.input_path )
         , file_tree( std::move(d.file_tree) )
         , unit_system_access_count(d.unit_system_access_count)
+        , keyword_index( std::move(d.keyword_index) )
     {
     }
 
@@ -97,6 +117,7 @@ const DeckView& Deck::global_view() const {
         result.m_dataFile = "test1";
         result.input_path = "test2";
         result.unit_system_access_count = 1;
+        result.rebuild_index();
 
         return result;
     }
@@ -111,8 +132,8 @@ const DeckView& Deck::global_view() const {
         else if (keyword.name() == "PVT-M")
             this->selectActiveUnitSystem( UnitSystem::UnitType::UNIT_TYPE_PVT_M );
 
+        this->keyword_index[keyword.name()].push_back(this->keywordList.size());
         this->keywordList.push_back( std::move( keyword ) );
-        this->m_global_view = nullptr;
     }
 
     void Deck::addKeyword( const DeckKeyword& keyword ) {
@@ -224,6 +245,7 @@ const DeckView& Deck::global_view() const {
         input_path = data.input_path;
         unit_system_access_count = data.unit_system_access_count;
         activeUnits = data.activeUnits;
+        keyword_index = data.keyword_index;
 
         return *this;
     }
@@ -257,7 +279,7 @@ const DeckView& Deck::global_view() const {
     }
 
     bool Deck::hasKeyword(const std::string& keyword) const {
-        return this->global_view().has_keyword(keyword);
+        return this->keyword_index.find(keyword) != this->keyword_index.end();
     }
 
 }
@@ -37,91 +37,85 @@ std::vector< T >& DeckItem::value_ref() {
          );
 }
 
-template<>
-const std::vector< int >& DeckItem::value_ref< int >() const {
-    if( this->type != get_type< int >() )
-        throw std::invalid_argument( "DeckItem::value_ref<int> Item of wrong type. this->type: " + tag_name(this->type) + " " + this->name());
+template< typename T >
+const std::vector< T >& DeckItem::value_ref() const {
+    if( this->type != get_type< T >() )
+        throw std::invalid_argument( "DeckItem::value_ref<" + tag_name(get_type< T >()) + "> Item of wrong type. this->type: " + tag_name(this->type) + " " + this->name());
 
-    return this->ival;
+    return std::get< std::vector< T > >( this->values );
 }
 
-template<>
-const std::vector< double >& DeckItem::value_ref< double >() const {
-    if (this->type == get_type<double>())
-        return this->dval;
 
-    throw std::invalid_argument( "DeckItem::value_ref<double> Item of wrong type. this->type: " + tag_name(this->type) + " " + this->name());
+DeckItem::DeckItem( const std::string& nm, int value) :
+    DeckItem( std::make_shared<const std::string>(nm), value )
+{
 }
 
-template<>
-const std::vector< std::string >& DeckItem::value_ref< std::string >() const {
-    if( this->type != get_type< std::string >() )
-        throw std::invalid_argument( "DeckItem::value_ref<std::string> Item of wrong type. this->type: " + tag_name(this->type) + " " + this->name());
-
-    return this->sval;
+DeckItem::DeckItem( const std::string& nm, std::string value) :
+    DeckItem( std::make_shared<const std::string>(nm), std::move(value) )
+{
 }
 
-template<>
-const std::vector< RawString >& DeckItem::value_ref< RawString >() const {
-    if( this->type != get_type< RawString >() )
-        throw std::invalid_argument( "DeckItem::value_ref<RawString> Item of wrong type. this->type: " + tag_name(this->type) + " " + this->name());
-
-    return this->rsval;
+DeckItem::DeckItem( const std::string& nm, RawString value) :
+    DeckItem( std::make_shared<const std::string>(nm), std::move(value) )
+{
 }
 
-template<>
-const std::vector< UDAValue >& DeckItem::value_ref< UDAValue >() const {
-    if( this->type != get_type< UDAValue >() )
-        throw std::invalid_argument( "DeckItem::value_ref<UDAValue> Item of wrong type. this->type: " + tag_name(this->type) + " " + this->name());
-
-    return this->uval;
+DeckItem::DeckItem( const std::string& nm, double value, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim) :
+    DeckItem( std::make_shared<const std::string>(nm), value, active_dim, default_dim )
+{
 }
 
-
-DeckItem::DeckItem( const std::string& nm, int) :
-    type( get_type< int >() ),
-    item_name( nm )
+DeckItem::DeckItem( const std::string& nm, UDAValue value, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim) :
+    DeckItem( std::make_shared<const std::string>(nm), std::move(value), active_dim, default_dim )
 {
 }
 
-DeckItem::DeckItem( const std::string& nm, std::string) :
-    type( get_type< std::string >() ),
-    item_name( nm )
+DeckItem::DeckItem( std::shared_ptr<const std::string> nm, int) :
+    values( std::vector< int >() ),
+    item_name( std::move(nm) ),
+    type( get_type< int >() )
 {
 }
 
-DeckItem::DeckItem( const std::string& nm, RawString) :
-    type( get_type< RawString >() ),
-    item_name( nm )
+DeckItem::DeckItem( std::shared_ptr<const std::string> nm, std::string) :
+    values( std::vector< std::string >() ),
+    item_name( std::move(nm) ),
+    type( get_type< std::string >() )
 {
 }
 
+DeckItem::DeckItem( std::shared_ptr<const std::string> nm, RawString) :
+    values( std::vector< RawString >() ),
+    item_name( std::move(nm) ),
+    type( get_type< RawString >() )
+{
+}
 
-DeckItem::DeckItem( const std::string& nm, double, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim) :
-    type( get_type< double >() ),
-    item_name( nm ),
+DeckItem::DeckItem( std::shared_ptr<const std::string> nm, double, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim) :
+    values( std::vector< double >() ),
+    item_name( std::move(nm) ),
     active_dimensions(active_dim),
-    default_dimensions(default_dim)
+    default_dimensions(default_dim),
+    type( get_type< double >() )
 {
 }
 
-DeckItem::DeckItem( const std::string& nm, UDAValue, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim) :
-    type( get_type< UDAValue >() ),
-    item_name( nm ),
+DeckItem::DeckItem( std::shared_ptr<const std::string> nm, UDAValue, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim) :
+    values( std::vector< UDAValue >() ),
+    item_name( std::move(nm) ),
     active_dimensions(active_dim),
-    default_dimensions(default_dim)
+    default_dimensions(default_dim),
+    type( get_type< UDAValue >() )
 {
 }
 
 DeckItem DeckItem::serializationTestObject()
 {
     DeckItem result;
-    result.dval = {1.0};
-    result.ival = {2};
-    result.sval = {"test1"};
-    result.uval = {UDAValue(3.0)};
+    result.values = std::vector< std::string >{"test1"};
     result.type = type_tag::string;
-    result.item_name = "test2";
+    result.item_name = std::make_shared<const std::string>("test2");
     result.value_status = {value::status::deck_value};
     result.raw_data = false;
     result.active_dimensions = {Dimension::serializationTestObject()};
@@ -131,7 +125,8 @@ DeckItem DeckItem::serializationTestObject()
 }
 
 const std::string& DeckItem::name() const {
-    return this->item_name;
+    static const std::string empty_name;
+    return this->item_name ? *this->item_name : empty_name;
 }
 
 bool DeckItem::defaultApplied( size_t index ) const {
@@ -188,14 +183,9 @@ UDAValue DeckItem::get( size_t index ) const {
     }
 }
 
-template <>
-void DeckItem::shrink_to_fit<int>() {
-    this->ival.shrink_to_fit();
-}
-
-template <>
-void DeckItem::shrink_to_fit<double>() {
-    this->dval.shrink_to_fit();
+template <typename T>
+void DeckItem::shrink_to_fit() {
+    this->value_ref< T >().shrink_to_fit();
 }
 
 
@@ -362,6 +352,10 @@ type_tag DeckItem::getType() const {
     return this->type;
 }
 
+UDAValue& DeckItem::get_uda() {
+    return this->value_ref< UDAValue >()[0];
+}
+
 
 
 template< typename T >
@@ -378,7 +372,7 @@ void DeckItem::write_vector(DeckOutput& stream, const std::vector<T>& data) cons
 void DeckItem::write(DeckOutput& stream) const {
     switch( this->type ) {
     case type_tag::integer:
-        this->write_vector( stream, this->ival );
+        this->write_vector( stream, this->value_ref< int >() );
         break;
     case type_tag::fdouble:
         {
@@ -387,13 +381,13 @@ void DeckItem::write(DeckOutput& stream) const {
             break;
         }
     case type_tag::string:
-        this->write_vector( stream,  this->sval );
+        this->write_vector( stream,  this->value_ref< std::string >() );
         break;
     case type_tag::raw_string:
-        this->write_vector( stream,  this->rsval );
+        this->write_vector( stream,  this->value_ref< RawString >() );
         break;
     case type_tag::uda:
-        this->write_vector( stream,  this->uval );
+        this->write_vector( stream,  this->value_ref< UDAValue >() );
         break;
     default:
         throw std::logic_error( "DeckItem::write: Type not set." );
@@ -433,7 +427,7 @@ bool DeckItem::equal(const DeckItem& other, bool cmp_default, bool cmp_numeric)
     if (this->data_size() != other.data_size())
         return false;
 
-    if (this->item_name != other.item_name)
+    if (this->name() != other.name())
         return false;
 
     if (cmp_default)
@@ -442,11 +436,11 @@ bool DeckItem::equal(const DeckItem& other, bool cmp_default, bool cmp_numeric)
 
     switch( this->type ) {
     case type_tag::integer:
-        if (this->ival != other.ival)
+        if (this->value_ref< int >() != other.value_ref< int >())
             return false;
         break;
     case type_tag::string:
-        if (this->sval != other.sval)
+        if (this->value_ref< std::string >() != other.value_ref< std::string >())
             return false;
         break;
     case type_tag::fdouble:
@@ -459,7 +453,7 @@ bool DeckItem::equal(const DeckItem& other, bool cmp_default, bool cmp_numeric)
             }
         } else {
             if (this->raw_data == other.raw_data)
-                return (this->dval == other.dval);
+                return (this->value_ref< double >() == other.value_ref< double >());
             else {
                 const auto& this_data = this->getData<double>();
                 const auto& other_data = other.getData<double>();
@@ -523,7 +517,8 @@ bool DeckItem::to_bool(std::string string_value) {
 
 void DeckItem::reserve_additionalRawString(std::size_t n)
 {
-    this->rsval.reserve(rsval.size() + n);
+    auto& rsval = this->value_ref< RawString >();
+    rsval.reserve(rsval.size() + n);
 }
 
 /*
@@ -531,6 +526,9 @@ void DeckItem::reserve_additionalRawString(std::size_t n)
  * updated with changes in DeckItem so that code is emitted.
  */
 
+template void DeckItem::shrink_to_fit<int>();
+template void DeckItem::shrink_to_fit<double>();
+
 template int DeckItem::get< int >( size_t ) const;
 template double DeckItem::get< double >( size_t ) const;
 template std::string DeckItem::get< std::string >( size_t ) const;
@@ -101,6 +101,8 @@ namespace Opm {
         result.m_nosim = true;
         result.m_base_name = "test3";
         result.ecl_compatible_rst = false;
+        result.chunked_esmry = true;
+        result.compressed_esmry = true;
 
         return result;
     }
@@ -179,6 +181,26 @@ namespace Opm {
     }
 
 
+    bool IOConfig::getChunkedESMRY() const {
+        return this->chunked_esmry;
+    }
+
+
+    void IOConfig::setChunkedESMRY(bool chunked) {
+        this->chunked_esmry = chunked;
+    }
+
+
+    bool IOConfig::getCompressedESMRY() const {
+        return this->compressed_esmry;
+    }
+
+
+    void IOConfig::setCompressedESMRY(bool compressed) {
+        this->compressed_esmry = compressed;
+    }
+
+
     void IOConfig::overrideNOSIM(bool nosim) {
         m_nosim = nosim;
     }
@@ -298,7 +320,9 @@ namespace Opm {
                this->getOutputDir() == data.getOutputDir() &&
                this->initOnly() == data.initOnly() &&
                this->getBaseName() == data.getBaseName() &&
-               this->getEclCompatibleRST() == data.getEclCompatibleRST();
+               this->getEclCompatibleRST() == data.getEclCompatibleRST() &&
+               this->getChunkedESMRY() == data.getChunkedESMRY() &&
+               this->getCompressedESMRY() == data.getCompressedESMRY();
     }
 
 
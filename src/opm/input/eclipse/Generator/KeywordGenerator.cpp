@@ -23,6 +23,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <cctype>
+#include <cstdint>
 #include <fmt/format.h>
 
 #include <opm/json/JsonObject.hpp>
@@ -41,6 +42,39 @@ const std::string sourceHeader = R"(
 
 
 )";
+
+/*
+  Keywords which are only recognized by their own name are registered lazily
+  in the Parser, i.e. they are constructed the first time they are used.
+  Keywords with alternative deck names, a deck name regex or a code section
+  must be known by the Parser up front.
+*/
+bool lazy_registration(const Opm::ParserKeyword& kw)
+{
+    return !kw.hasMatchRegex()
+        && !kw.isCodeKeyword()
+        && (kw.deck_names().size() == 1)
+        && (kw.deck_names().count(kw.getName()) == 1);
+}
+
+/*
+  FNV-1a hash of the generated code of all the builtin keywords; the Parser
+  uses it to invalidate deck cache entries when a keyword definition has
+  changed.
+*/
+std::uint64_t builtin_keywords_hash(const Opm::KeywordLoader& loader)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const auto& [first_char, keywords] : loader) {
+        for (const auto& kw : keywords) {
+            for (const auto c : kw.createCode()) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 0x100000001b3ULL;
+            }
+        }
+    }
+    return hash;
+}
 }
 
 namespace Opm {
@@ -225,8 +259,12 @@ void addDefaultKeywords{0}([[maybe_unused]] Parser& p){{
 )",
                                      first_char);
                 const auto& keywords = kw_pair.second;
-                for (const auto& kw : keywords)
-                    sourceStr << fmt::format("    p.addParserKeyword( {}() );", kw.className()) << std::endl;
+                for (const auto& kw : keywords) {
+                    if (lazy_registration(kw))
+                        sourceStr << fmt::format("    p.addLazyParserKeyword( \"{}\", []() -> ParserKeyword {{ return {}(); }} );", kw.getName(), kw.className()) << std::endl;
+                    else
+                        sourceStr << fmt::format("    p.addParserKeyword( {}() );", kw.className()) << std::endl;
+                }
             sourceStr << R"(
 
 }
@@ -251,14 +289,18 @@ void addDefaultKeywords(Parser& p) {
                 newSource << fmt::format("    addDefaultKeywords{}(p);", first_char) << std::endl;
         }
 
-        newSource << R"(
-}
-}
-void Parser::addDefaultKeywords() {
+        newSource << fmt::format(R"(
+}}
+}}
+void Parser::addDefaultKeywords() {{
     ParserKeywords::addDefaultKeywords(*this);
-}
-}
-)";
+}}
+
+std::uint64_t Parser::builtinKeywordsHash() {{
+    return 0x{:016x}ULL;
+}}
+}}
+)", builtin_keywords_hash(loader));
 
         write_file(newSource, sourceFile, m_verbose, "init");
     }
@@ -0,0 +1,391 @@
+/*
+  Copyright 2026 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/input/eclipse/Parser/DeckCache.hpp>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/utility/MemPacker.hpp>
+#include <opm/common/utility/Serializer.hpp>
+
+#include <opm/input/eclipse/Deck/Deck.hpp>
+
+#include <array>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace {
+
+/*
+  The format version must be incremented whenever the serialized layout of
+  the Deck, or of any of the classes it contains, is changed.
+*/
+constexpr std::uint64_t deck_cache_version = 3;
+constexpr std::array<char, 8> deck_cache_magic = { 'O', 'P', 'M', 'D', 'E', 'C', 'K', '\0' };
+
+constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+std::uint64_t rotl(std::uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+std::uint64_t hash_round(std::uint64_t acc, std::uint64_t input) {
+    acc += input * prime2;
+    acc = rotl(acc, 31);
+    return acc * prime1;
+}
+
+std::uint64_t read_word(const char* data) {
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof word);
+    return word;
+}
+
+/*
+  Streaming 64 bit hash in the style of XXH64; four independent lanes keep
+  the throughput well above the speed the input files can be read with. The
+  hash is only used to detect modified input files, and the values are not
+  portable between platforms with different endianness.
+*/
+class Hasher {
+public:
+    explicit Hasher(std::uint64_t seed_arg)
+        : lanes { seed_arg + prime1 + prime2, seed_arg + prime2, seed_arg, seed_arg - prime1 }
+        , seed(seed_arg)
+    {}
+
+    void update(const char* data, std::size_t size);
+    std::uint64_t digest() const;
+
+private:
+    std::array<std::uint64_t, 4> lanes;
+    std::uint64_t seed;
+    std::uint64_t total_size = 0;
+    std::array<char, 32> stripe{};
+    std::size_t stripe_size = 0;
+
+    void consume(const char* data) {
+        for (std::size_t lane = 0; lane < this->lanes.size(); ++lane)
+            this->lanes[lane] = hash_round(this->lanes[lane], read_word(data + 8*lane));
+    }
+};
+
+void Hasher::update(const char* data, std::size_t size) {
+    this->total_size += size;
+
+    if (this->stripe_size > 0) {
+        const auto fill = std::min(size, this->stripe.size() - this->stripe_size);
+        std::memcpy(this->stripe.data() + this->stripe_size, data, fill);
+        this->stripe_size += fill;
+        data += fill;
+        size -= fill;
+
+        if (this->stripe_size < this->stripe.size())
+            return;
+
+        this->consume(this->stripe.data());
+        this->stripe_size = 0;
+    }
+
+    for (; size >= this->stripe.size(); data += this->stripe.size(), size -= this->stripe.size())
+        this->consume(data);
+
+    std::memcpy(this->stripe.data(), data, size);
+    this->stripe_size = size;
+}
+
+std::uint64_t Hasher::digest() const {
+    std::uint64_t h;
+    if (this->total_size >= this->stripe.size()) {
+        h = rotl(this->lanes[0], 1) + rotl(this->lanes[1], 7) + rotl(this->lanes[2], 12) + rotl(this->lanes[3], 18);
+        for (const auto lane : this->lanes) {
+            h ^= hash_round(0, lane);
+            h = h * prime1 + prime4;
+        }
+    } else
+        h = this->seed + prime5;
+
+    h += this->total_size;
+
+    const char* tail = this->stripe.data();
+    std::size_t size = this->stripe_size;
+    for (; size >= 8; tail += 8, size -= 8) {
+        h ^= hash_round(0, read_word(tail));
+        h = rotl(h, 27) * prime1 + prime4;
+    }
+
+    for (; size > 0; ++tail, --size) {
+        h ^= static_cast<unsigned char>(*tail) * prime5;
+        h = rotl(h, 11) * prime1;
+    }
+
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+
+struct CacheHeader {
+    std::uint64_t key = 0;
+    std::string data_file;
+    std::vector<std::pair<std::string, std::uint64_t>> input_files;
+    Opm::DeckCache::Warnings warnings;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(key);
+        serializer(data_file);
+        serializer(input_files);
+        serializer(warnings);
+    }
+};
+
+
+/*
+  Serializer which gives access to the packed buffer, so that it can be
+  written to and read from the cache file directly.
+*/
+class BufferSerializer : public Opm::Serializer<Opm::Serialization::MemPacker> {
+public:
+    BufferSerializer()
+        : Opm::Serializer<Opm::Serialization::MemPacker>(packer)
+    {}
+
+    std::vector<char>& buffer() {
+        return this->m_buffer;
+    }
+
+    template<class T>
+    std::size_t packSize(const T& data) {
+        this->m_op = Operation::PACKSIZE;
+        this->m_packSize = 0;
+        (*this)(data);
+        return this->m_packSize;
+    }
+
+private:
+    static const Opm::Serialization::MemPacker packer;
+};
+
+const Opm::Serialization::MemPacker BufferSerializer::packer{};
+
+
+template<class T>
+void read_value(std::istream& stream, T& value) {
+    stream.read(reinterpret_cast<char*>(&value), sizeof value);
+}
+
+template<class T>
+void write_value(std::ostream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof value);
+}
+
+}
+
+namespace Opm {
+
+DeckCache::DeckCache(const std::filesystem::path& directory_arg)
+    : directory(directory_arg)
+{}
+
+
+std::uint64_t DeckCache::hash(std::string_view data, std::uint64_t seed) {
+    Hasher hasher(seed);
+    hasher.update(data.data(), data.size());
+    return hasher.digest();
+}
+
+
+std::uint64_t DeckCache::contentHash(const std::filesystem::path& file) {
+    const auto closer = []( std::FILE* f ) { std::fclose( f ); };
+    std::unique_ptr< std::FILE, decltype( closer ) > ufp(
+            std::fopen( file.c_str(), "rb" ),
+            closer
+            );
+
+    if (!ufp)
+        throw std::runtime_error("Could not read from file: " + file.string());
+
+    Hasher hasher(0);
+    std::vector<char> buffer(std::size_t{1} << 20);
+    while (true) {
+        const auto readc = std::fread( buffer.data(), 1, buffer.size(), ufp.get() );
+        hasher.update( buffer.data(), readc );
+        if (readc < buffer.size())
+            break;
+    }
+
+    if (std::ferror( ufp.get() ))
+        throw std::runtime_error("Error when reading input file '" + file.string() + "'");
+
+    return hasher.digest();
+}
+
+
+/*
+  The cache file name is based on both the canonical path of the data file
+  and the path as given; the latter is stored in the deck.
+*/
+std::filesystem::path DeckCache::cacheFile(const std::string& data_file) const {
+    const auto canonical = std::filesystem::canonical(data_file);
+    const auto name_hash = hash(canonical.string() + '\n' + data_file);
+    return this->directory / fmt::format("{}-{:016x}.OPMDECK", canonical.stem().string(), name_hash);
+}
+
+
+std::optional<DeckCache::Entry> DeckCache::load(const std::string& data_file, std::uint64_t key) const {
+    try {
+        const auto cache_file = this->cacheFile(data_file);
+        std::ifstream stream(cache_file, std::ios::binary);
+        if (!stream)
+            return {};
+
+        std::array<char, deck_cache_magic.size()> magic{};
+        std::uint64_t version = 0;
+        std::uint64_t header_size = 0;
+        std::uint64_t deck_size = 0;
+        stream.read(magic.data(), magic.size());
+        read_value(stream, version);
+        read_value(stream, header_size);
+        read_value(stream, deck_size);
+        if (!stream || (magic != deck_cache_magic) || (version != deck_cache_version))
+            return {};
+
+        const auto file_size = std::filesystem::file_size(cache_file);
+        if (header_size + deck_size > file_size)
+            return {};
+
+        BufferSerializer serializer;
+        CacheHeader header;
+        serializer.buffer().resize(header_size);
+        stream.read(serializer.buffer().data(), header_size);
+        if (!stream)
+            return {};
+
+        serializer.unpack(header);
+        if ((header.key != key) || (header.data_file != data_file))
+            return {};
+
+        for (const auto& [input_file, content_hash] : header.input_files) {
+            if (!std::filesystem::is_regular_file(input_file))
+                return {};
+
+            if (contentHash(input_file) != content_hash)
+                return {};
+        }
+
+        serializer.buffer().resize(deck_size);
+        stream.read(serializer.buffer().data(), deck_size);
+        if (!stream)
+            return {};
+
+        Entry entry;
+        serializer.unpack(entry.deck);
+        entry.warnings = std::move(header.warnings);
+        OpmLog::info(fmt::format("Loaded deck {} from cache file {}", data_file, cache_file.string()));
+        return entry;
+    } catch (const std::exception& e) {
+        OpmLog::warning(fmt::format("Could not load deck {} from cache: {}", data_file, e.what()));
+        return {};
+    }
+}
+
+
+bool DeckCache::store(const Deck& deck,
+                      const std::string& data_file,
+                      const InputFiles& input_files,
+                      const Warnings& warnings,
+                      std::uint64_t key) const
+{
+    try {
+        CacheHeader header;
+        header.key = key;
+        header.data_file = data_file;
+        header.warnings = warnings;
+        for (const auto& [input_file, content_hash] : input_files)
+            header.input_files.emplace_back(std::filesystem::absolute(input_file).string(), content_hash);
+
+        // The MemPacker uses int positions.
+        BufferSerializer header_serializer;
+        BufferSerializer deck_serializer;
+        const auto deck_size = deck_serializer.packSize(deck);
+        if (deck_size > static_cast<std::size_t>(INT_MAX)) {
+            OpmLog::info(fmt::format("Deck {} is too large for the deck cache", data_file));
+            return false;
+        }
+
+        header_serializer.pack(header);
+        deck_serializer.pack(deck);
+
+        /*
+          The entry is written to a temporary file which is renamed into
+          place, so that concurrent runs never see a partially written file.
+        */
+        std::filesystem::create_directories(this->directory);
+        const auto cache_file = this->cacheFile(data_file);
+        const auto tmp_file = std::filesystem::path(fmt::format("{}.{:08x}.tmp", cache_file.string(), std::random_device{}()));
+        {
+            std::ofstream stream(tmp_file, std::ios::binary);
+            stream.write(deck_cache_magic.data(), deck_cache_magic.size());
+            write_value(stream, deck_cache_version);
+            write_value(stream, static_cast<std::uint64_t>(header_serializer.buffer().size()));
+            write_value(stream, static_cast<std::uint64_t>(deck_serializer.buffer().size()));
+            stream.write(header_serializer.buffer().data(), header_serializer.buffer().size());
+            stream.write(deck_serializer.buffer().data(), deck_serializer.buffer().size());
+            if (!stream) {
+                stream.close();
+                std::error_code ec;
+                std::filesystem::remove(tmp_file, ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmp_file, cache_file, ec);
+        if (ec) {
+            std::error_code remove_ec;
+            std::filesystem::remove(tmp_file, remove_ec);
+            OpmLog::warning(fmt::format("Could not write deck {} to cache: {}", data_file, ec.message()));
+            return false;
+        }
+        return true;
+    } catch (const std::exception& e) {
+        OpmLog::warning(fmt::format("Could not write deck {} to cache: {}", data_file, e.what()));
+        return false;
+    }
+}
+
+}
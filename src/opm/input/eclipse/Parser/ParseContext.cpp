@@ -148,6 +148,10 @@ namespace Opm {
         this->ignore_keywords.insert(keyword);
     }
 
+    const std::set<std::string>& ParseContext::ignoredKeywords() const {
+        return this->ignore_keywords;
+    }
+
 
     void ParseContext::handleError(
             const std::string& errorKey,
@@ -23,7 +23,9 @@
 #include <opm/common/OpmLog/LogUtil.hpp>
 #include <opm/common/utility/OpmInputError.hpp>
 
+#include <opm/input/eclipse/Parser/DeckCache.hpp>
 #include <opm/input/eclipse/Parser/ErrorGuard.hpp>
+#include <opm/input/eclipse/Parser/InputErrorAction.hpp>
 #include <opm/input/eclipse/Parser/ParseContext.hpp>
 #include <opm/input/eclipse/Parser/ParserItem.hpp>
 #include <opm/input/eclipse/Parser/ParserKeyword.hpp>
@@ -59,9 +61,15 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <future>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <stack>
 #include <stdexcept>
@@ -71,6 +79,15 @@
 
 #include <fmt/format.h>
 
+#include "project-version.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace {
     // If ROCKOPTS does NOT exist, then the number of records is NTPVT (= TABDIMS(2))
     //
@@ -406,29 +423,320 @@ inline bool isTerminatedRecordString(const std::string_view& line) {
 
 }
 
-struct file {
-    file( std::filesystem::path p, const std::string& in ) :
-        input( in ), path( p )
+/*
+  Read-only view of an input file through a private, copy-on-write memory
+  mapping. The mapping is writable so that the file can be cleaned in place
+  without materializing a cleaned copy; the modifications are never written
+  back to disk.
+*/
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
     {}
 
-    std::string_view input;
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            this->unmap();
+            this->m_data = std::exchange(other.m_data, nullptr);
+            this->m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    ~MappedFile() {
+        this->unmap();
+    }
+
+    /*
+      Will return an empty optional if the file can not be mapped, e.g. if
+      it is empty, not a regular file or mmap() is not available. The caller
+      should then fall back to reading the file with fread().
+    */
+    static std::optional<MappedFile> map(const std::filesystem::path& inputFile);
+
+    char* data() const { return this->m_data; }
+    std::size_t size() const { return this->m_size; }
+
+private:
+    char* m_data = nullptr;
+    std::size_t m_size = 0;
+
+    void unmap();
+};
+
+std::optional<MappedFile> MappedFile::map([[maybe_unused]] const std::filesystem::path& inputFile) {
+#ifdef _WIN32
+    return {};
+#else
+    const int fd = ::open(inputFile.c_str(), O_RDONLY);
+    if (fd < 0)
+        return {};
+
+    struct stat st;
+    if ((::fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_size == 0)) {
+        ::close(fd);
+        return {};
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return {};
+
+    ::madvise(addr, size, MADV_SEQUENTIAL);
+
+    MappedFile mapping;
+    mapping.m_data = static_cast<char*>(addr);
+    mapping.m_size = size;
+    return mapping;
+#endif
+}
+
+void MappedFile::unmap() {
+#ifndef _WIN32
+    if (this->m_data != nullptr)
+        ::munmap(this->m_data, this->m_size);
+#endif
+    this->m_data = nullptr;
+    this->m_size = 0;
+}
+
+
+/*
+  An input file on the InputStack. The content is either:
+
+    1. A cleaned copy of the input, i.e. the output of str::clean(), or
+
+    2. The raw content of a memory mapped file. In this case the lines are
+       cleaned lazily in getline(): the cleaned line is moved down to the end
+       of the already cleaned prefix of the mapping, so that consecutive lines
+       are still separated by exactly one '\n' - which is what the record
+       assembly in tryParseKeyword() relies on. The cleaned line is never
+       longer than the raw line, so the write position never passes the read
+       position.
+*/
+class file {
+public:
+    file( std::filesystem::path p, std::unique_ptr<std::string> in ) :
+        path( p ),
+        storage( std::move(in) ),
+        input( *this->storage )
+    {}
+
+    file( std::filesystem::path p, MappedFile in ) :
+        path( p ),
+        mapping( std::move(in) ),
+        input( this->mapping.data(), this->mapping.size() ),
+        lazy_clean( true ),
+        clean_end( this->mapping.data() )
+    {}
+
+    bool empty() const {
+        if (this->lazy_clean)
+            return this->exhausted && !this->has_pushback;
+
+        return this->input.empty();
+    }
+
+    std::string_view remaining() const {
+        return this->input;
+    }
+
+    std::string_view getline();
+    void ungetline(const std::string_view& line);
+    void skip_to(const char* pos, std::size_t line_number);
+
     size_t lineNR = 0;
     std::filesystem::path path;
+
+private:
+    std::unique_ptr<std::string> storage;
+    MappedFile mapping;
+    std::string_view input;
+
+    bool lazy_clean = false;
+    bool exhausted = false;
+    bool has_pushback = false;
+    char* clean_end = nullptr;
+    std::string_view last_line;
 };
 
+std::string_view file::getline() {
+    std::string_view line;
+    this->lineNR++;
+
+    if (!this->lazy_clean) {
+        str::getline( this->input, line );
+        return line;
+    }
+
+    if (this->has_pushback) {
+        this->has_pushback = false;
+        return this->last_line;
+    }
+
+    /*
+      The eager path appends a '\n' to the file content before splitting it
+      in lines, i.e. the text following the last '\n' in the file is always
+      returned as a (possibly empty) final line.
+    */
+    auto end = std::find( this->input.begin(), this->input.end(), '\n' );
+    const bool newline = (end != this->input.end());
+    const std::size_t raw_size = std::distance( this->input.begin(), end );
+    const auto clean = str::trim( str::strip_comments( this->input.substr(0, raw_size) ) );
+
+    if (newline)
+        this->input.remove_prefix( raw_size + 1 );
+    else {
+        this->input = {};
+        this->exhausted = true;
+    }
+
+    std::memmove( this->clean_end, clean.data(), clean.size() );
+    line = std::string_view( this->clean_end, clean.size() );
+    this->clean_end += clean.size();
+    if (newline)
+        *this->clean_end++ = '\n';
+
+    this->last_line = line;
+    return line;
+}
+
+void file::ungetline(const std::string_view& line) {
+    if (this->lazy_clean) {
+        if (this->has_pushback || (line.data() != this->last_line.data()) || (line.size() != this->last_line.size()))
+            throw std::invalid_argument("line view is not the last line read from the file");
+
+        this->has_pushback = true;
+    } else {
+        if (line.end() + 1 != this->input.begin())
+            throw std::invalid_argument("line view does not immediately proceed file_view");
+
+        this->input = std::string_view(line.begin(), this->input.end() - line.begin());
+    }
+    this->lineNR--;
+}
+
+/*
+  Skips forward to pos, which must be the start of a line in the remaining
+  input; the skipped lines are neither cleaned nor tokenized.
+*/
+void file::skip_to(const char* pos, std::size_t line_number) {
+    if ((pos < this->input.data()) || (pos > this->input.data() + this->input.size()))
+        throw std::invalid_argument("skip position is not in the remaining input");
+
+    this->input = std::string_view( pos, this->input.data() + this->input.size() - pos );
+    this->has_pushback = false;
+    this->lineNR = line_number - 1;
+}
+
 
+/*
+  The lines handed out by the input stack are views into the file storage,
+  and a keyword which is in the process of being assembled might still refer
+  to a file which has been popped off the stack. The storage of popped files
+  is therefore retained until release_closed() is called when no keyword is
+  being assembled.
+*/
 class InputStack : public std::stack< file, std::vector< file > > {
     public:
         void push( std::string&& input, std::filesystem::path p = "<memory string>" );
+        void push( MappedFile&& input, std::filesystem::path p );
+        void pop();
+        void release_closed();
 
     private:
-        std::list< std::string > string_storage;
+        std::vector< file > closed_files;
         using base = std::stack< file, std::vector< file > >;
 };
 
 void InputStack::push( std::string&& input, std::filesystem::path p ) {
-    this->string_storage.push_back( std::move( input ) );
-    this->emplace( p, this->string_storage.back() );
+    this->emplace( p, std::make_unique<std::string>( std::move( input ) ) );
+}
+
+void InputStack::push( MappedFile&& input, std::filesystem::path p ) {
+    this->emplace( p, std::move( input ) );
+}
+
+void InputStack::pop() {
+    this->closed_files.push_back( std::move( this->top() ) );
+    base::pop();
+}
+
+void InputStack::release_closed() {
+    this->closed_files.clear();
+}
+
+/*
+  Position of a section keyword in the root file, as found by
+  ParserState::indexSections(). The EDIT section is counted as part of GRID.
+*/
+struct SectionMarker {
+    Opm::Ecl::SectionType section;
+    const char* pos;
+    std::size_t line_number;
+};
+
+std::optional<Opm::Ecl::SectionType> section_type(std::string_view keyword) {
+    if ((keyword == "GRID") || (keyword == "EDIT"))
+        return Opm::Ecl::GRID;
+
+    if (keyword == "PROPS")
+        return Opm::Ecl::PROPS;
+
+    if (keyword == "REGIONS")
+        return Opm::Ecl::REGIONS;
+
+    if (keyword == "SOLUTION")
+        return Opm::Ecl::SOLUTION;
+
+    if (keyword == "SUMMARY")
+        return Opm::Ecl::SUMMARY;
+
+    if (keyword == "SCHEDULE")
+        return Opm::Ecl::SCHEDULE;
+
+    return std::nullopt;
+}
+
+/*
+  A data keyword which is being converted from a RawKeyword to a DeckKeyword
+  on a worker thread. The RawKeyword refers to the input file storage, which
+  must therefore be kept alive until the conversion has completed. An empty
+  result means that the conversion reported a parse error, and must be
+  repeated on the main thread. The unit systems are those of the deck, which
+  can not change while there are pending keywords.
+*/
+struct PendingKeyword {
+    const ParserKeyword* parser_keyword;
+    UnitSystem* active_unitsystem;
+    UnitSystem* default_unitsystem;
+    std::unique_ptr<RawKeyword> raw_keyword;
+    std::future<std::optional<DeckKeyword>> deck_keyword;
+};
+
+/*
+  Adds the dimensions of the items in parserKeyword to the unit systems of
+  the deck, as ParserItem::scan() does when the keyword is converted on the
+  main thread; the worker threads only update copies of the unit systems.
+*/
+void addDimensions(const ParserKeyword& parserKeyword, UnitSystem& active_unitsystem, UnitSystem& default_unitsystem) {
+    for (const auto& parserItem : parserKeyword.getRecord(0)) {
+        if ((parserItem.dataType() != type_tag::fdouble) && (parserItem.dataType() != type_tag::uda))
+            continue;
+
+        for (const auto& dim_string : parserItem.dimensions()) {
+            active_unitsystem.getNewDimension(dim_string);
+            default_unitsystem.getNewDimension(dim_string);
+        }
+    }
 }
 
 class ParserState {
@@ -437,10 +745,6 @@ class ParserState {
                      const ParseContext&, ErrorGuard&,
                      const std::set<Opm::Ecl::SectionType>& ignore = {});
 
-        ParserState( const std::vector<std::pair<std::string,std::string>>&,
-                     const ParseContext&, ErrorGuard&,
-                     std::filesystem::path, const std::set<Opm::Ecl::SectionType>& ignore = {});
-
         void loadString( const std::string& );
         void loadFile( const std::filesystem::path& );
         void openRootFile( const std::filesystem::path& );
@@ -453,18 +757,27 @@ class ParserState {
         size_t line() const;
 
         bool done() const;
+        void releaseClosedFiles();
         std::string_view getline();
         void ungetline(const std::string_view& ln);
         void closeFile();
 
         const std::set<Opm::Ecl::SectionType>& get_ignore() {return ignore_sections; };
-        bool check_section_keywords();
+        void indexSections();
+        bool ignoreSection(const std::string& keyword) const;
+        bool skipSection();
+
+        bool convertAsync(const ParserKeyword& parserKeyword, std::unique_ptr<RawKeyword>& rawKeyword);
+        void addPendingKeywords(std::size_t max_pending = 0);
+        std::size_t deckSize() const;
 
     private:
         const std::vector<std::pair<std::string, std::string>> code_keywords;
         InputStack input_stack;
+        std::deque<PendingKeyword> pending_keywords;
 
         std::set<Opm::Ecl::SectionType> ignore_sections;
+        std::vector<SectionMarker> section_index;
         std::map< std::string, std::string > pathMap;
 
     public:
@@ -477,6 +790,16 @@ class ParserState {
         const ParseContext& parseContext;
         ErrorGuard& errors;
         bool unknown_keyword = false;
+        std::size_t num_threads = 1;
+
+        // All the files read while parsing, and whether the deck is fully
+        // determined by them - for the deck cache. The content of each file
+        // is hashed when it is read if hash_input_files is set.
+        DeckCache::InputFiles input_files;
+        bool hash_input_files = false;
+        bool cacheable = true;
+
+        void addInputFile(const std::filesystem::path& inputFile, std::string_view content);
 };
 
 const std::filesystem::path& ParserState::current_path() const {
@@ -490,30 +813,112 @@ size_t ParserState::line() const {
 bool ParserState::done() const {
 
     while( !this->input_stack.empty() &&
-            this->input_stack.top().input.empty() )
+            this->input_stack.top().empty() )
         const_cast< ParserState* >( this )->input_stack.pop();
 
     return this->input_stack.empty();
 }
 
-std::string_view ParserState::getline() {
-    std::string_view ln;
+void ParserState::releaseClosedFiles() {
+    if (this->pending_keywords.empty())
+        this->input_stack.release_closed();
+}
+
+/*
+  Data keywords larger than this are converted on a worker thread when
+  parsing with more than one thread; for smaller keywords the cost of the
+  hand-off exceeds the gain.
+*/
+constexpr std::size_t min_async_keyword_size = 64 * 1024;
+
+/*
+  Starts the conversion of rawKeyword on a worker thread, and takes ownership
+  of it, if that is allowed and worthwhile. Only data keywords qualify, as
+  their conversion does not depend on the deck. The ParseContext, ErrorGuard
+  and OpmLog are not thread safe, so the worker reports parse errors to an
+  ErrorGuard of its own, and a keyword with errors is converted again on the
+  main thread - from the untouched RawKeyword - to report them properly. The
+  keywords are added to the deck, in input order, by addPendingKeywords().
+  That must be called before the deck is inspected or another keyword is
+  added to it.
+*/
+bool ParserState::convertAsync(const ParserKeyword& parserKeyword, std::unique_ptr<RawKeyword>& rawKeyword) {
+    if ((this->num_threads < 2) || !parserKeyword.isDataKeyword() || (rawKeyword->size() != 1))
+        return false;
+
+    if (rawKeyword->getFirstRecord().getRecordStringSize() < min_async_keyword_size)
+        return false;
 
-    str::getline( this->input_stack.top().input, ln );
-    this->input_stack.top().lineNR++;
+    // Never let the worker threads fall too far behind the reader.
+    this->addPendingKeywords(this->num_threads - 1);
 
-    return ln;
+    ParseContext worker_context;
+    worker_context.update(InputErrorAction::IGNORE);
+
+    auto& active_unitsystem = this->deck.getActiveUnitSystem();
+    auto& default_unitsystem = this->deck.getDefaultUnitSystem();
+    const auto* raw_keyword = rawKeyword.get();
+    auto convert = [&parserKeyword,
+                    worker_context = std::move(worker_context),
+                    raw_keyword,
+                    active_unitsystem,
+                    default_unitsystem]() mutable -> std::optional<DeckKeyword>
+    {
+        ErrorGuard worker_errors;
+        auto worker_keyword = *raw_keyword;
+        auto deck_keyword = parserKeyword.parse(worker_context, worker_errors, worker_keyword, active_unitsystem, default_unitsystem);
+        if (!worker_errors.warnings().empty())
+            return std::nullopt;
+
+        return deck_keyword;
+    };
+
+    auto deck_keyword = std::async(std::launch::async, std::move(convert));
+    this->pending_keywords.push_back( { &parserKeyword, &active_unitsystem, &default_unitsystem,
+                                        std::move(rawKeyword), std::move(deck_keyword) } );
+    return true;
 }
 
+void ParserState::addPendingKeywords(std::size_t max_pending) {
+    while (this->pending_keywords.size() > max_pending) {
+        auto pending = std::move(this->pending_keywords.front());
+        this->pending_keywords.pop_front();
 
+        try {
+            auto deck_keyword = pending.deck_keyword.get();
+            if (deck_keyword.has_value()) {
+                addDimensions(*pending.parser_keyword, *pending.active_unitsystem, *pending.default_unitsystem);
+                this->deck.addKeyword( std::move(*deck_keyword) );
+            } else
+                this->deck.addKeyword( pending.parser_keyword->parse(this->parseContext,
+                                                                     this->errors,
+                                                                     *pending.raw_keyword,
+                                                                     *pending.active_unitsystem,
+                                                                     *pending.default_unitsystem) );
+        } catch (const OpmInputError& opm_error) {
+            throw;
+        } catch (const std::exception& e) {
+            const OpmInputError opm_error { e, pending.raw_keyword->location() } ;
+
+            OpmLog::error(opm_error.what());
+
+            std::throw_with_nested(opm_error);
+        }
+    }
+}
 
-void ParserState::ungetline(const std::string_view& line) {
-    auto& file_view = this->input_stack.top().input;
-    if (line.end() + 1 != file_view.begin())
-        throw std::invalid_argument("line view does not immediately proceed file_view");
+std::size_t ParserState::deckSize() const {
+    return this->deck.size() + this->pending_keywords.size();
+}
 
-    file_view = std::string_view(line.begin(), file_view.end() - line.begin());
-    this->input_stack.top().lineNR--;
+std::string_view ParserState::getline() {
+    return this->input_stack.top().getline();
+}
+
+
+
+void ParserState::ungetline(const std::string_view& line) {
+    this->input_stack.top().ungetline(line);
 }
 
 
@@ -534,59 +939,115 @@ ParserState::ParserState(const std::vector<std::pair<std::string, std::string>>&
     errors( errors_arg )
 {}
 
-ParserState::ParserState( const std::vector<std::pair<std::string, std::string>>& code_keywords_arg,
-                          const ParseContext& context,
-                          ErrorGuard& errors_arg,
-                          std::filesystem::path p,
-                          const std::set<Opm::Ecl::SectionType>& ignore ) :
-    code_keywords(code_keywords_arg),
-    ignore_sections(ignore),
-    rootPath( std::filesystem::canonical( p ).parent_path() ),
-    python( std::make_unique<Python>() ),
-    parseContext( context ),
-    errors( errors_arg )
-{
-    openRootFile( p );
-}
-
-bool ParserState::check_section_keywords() {
-
-    std::string_view root_file_str = this->input_stack.top().input;
-
-    int n = 0;
-    auto p0 = root_file_str.find_first_not_of(" \t\n");
+/*
+  Records the position of all section keywords in the root file, without
+  cleaning or tokenizing it. The sections which are ignored are later skipped
+  by jumping straight to the next section which should be parsed - so the
+  skipped part of the root file is never cleaned, and include files in the
+  skipped sections are never opened. This relies on all the section keywords
+  being in the root file; the mandatory ones are checked here.
+*/
+void ParserState::indexSections() {
+    const auto& root = this->input_stack.top();
+    const std::string_view input = root.remaining();
+    std::size_t line_number = root.lineNR;
+    std::size_t line_start = 0;
+
+    while (line_start < input.size()) {
+        auto line_end = input.find('\n', line_start);
+        if (line_end == std::string_view::npos)
+            line_end = input.size();
+
+        line_number++;
+        const auto first = input.find_first_not_of(" \t", line_start);
+        if ((first < line_end) && (std::string_view("EGPRS").find(input[first]) != std::string_view::npos)) {
+            const auto line = str::trim( str::strip_comments( input.substr(first, line_end - first) ) );
+            if (const auto section = section_type(line); section.has_value())
+                this->section_index.push_back( {section.value(), input.data() + line_start, line_number} );
+        }
 
-    while (p0 != std::string::npos){
+        line_start = line_end + 1;
+    }
 
-        auto p1 = root_file_str.find_first_of(" \t\n", p0 + 1);
+    for (const auto section : {Opm::Ecl::GRID, Opm::Ecl::PROPS, Opm::Ecl::SOLUTION, Opm::Ecl::SCHEDULE}) {
+        const auto in_root = std::any_of(this->section_index.begin(), this->section_index.end(),
+                                         [section](const SectionMarker& marker) { return marker.section == section; });
+        if (!in_root)
+            throw std::runtime_error("Parsing individual sections not possible unless the section keywords are in the root input file");
+    }
+}
 
-        if (root_file_str.substr(p0, p1-p0) == "GRID")
-            n++;
-        else if (root_file_str.substr(p0, p1-p0) == "PROPS")
-            n++;
-        else if (root_file_str.substr(p0, p1-p0) == "REGIONS")
-            n++;
-        else if (root_file_str.substr(p0, p1-p0) == "SOLUTION")
-            n++;
-        else if (root_file_str.substr(p0, p1-p0) == "SUMMARY")
-            n++;
-        else if (root_file_str.substr(p0, p1-p0) == "SCHEDULE")
-            n++;
+bool ParserState::ignoreSection(const std::string& keyword) const {
+    if (this->ignore_sections.empty())
+        return false;
 
-        p0 = root_file_str.find_first_not_of(" \t\n", p1);
-    }
+    const auto section = section_type(keyword);
+    return section.has_value() && (this->ignore_sections.count(section.value()) > 0);
+}
 
-    if (n < 6)
+/*
+  Moves the root file forward to the next section which should be parsed.
+  Returns false if there is no such section, i.e. the rest of the input
+  should be ignored.
+*/
+bool ParserState::skipSection() {
+    if (this->input_stack.size() != 1)
+        throw std::runtime_error(fmt::format("Parsing individual sections not possible with section keyword {} in include file {}",
+                                             this->lastKeyWord, this->current_path().string()));
+
+    auto& root = this->input_stack.top();
+    const char* pos = root.remaining().data();
+    const auto next = std::find_if(this->section_index.begin(), this->section_index.end(),
+                                   [pos, this](const SectionMarker& marker)
+                                   {
+                                       return (marker.pos >= pos) && (this->ignore_sections.count(marker.section) == 0);
+                                   });
+    if (next == this->section_index.end())
         return false;
-    else
-        return true;
+
+    root.skip_to(next->pos, next->line_number);
+    return true;
 }
 
 void ParserState::loadString(const std::string& input) {
     this->input_stack.push( str::clean( this->code_keywords, input + "\n" ) );
 }
 
+void ParserState::addInputFile(const std::filesystem::path& inputFile, std::string_view content) {
+    const auto content_hash = this->hash_input_files ? DeckCache::hash( content ) : 0;
+    this->input_files.emplace_back( inputFile, content_hash );
+}
+
 void ParserState::loadFile(const std::filesystem::path& inputFile) {
+    /*
+      Regular files are memory mapped and cleaned lazily while parsing. Files
+      with code keywords (PYINPUT, ...) must be cleaned up front, since the
+      code blocks must be passed through verbatim.
+    */
+    if (auto mapping = MappedFile::map( inputFile ); mapping.has_value()) {
+        const std::string_view content( mapping->data(), mapping->size() );
+        this->addInputFile( inputFile, content );
+
+        const bool has_code = std::any_of(this->code_keywords.begin(), this->code_keywords.end(),
+                                          [&content](const std::pair<std::string, std::string>& code_pair)
+                                          {
+                                              return content.find(code_pair.first) != std::string_view::npos;
+                                          });
+
+        if (!has_code) {
+            this->input_stack.push( std::move( *mapping ), inputFile );
+            return;
+        }
+
+        std::string buffer;
+        buffer.reserve( content.size() + 1 );
+        buffer.append( content );
+        buffer.push_back( '\n' );
+        mapping.reset();
+
+        this->input_stack.push( str::clean( this->code_keywords, buffer ), inputFile );
+        return;
+    }
 
     const auto closer = []( std::FILE* f ) { std::fclose( f ); };
     std::unique_ptr< std::FILE, decltype( closer ) > ufp(
@@ -597,6 +1058,7 @@ void ParserState::loadFile(const std::filesystem::path& inputFile) {
     // make sure the file we'd like to parse is readable
     if( !ufp ) {
         std::string msg = "Could not read from file: " + inputFile.string();
+        this->cacheable = false;
         parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , msg, {}, errors);
         return;
     }
@@ -618,6 +1080,7 @@ void ParserState::loadFile(const std::filesystem::path& inputFile) {
         throw std::runtime_error( "Error when reading input file '"
                                   + inputFile.string() + "'" );
 
+    this->addInputFile( inputFile, std::string_view( buffer.data(), readc ) );
     this->input_stack.push( str::clean( this->code_keywords, buffer ), inputFile );
 }
 
@@ -705,6 +1168,15 @@ newRawKeyword(const ParserKeyword& parserKeyword,
               ParserState&         parserState,
               const Parser&        parser)
 {
+    if (!parserKeyword.prohibitedKeywords().empty() ||
+        !parserKeyword.requiredKeywords().empty() ||
+        (parserKeyword.getSizeType() == OTHER_KEYWORD_IN_DECK) ||
+        (parserKeyword.getSizeType() == SPECIAL_CASE_ROCK))
+    {
+        // The deck is inspected below.
+        parserState.addPendingKeywords();
+    }
+
     for (const auto& keyword : parserKeyword.prohibitedKeywords()) {
         if (parserState.deck.hasKeyword(keyword)) {
             parserState
@@ -843,15 +1315,20 @@ newRawKeyword(const ParserKeyword& parserKeyword,
                           targetSize);
 }
 
-RawKeyword*
-newRawKeyword(const std::string&      deck_name,
-              ParserState&            parserState,
-              const Parser&           parser,
-              const std::string_view& line)
+/*
+  Looks up the deck name in the parser, and reports keyword names which are
+  too long, unknown keywords and random text. Returns nullptr if there is no
+  keyword to parse.
+*/
+const ParserKeyword*
+findParserKeyword(const std::string&      deck_name,
+                  ParserState&            parserState,
+                  const Parser&           parser,
+                  const std::string_view& line)
 {
     if (deck_name.size() > RawConsts::maxKeywordLength) {
-        const std::string keyword8 = deck_name.substr(0, RawConsts::maxKeywordLength);
-        if (parser.isRecognizedKeyword(keyword8)) {
+        const auto keyword8 = std::string_view(deck_name).substr(0, RawConsts::maxKeywordLength);
+        if (const auto* parserKeyword = parser.findParserKeyword(keyword8); parserKeyword != nullptr) {
             const auto msg = std::string {
                 "Keyword {keyword} to long - only eight "
                 "first characters recognized\n"
@@ -868,9 +1345,7 @@ newRawKeyword(const std::string&      deck_name,
                                                  parserState.errors);
 
             parserState.unknown_keyword = false;
-            const auto& parserKeyword = parser.getParserKeywordFromDeckName(keyword8);
-
-            return newRawKeyword(parserKeyword, keyword8, parserState, parser);
+            return parserKeyword;
         }
         else {
             parserState.parseContext.handleUnknownKeyword(deck_name, KeywordLocation{}, parserState.errors);
@@ -880,11 +1355,9 @@ newRawKeyword(const std::string&      deck_name,
         }
     }
 
-    if (parser.isRecognizedKeyword(deck_name)) {
+    if (const auto* parserKeyword = parser.findParserKeyword(deck_name); parserKeyword != nullptr) {
         parserState.unknown_keyword = false;
-        const auto& parserKeyword = parser.getParserKeywordFromDeckName(deck_name);
-
-        return newRawKeyword(parserKeyword, deck_name, parserState, parser);
+        return parserKeyword;
     }
 
     if (ParserKeyword::validDeckName(deck_name)) {
@@ -928,11 +1401,18 @@ void skipUDT( ParserState& parserState, const Parser& parser) {
 }
 
 
-std::unique_ptr<RawKeyword> tryParseKeyword( ParserState& parserState, const Parser& parser) {
+/*
+  Reads the next keyword from the input. On return parserKeyword refers to
+  the definition of the keyword in the parser, which is owned by the parser.
+*/
+std::unique_ptr<RawKeyword> tryParseKeyword( ParserState& parserState, const Parser& parser, const ParserKeyword*& parserKeyword) {
     bool is_title = false;
     std::unique_ptr<RawKeyword> rawKeyword;
     std::string_view record_buffer(str::emptystr);
-    std::optional<ParserKeyword> parserKeyword;
+    parserKeyword = nullptr;
+
+    // No keyword refers to the input of closed files at this point.
+    parserState.releaseClosedFiles();
     while( !parserState.done() ) {
         auto line = parserState.getline();
 
@@ -953,16 +1433,15 @@ std::unique_ptr<RawKeyword> tryParseKeyword( ParserState& parserState, const Par
               2. The ParserKeyword::validDeckName() verifies that the keyword
                  candidate only contains valid characters.
 
-              3. In the newRawKeyword() function the first 8 characters of the
-                 deck_name is used to look for the keyword in the Parser
-                 container.
+              3. In the findParserKeyword() function the first 8 characters
+                 of the deck_name is used to look for the keyword in the
+                 Parser container.
             */
             std::string deck_name = str::make_deck_name( line );
             if (ParserKeyword::validDeckName(deck_name)) {
-                auto ptr = newRawKeyword( deck_name, parserState, parser, line );
-                if (ptr) {
-                    rawKeyword.reset( ptr );
-                    parserKeyword = parser.getParserKeywordFromDeckName(rawKeyword->getKeywordName());
+                parserKeyword = findParserKeyword( deck_name, parserState, parser, line );
+                if (parserKeyword) {
+                    rawKeyword.reset( newRawKeyword( *parserKeyword, deck_name.substr(0, RawConsts::maxKeywordLength), parserState, parser ) );
                     if (deck_name == "UDT") {
                         skipUDT(parserState, parser);
                         return nullptr;
@@ -1012,7 +1491,7 @@ std::unique_ptr<RawKeyword> tryParseKeyword( ParserState& parserState, const Par
                   keyword.
                 */
                 std::string deck_name = str::make_deck_name( line );
-                if( parser.isRecognizedKeyword( deck_name ) ) {
+                if( parser.findParserKeyword( deck_name ) ) {
                     rawKeyword->terminateKeyword();
                     parserState.ungetline(line);
                     return rawKeyword;
@@ -1066,61 +1545,28 @@ std::unique_ptr<RawKeyword> tryParseKeyword( ParserState& parserState, const Par
     return rawKeyword;
 }
 
-std::string_view advance_parser_state( ParserState& parserState, const std::string& to_keyw )
-{
-    auto line = parserState.getline();
-
-    while (line != to_keyw) {
-        line = parserState.getline();
-    }
-
-    return line;
-}
-
 bool parseState( ParserState& parserState, const Parser& parser ) {
     std::string filename = parserState.current_path().string();
 
-    auto ignore = parserState.get_ignore();
-
-    if (ignore.size() > 0)
-        if (!parserState.check_section_keywords())
-            throw std::runtime_error("Parsing individual sections not possible when section keywords in root input file");
-
-    bool ignore_grid = ignore.find(Opm::Ecl::GRID) !=ignore.end()  ? true : false;
-    bool ignore_props = ignore.find(Opm::Ecl::PROPS) !=ignore.end()  ? true : false;
-    bool ignore_regions = ignore.find(Opm::Ecl::REGIONS) !=ignore.end()  ? true : false;
-    bool ignore_solution = ignore.find(Opm::Ecl::SOLUTION) !=ignore.end()  ? true : false;
-    bool ignore_summary = ignore.find(Opm::Ecl::SUMMARY) !=ignore.end()  ? true : false;
-    bool ignore_schedule = ignore.find(Opm::Ecl::SCHEDULE) !=ignore.end()  ? true : false;
+    if (!parserState.get_ignore().empty())
+        parserState.indexSections();
 
     while( !parserState.done() ) {
-        auto rawKeyword = tryParseKeyword( parserState, parser);
+        const ParserKeyword* parserKeyword = nullptr;
+        auto rawKeyword = tryParseKeyword( parserState, parser, parserKeyword );
 
         if( !rawKeyword )
             continue;
 
-        std::string_view keyw = rawKeyword->getKeywordName();
-
-        if ((ignore_grid) && (keyw=="GRID"))
-            keyw = advance_parser_state( parserState, "PROPS" );
-
-        if ((ignore_props) && (keyw=="PROPS"))
-            keyw = advance_parser_state( parserState, "REGIONS" );
-
-        if ((ignore_regions) && (keyw=="REGIONS"))
-            keyw = advance_parser_state( parserState, "SOLUTION" );
-
-        if ((ignore_solution) && (keyw=="SOLUTION"))
-            keyw = advance_parser_state( parserState, "SUMMARY" );
-
-        if ((ignore_summary) && (keyw=="SUMMARY"))
-            keyw = advance_parser_state( parserState, "SCHEDULE" );
+        if (parserState.ignoreSection( rawKeyword->getKeywordName() )) {
+            if (!parserState.skipSection())
+                break;
 
-        if ((ignore_schedule) && (keyw=="SCHEDULE"))
-            return true;
+            continue;
+        }
 
         if (rawKeyword->getKeywordName() == Opm::RawConsts::end)
-            return true;
+            break;
 
         if (rawKeyword->getKeywordName() == Opm::RawConsts::endinclude) {
             parserState.closeFile();
@@ -1150,16 +1596,20 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
             continue;
         }
 
-        if( parser.isRecognizedKeyword( rawKeyword->getKeywordName() ) ) {
-            const auto& kwname = rawKeyword->getKeywordName();
-            const auto& parserKeyword = parser.getParserKeywordFromDeckName( kwname );
+        if( parserKeyword ) {
             {
                 const auto& location = rawKeyword->location();
-                auto msg = fmt::format("{:5} Reading {:<8} in {} line {}", parserState.deck.size(), rawKeyword->getKeywordName(), location.filename, location.lineno);
+                auto msg = fmt::format("{:5} Reading {:<8} in {} line {}", parserState.deckSize(), rawKeyword->getKeywordName(), location.filename, location.lineno);
                 OpmLog::info(msg);
             }
+
+            if (parserState.convertAsync( *parserKeyword, rawKeyword ))
+                continue;
+
+            parserState.addPendingKeywords();
             try {
                 if (rawKeyword->getKeywordName() ==  Opm::RawConsts::pyinput) {
+                    parserState.cacheable = false;
                     if (parserState.python) {
                         std::string python_string = rawKeyword->getFirstRecord().getRecordString();
                         parserState.python->exec(python_string, parser, parserState.deck);
@@ -1168,15 +1618,19 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
                         throw std::logic_error("Cannot yet embed Python while still running Python.");
                 }
                 else {
-                    auto deck_keyword = parserKeyword.parse( parserState.parseContext,
-                                                             parserState.errors,
-                                                             *rawKeyword,
-                                                             parserState.deck.getActiveUnitSystem(),
-                                                             parserState.deck.getDefaultUnitSystem());
+                    auto deck_keyword = parserKeyword->parse( parserState.parseContext,
+                                                              parserState.errors,
+                                                              *rawKeyword,
+                                                              parserState.deck.getActiveUnitSystem(),
+                                                              parserState.deck.getDefaultUnitSystem());
 
                     if (deck_keyword.name() == ParserKeywords::IMPORT::keywordName) {
                         bool formatted = deck_keyword.getRecord(0).getItem(1).get<std::string>(0)[0] == 'F';
                         const auto& import_file = parserState.getIncludeFilePath(deck_keyword.getRecord(0).getItem(0).get<std::string>(0));
+                        // The file is hashed before it is read, so that a later
+                        // modification will always invalidate the cache entry.
+                        const auto content_hash = parserState.hash_input_files ? DeckCache::contentHash( import_file.value() ) : 0;
+                        parserState.input_files.emplace_back( import_file.value(), content_hash );
 
                         ImportContainer import(parser, parserState.deck.getActiveUnitSystem(), import_file.value().string(), formatted, parserState.deck.size());
                         for (auto kw : import)
@@ -1210,6 +1664,7 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         }
     }
 
+    parserState.addPendingKeywords();
     return true;
 }
 
@@ -1320,8 +1775,41 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         else
             data_file = std::filesystem::proximate( std::filesystem::canonical(dataFileName) );
 
-        ParserState parserState( this->codeKeywords(), parseContext, errors, data_file, ignore_sections);
+        /*
+          The deck cache is only used when the full deck is parsed. The
+          warnings raised by the ParseContext when the deck was parsed are
+          stored in the cache entry, and replayed when the entry is used.
+        */
+        std::optional<DeckCache> deck_cache;
+        std::uint64_t cache_key = 0;
+        if (this->deck_cache_directory.has_value() && ignore_sections.empty()) {
+            deck_cache.emplace( this->deck_cache_directory.value() );
+            cache_key = this->deckCacheKey( parseContext );
+
+            auto entry = deck_cache->load( data_file, cache_key );
+            if (entry.has_value()) {
+                for (const auto& [error_key, msg] : entry->warnings) {
+                    if (parseContext.hasKey(error_key) && (parseContext.get(error_key) == InputErrorAction::WARN))
+                        OpmLog::warning(msg);
+
+                    errors.addWarning(error_key, msg);
+                }
+                return std::move( entry->deck );
+            }
+        }
+
+        const auto num_warnings = errors.warnings().size();
+        ParserState parserState( this->codeKeywords(), parseContext, errors, ignore_sections);
+        parserState.num_threads = this->num_threads;
+        parserState.hash_input_files = deck_cache.has_value();
+        parserState.openRootFile( data_file );
         parseState( parserState, *this );
+
+        if (deck_cache.has_value() && parserState.cacheable && !errors) {
+            const DeckCache::Warnings warnings(errors.warnings().begin() + num_warnings, errors.warnings().end());
+            deck_cache->store( parserState.deck, data_file, parserState.input_files, warnings, cache_key );
+        }
+
         return std::move( parserState.deck );
     }
 
@@ -1348,6 +1836,7 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
 
     Deck Parser::parseString(const std::string &data, const ParseContext& parseContext, ErrorGuard& errors) const {
         ParserState parserState( this->codeKeywords(), parseContext, errors );
+        parserState.num_threads = this->num_threads;
         parserState.loadString( data );
         parseState( parserState, *this );
         return std::move( parserState.deck );
@@ -1364,7 +1853,50 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     }
 
     size_t Parser::size() const {
-        return m_deckParserKeywords.size();
+        // Lazy keywords which have been replaced by addParserKeyword() are
+        // retained, since the ParserKeyword may have been handed out.
+        const auto lazy_size = std::count_if(m_lazyKeywords.begin(), m_lazyKeywords.end(),
+                                             [this](const auto& lazy_pair) { return m_deckParserKeywords.count(lazy_pair.first) == 0; });
+        return m_deckParserKeywords.size() + lazy_size;
+    }
+
+    void Parser::setNumThreads(std::size_t num_threads_arg) {
+        this->num_threads = std::max(num_threads_arg, std::size_t{1});
+    }
+
+    std::size_t Parser::numThreads() const {
+        return this->num_threads;
+    }
+
+    /*
+      The key covers everything in the parser configuration which can change
+      the deck, or the diagnostics from parsing it: the opm-common version,
+      the builtin keyword definitions, all keywords which have been added to
+      the parser and the ParseContext settings.
+    */
+    std::uint64_t Parser::deckCacheKey(const ParseContext& parseContext) const {
+        std::string key = fmt::format("{};{:016x}", PROJECT_VERSION, builtinKeywordsHash());
+        for (const auto& keyword : this->keyword_storage)
+            key += keyword.createCode();
+
+        std::vector<std::string_view> lazy_names;
+        for (const auto& lazy_pair : this->m_lazyKeywords)
+            lazy_names.push_back(lazy_pair.first);
+        std::sort(lazy_names.begin(), lazy_names.end());
+        for (const auto& name : lazy_names)
+            key += fmt::format(";{}", name);
+
+        for (const auto& [error_key, action] : parseContext)
+            key += fmt::format(";{}={}", error_key, static_cast<int>(action));
+
+        for (const auto& keyword : parseContext.ignoredKeywords())
+            key += fmt::format(";!{}", keyword);
+
+        return DeckCache::hash( key );
+    }
+
+    void Parser::setDeckCache(const std::filesystem::path& directory) {
+        this->deck_cache_directory = directory;
     }
 
     const ParserKeyword* Parser::matchingKeyword(const std::string_view& name) const {
@@ -1380,13 +1912,49 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     }
 
     bool Parser::isRecognizedKeyword(const std::string_view& name ) const {
+        return this->findParserKeyword( name ) != nullptr;
+    }
+
+    const ParserKeyword* Parser::findParserKeyword(const std::string_view& name) const {
         if( !ParserKeyword::validDeckName( name ) )
-            return false;
+            return nullptr;
 
-        if( m_deckParserKeywords.count( name ) )
-            return true;
+        if (const auto* keyword = this->storedKeyword( name ); keyword != nullptr)
+            return keyword;
 
-        return bool( matchingKeyword( name ) );
+        return matchingKeyword( name );
+    }
+
+    /*
+      A keyword registered with addLazyParserKeyword(). The keyword is
+      constructed on first use; std::call_once makes that safe when a const
+      Parser is used from several threads.
+    */
+    struct Parser::LazyKeyword {
+        explicit LazyKeyword(ParserKeyword (*factory_arg)())
+            : factory(factory_arg)
+        {}
+
+        const ParserKeyword& get() {
+            std::call_once(this->constructed, [this]() { this->keyword.emplace( this->factory() ); });
+            return *this->keyword;
+        }
+
+        ParserKeyword (*factory)();
+        std::once_flag constructed;
+        std::optional<ParserKeyword> keyword;
+    };
+
+    const ParserKeyword* Parser::storedKeyword(const std::string_view& name) const {
+        auto candidate = m_deckParserKeywords.find( name );
+        if( candidate != m_deckParserKeywords.end() )
+            return candidate->second;
+
+        auto lazy_candidate = m_lazyKeywords.find( name );
+        if( lazy_candidate != m_lazyKeywords.end() )
+            return std::addressof( lazy_candidate->second->get() );
+
+        return nullptr;
     }
 
 void Parser::addParserKeyword( ParserKeyword parserKeyword ) {
@@ -1424,13 +1992,19 @@ void Parser::addParserKeyword( ParserKeyword parserKeyword ) {
 }
 
 
+void Parser::addLazyParserKeyword(std::string_view name, ParserKeyword (*factory)()) {
+    m_deckParserKeywords.erase(name);
+    m_lazyKeywords.insert_or_assign(name, std::make_shared<LazyKeyword>(factory));
+}
+
+
 void Parser::addParserKeyword(const Json::JsonObject& jsonKeyword) {
     addParserKeyword( ParserKeyword( jsonKeyword ) );
 }
 
 bool Parser::hasKeyword( const std::string& name ) const {
-    return this->m_deckParserKeywords.find( std::string_view( name ) )
-        != this->m_deckParserKeywords.end();
+    return (this->m_deckParserKeywords.count( std::string_view( name ) ) > 0)
+        || (this->m_lazyKeywords.count( std::string_view( name ) ) > 0);
 }
 
 const ParserKeyword& Parser::getKeyword( const std::string& name ) const {
@@ -1438,9 +2012,8 @@ const ParserKeyword& Parser::getKeyword( const std::string& name ) const {
 }
 
 const ParserKeyword& Parser::getParserKeywordFromDeckName(const std::string_view& name ) const {
-    auto candidate = m_deckParserKeywords.find( name );
-
-    if( candidate != m_deckParserKeywords.end() ) return *candidate->second;
+    if (const auto* keyword = this->storedKeyword( name ); keyword != nullptr)
+        return *keyword;
 
     const auto* wildCardKeyword = matchingKeyword( name );
 
@@ -1455,6 +2028,11 @@ std::vector<std::string> Parser::getAllDeckNames () const {
     for (auto iterator = m_deckParserKeywords.begin(); iterator != m_deckParserKeywords.end(); iterator++) {
         keywords.push_back(std::string(iterator->first));
     }
+    for (const auto& [deck_name, lazy_keyword] : m_lazyKeywords) {
+        if (m_deckParserKeywords.count(deck_name) == 0)
+            keywords.push_back(std::string(deck_name));
+    }
+    std::sort(keywords.begin(), keywords.end());
     for (auto iterator = m_wildCardKeywords.begin(); iterator != m_wildCardKeywords.end(); iterator++) {
         keywords.push_back(std::string(iterator->first));
     }
@@ -17,10 +17,12 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <ostream>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <type_traits>
 
 #include <opm/json/JsonObject.hpp>
 
@@ -29,6 +31,7 @@
 #include <opm/input/eclipse/Deck/UDAValue.hpp>
 #include <opm/input/eclipse/Units/UnitSystem.hpp>
 
+#include "raw/RawConsts.hpp"
 #include "raw/RawRecord.hpp"
 #include "raw/StarToken.hpp"
 
@@ -117,14 +120,14 @@ T& ParserItem::value_ref() {
 
 
 ParserItem::ParserItem( const std::string& itemName, ParserItem::itype input_type_arg) :
-    m_name(itemName),
+    m_name(std::make_shared<const std::string>(itemName)),
     m_defaultSet(false)
 {
     this->setInputType(input_type_arg);
 }
 
 ParserItem::ParserItem( const Json::JsonObject& json ) :
-    m_name( json.get_string( "name" ) ),
+    m_name( std::make_shared<const std::string>( json.get_string( "name" ) ) ),
     m_sizeType( json.has_item( "size_type" )
               ? ParserItem::size_from_string( json.get_string( "size_type" ) )
               : ParserItem::item_size::SINGLE ),
@@ -253,11 +256,11 @@ void ParserItem::push_backDimension( const std::string& dim ) {
 }
 
     const std::string& ParserItem::name() const {
-        return m_name;
+        return *m_name;
     }
 
     const std::string ParserItem::className() const {
-        return m_name;
+        return *m_name;
     }
 
 
@@ -303,7 +306,7 @@ void ParserItem::push_backDimension( const std::string& dim ) {
 
     bool ParserItem::operator==( const ParserItem& rhs ) const {
     if( !( this->data_type      == rhs.data_type
-           && this->m_name         == rhs.m_name
+           && this->name()         == rhs.name()
            && this->m_description  == rhs.m_description
            && this->input_type     == rhs.input_type
            && this->m_sizeType     == rhs.m_sizeType
@@ -455,6 +458,87 @@ std::string ParserItem::createCode(const std::string& indent) const {
 
 namespace {
 
+template< typename T >
+void scan_token( DeckItem& deck_item, const ParserItem& parser_item, std::string_view token ) {
+    std::string countString;
+    std::string valueString;
+
+    if( !isStarToken( token, countString, valueString ) ) {
+        deck_item.push_back( readValueToken< T >( token ) );
+        return;
+    }
+
+    StarToken st(token, countString, valueString);
+
+    if( st.hasValue() ) {
+        deck_item.push_back( readValueToken< T >( st.valueString() ), st.count() );
+        return;
+    }
+
+    if (parser_item.hasDefault()) {
+        auto value = parser_item.getDefault< T >();
+        deck_item.push_backDefault( value, st.count());
+    } else {
+        deck_item.push_backDummyDefault<T>(st.count());
+    }
+}
+
+/*
+  Scans a complete, not yet tokenized, record string of numbers directly into
+  the deck item. This is the path taken by the large data keywords like
+  ZCORN and PORO; plain numbers and 'N*value' / 'N*' repeats are handled
+  inline and all other tokens are passed on to scan_token(), so the result
+  and the error handling is the same as when scanning the tokens one by one.
+*/
+template< typename T >
+void scan_data( DeckItem& deck_item, const ParserItem& parser_item, std::string_view data ) {
+    const auto end = data.end();
+    auto current = data.begin();
+    T value;
+
+    while( (current = std::find_if_not( current, end, RawConsts::is_separator() )) != end ) {
+        auto token_end = (*current == RawConsts::quote)
+            ? std::find( current + 1, end, RawConsts::quote )
+            : std::find_if( current, end, RawConsts::is_separator() );
+
+        if (token_end != end && *token_end == RawConsts::quote)
+            ++token_end;
+
+        const std::string_view token( &*current, std::distance( current, token_end ) );
+        current = token_end;
+
+        if (tryReadValueToken( token, value )) {
+            deck_item.push_back( value );
+            continue;
+        }
+
+        const auto star = std::find_if_not( token.begin(), token.end(),
+                                            [](char c) { return (c >= '0') && (c <= '9'); });
+        const auto count_size = std::distance( token.begin(), star );
+        int count = 0;
+        if ((star != token.end()) && (*star == '*') &&
+            (count_size > 0) && (count_size <= 9) &&
+            tryReadValueToken( token.substr(0, count_size), count ) && (count > 0))
+        {
+            const auto value_string = token.substr( count_size + 1 );
+            if (value_string.empty()) {
+                if (parser_item.hasDefault())
+                    deck_item.push_backDefault( parser_item.getDefault< T >(), count );
+                else
+                    deck_item.push_backDummyDefault<T>( count );
+                continue;
+            }
+
+            if (tryReadValueToken( value_string, value )) {
+                deck_item.push_back( value, count );
+                continue;
+            }
+        }
+
+        scan_token<T>( deck_item, parser_item, token );
+    }
+}
+
 template< typename T >
 void scan_item( DeckItem& deck_item, const ParserItem& parser_item, RawRecord& record ) {
     bool parse_raw = parser_item.parseRaw();
@@ -470,32 +554,17 @@ void scan_item( DeckItem& deck_item, const ParserItem& parser_item, RawRecord& r
             return;
         }
 
-        while( record.size() > 0 ) {
-            auto token = record.pop_front();
-
-            std::string countString;
-            std::string valueString;
-
-            if( !isStarToken( token, countString, valueString ) ) {
-                deck_item.push_back( readValueToken< T >( token ) );
-                continue;
-            }
-
-            StarToken st(token, countString, valueString);
-
-            if( st.hasValue() ) {
-                deck_item.push_back( readValueToken< T >( st.valueString() ), st.count() );
-                continue;
-            }
-
-            if (parser_item.hasDefault()) {
-                auto value = parser_item.getDefault< T >();
-                deck_item.push_backDefault( value, st.count());
-            } else {
-                deck_item.push_backDummyDefault<T>(st.count());
+        if constexpr (std::is_same_v<T, double> || std::is_same_v<T, int>) {
+            const auto data = record.pop_record_string();
+            if (data.has_value()) {
+                scan_data<T>( deck_item, parser_item, *data );
+                return;
             }
         }
 
+        while( record.size() > 0 )
+            scan_token<T>( deck_item, parser_item, record.pop_front() );
+
         return;
     }
 
@@ -565,7 +634,7 @@ DeckItem ParserItem::scan( RawRecord& record, UnitSystem& active_unitsystem, Uni
     switch( this->data_type ) {
     case type_tag::integer:
         {
-            DeckItem item( this->name(), int());
+            DeckItem item( this->m_name, int());
             scan_item< int >( item, *this, record );
             item.shrink_to_fit<int>();
             return item;
@@ -580,7 +649,7 @@ DeckItem ParserItem::scan( RawRecord& record, UnitSystem& active_unitsystem, Uni
                 default_dimensions.push_back( default_unitsystem.getNewDimension(dim_string) );
             }
 
-            DeckItem item(this->name(), double(), active_dimensions, default_dimensions);
+            DeckItem item(this->m_name, double(), active_dimensions, default_dimensions);
             scan_item< double >( item, *this, record );
             item.shrink_to_fit<double>();
             return item;
@@ -588,14 +657,14 @@ DeckItem ParserItem::scan( RawRecord& record, UnitSystem& active_unitsystem, Uni
         break;
     case type_tag::string:
         {
-            DeckItem item(this->name(), std::string());
+            DeckItem item(this->m_name, std::string());
             scan_item< std::string >( item, *this, record );
             return item;
         }
         break;
     case type_tag::raw_string:
         {
-            DeckItem item(this->name(), RawString());
+            DeckItem item(this->m_name, RawString());
             scan_item<RawString>( item, *this, record );
             return item;
         }
@@ -609,7 +678,7 @@ DeckItem ParserItem::scan( RawRecord& record, UnitSystem& active_unitsystem, Uni
                 default_dimensions.push_back( default_unitsystem.getNewDimension(dim_string) );
             }
 
-            DeckItem item(this->name(), UDAValue(), active_dimensions, default_dimensions);
+            DeckItem item(this->m_name, UDAValue(), active_dimensions, default_dimensions);
             scan_item<UDAValue>(item, *this, record);
             return item;
         }
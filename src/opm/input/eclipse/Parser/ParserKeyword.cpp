@@ -732,7 +732,7 @@ void set_dimensions( ParserItem& item,
             */
             size_t record_nr = 0;
             for (auto& rawRecord : rawKeyword) {
-                if (rawRecord.size() == 0) {
+                if (rawRecord.empty()) {
                      keyword.addRecord( DeckRecord() );
                      record_nr = 0;
                 }
@@ -745,7 +745,7 @@ void set_dimensions( ParserItem& item,
         else {
             size_t record_nr = 0;
             for( auto& rawRecord : rawKeyword ) {
-                if( m_records.size() == 0 && rawRecord.size() > 0 )
+                if( m_records.size() == 0 && !rawRecord.empty() )
                     throw std::invalid_argument("Missing item information " + rawKeyword.getKeywordName());
 
                 keyword.addRecord( this->getRecord( record_nr ).parse( parseContext, errors, rawRecord, active_unitsystem, default_unitsystem, rawKeyword.location() ) );
@@ -84,17 +84,40 @@ inline bool even_quotes( const T& str ) {
         m_sanitizedRecordString( singleRecordString )
     {
 
-        if (text)
+        if (text) {
             this->m_recordItems.push_back(this->m_sanitizedRecordString);
+            this->m_max_size = this->m_recordItems.size();
+            this->m_tokenized = true;
+        }
         else {
-            this->m_recordItems = splitSingleRecordString( m_sanitizedRecordString );
-
             if( !even_quotes( singleRecordString ) ) {
                 std::string error = fmt::format("Quotes are not balanced in: \"{}\"", std::string(singleRecordString));
                 throw OpmInputError(error, location);
             }
         }
+    }
+
+    void RawRecord::split() const {
+        this->m_recordItems = splitSingleRecordString( m_sanitizedRecordString );
         this->m_max_size = this->m_recordItems.size();
+        this->m_tokenized = true;
+    }
+
+    bool RawRecord::empty() const {
+        if (this->m_tokenized)
+            return this->m_recordItems.empty();
+
+        return std::find_if_not( this->m_sanitizedRecordString.begin(),
+                                 this->m_sanitizedRecordString.end(),
+                                 RawConsts::is_separator() ) == this->m_sanitizedRecordString.end();
+    }
+
+    std::optional<std::string_view> RawRecord::pop_record_string() {
+        if (this->m_tokenized)
+            return {};
+
+        this->m_tokenized = true;
+        return this->m_sanitizedRecordString;
     }
 
     RawRecord::RawRecord(const std::string_view& singleRecordString, const KeywordLocation& location) :
@@ -102,6 +125,7 @@ inline bool even_quotes( const T& str ) {
     {}
 
     void RawRecord::push_front( std::string_view tok, std::size_t count ) {
+        this->tokenize();
         this->m_recordItems.insert( this->m_recordItems.begin(), count, tok );
         this->m_max_size += count;
     }
@@ -110,7 +134,12 @@ inline bool even_quotes( const T& str ) {
         return std::string(m_sanitizedRecordString);
     }
 
+    std::size_t RawRecord::getRecordStringSize() const {
+        return this->m_sanitizedRecordString.size();
+    }
+
     std::size_t RawRecord::max_size() const {
+        this->tokenize();
         return this->m_max_size;
     }
 }
@@ -22,6 +22,7 @@
 
 #include <deque>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <list>
@@ -32,6 +33,10 @@ class KeywordLocation;
     /// Class representing the lowest level of the Raw datatypes, a record. A record is simply
     /// a vector containing the record elements, represented as strings. Some logic is present
     /// to handle special elements in a record string, particularly with quote characters.
+    ///
+    /// The record string is only split into elements when the elements are first accessed;
+    /// the large records of data keywords like ZCORN can then be scanned directly from the
+    /// record string with pop_record_string().
 
     class RawRecord {
     public:
@@ -42,36 +47,55 @@ class KeywordLocation;
         inline std::string_view front() const;
         void push_front( std::string_view token, std::size_t count );
         inline size_t size() const;
+        bool empty() const;
         std::size_t max_size() const;
 
+        // Returns the full record string if no elements have been consumed
+        // yet; the record is then empty. Returns nullopt otherwise.
+        std::optional<std::string_view> pop_record_string();
+
         std::string getRecordString() const;
+        std::size_t getRecordStringSize() const;
         inline std::string_view getItem(size_t index) const;
 
     private:
         std::string_view m_sanitizedRecordString;
-        std::deque< std::string_view > m_recordItems;
-        std::size_t m_max_size;
+        mutable std::deque< std::string_view > m_recordItems;
+        mutable std::size_t m_max_size = 0;
+        mutable bool m_tokenized = false;
+
+        inline void tokenize() const;
+        void split() const;
     };
 
     /*
      * These are frequently called, but fairly trivial in implementation, and
      * inlining the calls gives a decent low-effort performance benefit.
      */
+    void RawRecord::tokenize() const {
+        if (!this->m_tokenized)
+            this->split();
+    }
+
     std::string_view RawRecord::pop_front() {
+        this->tokenize();
         auto front = m_recordItems.front();
         this->m_recordItems.pop_front();
         return front;
     }
 
     std::string_view RawRecord::front() const {
+        this->tokenize();
         return this->m_recordItems.front();
     }
 
     size_t RawRecord::size() const {
+        this->tokenize();
         return m_recordItems.size();
     }
 
     std::string_view RawRecord::getItem(size_t index) const {
+        this->tokenize();
         return this->m_recordItems.at( index );
     }
 }
@@ -20,6 +20,7 @@
 #include <array>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <string>
 #include <stdexcept>
 #include <cstdlib>
@@ -107,6 +108,120 @@ namespace Opm {
     }
 
 
+    namespace {
+        inline bool is_digit(char c) {
+            return (c >= '0') && (c <= '9');
+        }
+
+        // Powers of ten which are exactly representable as double.
+        constexpr std::array<double, 23> exact_pow10 = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+    }
+
+    template<>
+    bool tryReadValueToken< int >( std::string_view view, int& value ) {
+        auto cursor = view.begin();
+        bool negative = false;
+        if ((cursor != view.end()) && ((*cursor == '-') || (*cursor == '+'))) {
+            negative = (*cursor == '-');
+            ++cursor;
+        }
+
+        // At most nine digits can not overflow int.
+        const auto ndigits = view.end() - cursor;
+        if ((ndigits == 0) || (ndigits > 9))
+            return false;
+
+        int n = 0;
+        for (; cursor != view.end(); ++cursor) {
+            if (!is_digit(*cursor))
+                return false;
+            n = 10*n + (*cursor - '0');
+        }
+
+        value = negative ? -n : n;
+        return true;
+    }
+
+    /*
+      The boost::spirit real parser used in readValueToken<double>()
+      accumulates all the mantissa digits in an integer and then scales it
+      with a single multiplication or division by a power of ten. With at
+      most 15 digits and a scale of at most 22 both operands are exact
+      doubles, so doing the same here gives the identical, correctly rounded,
+      result. Everything else, e.g. very long mantissas, NaN and Inf, is left
+      to the spirit parser.
+    */
+    template<>
+    bool tryReadValueToken< double >( std::string_view view, double& value ) {
+        auto cursor = view.begin();
+        const auto end = view.end();
+
+        bool negative = false;
+        if ((cursor != end) && ((*cursor == '-') || (*cursor == '+'))) {
+            negative = (*cursor == '-');
+            ++cursor;
+        }
+
+        std::uint64_t mantissa = 0;
+        int ndigits = 0;
+        int frac_digits = 0;
+        for (; (cursor != end) && is_digit(*cursor); ++cursor, ++ndigits)
+            mantissa = 10*mantissa + (*cursor - '0');
+
+        if ((cursor != end) && (*cursor == '.')) {
+            ++cursor;
+            for (; (cursor != end) && is_digit(*cursor); ++cursor, ++ndigits, ++frac_digits)
+                mantissa = 10*mantissa + (*cursor - '0');
+        }
+
+        if ((ndigits == 0) || (ndigits > 15))
+            return false;
+
+        int exponent = 0;
+        if (cursor != end) {
+            // Fortran syntax allows 'D' as well as 'E' for the exponent.
+            if ((*cursor != 'e') && (*cursor != 'E') && (*cursor != 'd') && (*cursor != 'D'))
+                return false;
+            ++cursor;
+
+            bool negative_exponent = false;
+            if ((cursor != end) && ((*cursor == '-') || (*cursor == '+'))) {
+                negative_exponent = (*cursor == '-');
+                ++cursor;
+            }
+
+            const auto exp_digits = end - cursor;
+            if ((exp_digits == 0) || (exp_digits > 3))
+                return false;
+
+            for (; cursor != end; ++cursor) {
+                if (!is_digit(*cursor))
+                    return false;
+                exponent = 10*exponent + (*cursor - '0');
+            }
+
+            if (negative_exponent)
+                exponent = -exponent;
+        }
+
+        const int scale = exponent - frac_digits;
+        if ((scale < -22) || (scale > 22))
+            return false;
+
+        double n = static_cast<double>(mantissa);
+        if (scale >= 0)
+            n *= exact_pow10[scale];
+        else
+            n /= exact_pow10[-scale];
+
+        value = negative ? -n : n;
+        return true;
+    }
+
     template <>
     std::string readValueToken< std::string >( std::string_view view ) {
         if( view.size() == 0 || view[ 0 ] != '\'' )
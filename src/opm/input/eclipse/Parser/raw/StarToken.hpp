@@ -33,6 +33,15 @@ namespace Opm {
     template <class T>
     T readValueToken( std::string_view );
 
+    /*
+      Fast path for readValueToken<T>() for the plain numbers which make up
+      the bulk of large data keywords. Returns false if the token is not
+      recognized, in which case readValueToken<T>() must be used. When true is
+      returned the value is identical to the readValueToken<T>() value.
+    */
+    template <class T>
+    bool tryReadValueToken( std::string_view, T& );
+
 class StarToken {
 public:
     StarToken(const std::string_view& token)
@@ -109,10 +109,6 @@
 
 namespace {
 
-    bool name_match(const std::string& pattern, const std::string& name) {
-        return Opm::shmatch(pattern, name);
-    }
-
     double sumthin_summary_section(const Opm::SUMMARYSection& section) {
         const auto entries = section.getKeywordList<Opm::ParserKeywords::SUMTHIN>();
 
@@ -1254,14 +1250,8 @@ File {} line {}.)", pattern, location.keyword, location.filename, location.linen
 
         // Normal pattern matching
         auto star_pos = pattern.find('*');
-        if (star_pos != std::string::npos) {
-            std::vector<std::string> names;
-            for (const auto& gname : group_order) {
-                if (name_match(pattern, gname))
-                    names.push_back(gname);
-            }
-            return names;
-        }
+        if (star_pos != std::string::npos)
+            return group_order.names(ShellPattern(pattern));
 
         // Normal group name without any special characters
         if (group_order.has(pattern))
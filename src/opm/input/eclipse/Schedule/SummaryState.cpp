@@ -23,13 +23,16 @@
 
 #include <opm/common/utility/TimeService.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <ctime>
 #include <iomanip>
+#include <iterator>
 #include <ostream>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -96,6 +99,32 @@ namespace {
         }
     }
 
+    bool equal_slots(const std::vector<double>& values1, const std::size_t slot1,
+                     const std::vector<double>& values2, const std::size_t slot2)
+    {
+        return values1[slot1] == values2[slot2];
+    }
+
+    // Compares the values the two - possibly nested - maps refer to.
+    template <class K, class T>
+    bool equal_slots(const std::vector<double>& values1, const std::unordered_map<K, T>& map1,
+                     const std::vector<double>& values2, const std::unordered_map<K, T>& map2)
+    {
+        if (map1.size() != map2.size())
+            return false;
+
+        for (const auto& [key, elm1] : map1) {
+            const auto iter = map2.find(key);
+            if (iter == map2.end())
+                return false;
+
+            if (!equal_slots(values1, elm1, values2, iter->second))
+                return false;
+        }
+
+        return true;
+    }
+
     template <class T>
     std::vector<std::string> var2_list(const map2<T>& values, const std::string& var1) {
         const auto& var1_iter = values.find(var1);
@@ -115,6 +144,7 @@ namespace Opm
 
     SummaryState::SummaryState(time_point sim_start_arg)
         : sim_start(sim_start_arg)
+        , m_layout_id(next_layout_id())
     {
         this->update_elapsed(0);
     }
@@ -123,13 +153,142 @@ namespace Opm
         : SummaryState { TimeService::from_time_t(sim_start_arg) }
     {}
 
+    std::uint64_t SummaryState::next_layout_id()
+    {
+        static std::atomic<std::uint64_t> layout_id{0};
+        return ++layout_id;
+    }
+
+    std::size_t SummaryState::add_slot(const std::string& var)
+    {
+        const unsigned char flags = is_total(var) ? total_flag : 0;
+        this->m_layout_id = next_layout_id();
+
+        if (!this->m_free.empty()) {
+            const auto slot = this->m_free.back();
+            this->m_free.pop_back();
+            this->m_values[slot] = 0;
+            this->m_flags[slot] = flags;
+            this->m_link[slot] = no_link;
+            return slot;
+        }
+
+        this->m_values.push_back(0);
+        this->m_flags.push_back(flags);
+        this->m_link.push_back(no_link);
+        return this->m_values.size() - 1;
+    }
+
+    /*
+      The slot must no longer be referenced by any of the slot maps. When a
+      general slot is released the links to it must be dropped with
+      drop_stale_links() before the slot is reused.
+    */
+    void SummaryState::release_slot(const std::size_t slot)
+    {
+        this->m_flags[slot] = 0;
+        this->m_link[slot] = no_link;
+        this->m_free.push_back(slot);
+    }
+
+    void SummaryState::drop_stale_links()
+    {
+        for (auto& link : this->m_link) {
+            if ((link != no_link) && ((this->m_flags[link] & general_flag) == 0))
+                link = no_link;
+        }
+    }
+
+    std::size_t SummaryState::key_slot(const std::string& key)
+    {
+        auto iter = this->values.find(key);
+        if (iter != this->values.end())
+            return iter->second;
+
+        const auto slot = this->add_slot(key);
+        this->m_flags[slot] |= general_flag;
+        this->values.emplace(key, slot);
+        return slot;
+    }
+
+    bool SummaryState::is_linked(const std::size_t slot) const
+    {
+        const auto link = this->m_link[slot];
+        return (link != no_link) && ((this->m_flags[link] & general_flag) != 0);
+    }
+
+    /*
+      Links the slot of a specialized value to the slot of the general key,
+      which is added if it is missing - e.g. because it has been erased.
+    */
+    std::size_t SummaryState::link_slot(const std::size_t slot, const std::string& key)
+    {
+        this->m_link[slot] = this->key_slot(key);
+        return slot;
+    }
+
+    std::size_t SummaryState::var_slot(std::unordered_map<std::string, SlotMap>& var_values,
+                                       std::set<std::string>& names,
+                                       std::optional<std::vector<std::string>>& name_list,
+                                       const std::string& name,
+                                       const std::string& var)
+    {
+        auto& slots = var_values[var];
+        auto [iter, inserted] = slots.try_emplace(name, no_link);
+        if (inserted) {
+            iter->second = this->add_slot(var);
+            if (names.insert(name).second)
+                name_list.reset();
+        }
+        else if (this->is_linked(iter->second))
+            return iter->second;
+
+        return this->link_slot(iter->second, var + ":" + name);
+    }
+
+    std::size_t SummaryState::indexed_slot(std::unordered_map<std::size_t, std::size_t>& slots,
+                                           const std::string& well,
+                                           const std::string& var,
+                                           const std::size_t index)
+    {
+        auto [iter, inserted] = slots.try_emplace(index, no_link);
+        if (inserted)
+            iter->second = this->add_slot(var);
+        else if (this->is_linked(iter->second))
+            return iter->second;
+
+        return this->link_slot(iter->second, var + ":" + well + ":" + std::to_string(index));
+    }
+
+    void SummaryState::update_slot(const std::size_t slot, const double value)
+    {
+        const auto link = this->m_link[slot];
+        if (this->m_flags[slot] & total_flag) {
+            this->m_values[slot] += value;
+            if (link != no_link)
+                this->m_values[link] += value;
+        } else {
+            this->m_values[slot] = value;
+            if (link != no_link)
+                this->m_values[link] = value;
+        }
+    }
+
     void SummaryState::set(const std::string& key, double value)
     {
-        this->values.insert_or_assign(key, value);
+        this->m_values[this->key_slot(key)] = value;
     }
 
     bool SummaryState::erase(const std::string& key) {
-        return (this->values.erase(key) > 0);
+        auto iter = this->values.find(key);
+        if (iter == this->values.end())
+            return false;
+
+        this->release_slot(iter->second);
+        this->values.erase(iter);
+        this->drop_stale_links();
+        this->m_layout_id = next_layout_id();
+        return true;
     }
 
     bool SummaryState::erase_well_var(const std::string& well, const std::string& var)
@@ -138,6 +297,9 @@ namespace Opm
         if (!this->erase(key))
             return false;
 
+        if (const auto handle = this->well_var_handle(well, var); handle.has_value())
+            this->release_slot(handle->slot);
+
         erase_var(this->well_values, this->m_wells, var, well);
         this->well_names.reset();
         return true;
@@ -149,6 +311,9 @@ namespace Opm
         if (!this->erase(key))
             return false;
 
+        if (const auto handle = this->group_var_handle(group, var); handle.has_value())
+            this->release_slot(handle->slot);
+
         erase_var(this->group_values, this->m_groups, var, group);
         this->group_names.reset();
         return true;
@@ -181,67 +346,26 @@ namespace Opm
 
     bool SummaryState::has_conn_var(const std::string& well, const std::string& var, std::size_t global_index) const
     {
-        if (!has_var(this->conn_values, var, well))
-            return false;
-
-        const auto& index_map = this->conn_values.at(var).at(well);
-        return (index_map.count(global_index) > 0);
+        return this->conn_var_handle(well, var, global_index).has_value();
     }
 
     bool SummaryState::has_segment_var(const std::string& well,
                                        const std::string& var,
                                        const std::size_t  segment) const
     {
-        // Segment Values = [var][well][segment] -> double
-
-        auto varPos = this->segment_values.find(var);
-        if (varPos == this->segment_values.end()) {
-            return false;
-        }
-
-        auto wellPos = varPos->second.find(well);
-        if (wellPos == varPos->second.end()) {
-            return false;
-        }
-
-        return wellPos->second.find(segment) != wellPos->second.end();
+        return this->segment_var_handle(well, var, segment).has_value();
     }
 
     void SummaryState::update(const std::string& key, double value) {
-        if (is_total(key))
-            this->values[key] += value;
-        else
-            this->values[key] = value;
+        this->update_slot(this->key_slot(key), value);
     }
 
     void SummaryState::update_well_var(const std::string& well, const std::string& var, double value) {
-        std::string key = var + ":" + well;
-        if (is_total(var)) {
-            this->values[key] += value;
-            this->well_values[var][well] += value;
-        } else {
-            this->values[key] = value;
-            this->well_values[var][well] = value;
-        }
-        if (this->m_wells.count(well) == 0) {
-            this->m_wells.insert(well);
-            this->well_names.reset();
-        }
+        this->update_slot(this->var_slot(this->well_values, this->m_wells, this->well_names, well, var), value);
     }
 
     void SummaryState::update_group_var(const std::string& group, const std::string& var, double value) {
-        std::string key = var + ":" + group;
-        if (is_total(var)) {
-            this->values[key] += value;
-            this->group_values[var][group] += value;
-        } else {
-            this->values[key] = value;
-            this->group_values[var][group] = value;
-        }
-        if (this->m_groups.count(group) == 0) {
-            this->m_groups.insert(group);
-            this->group_names.reset();
-        }
+        this->update_slot(this->var_slot(this->group_values, this->m_groups, this->group_names, group, var), value);
     }
 
     void SummaryState::update_elapsed(double delta)
@@ -274,14 +398,7 @@ namespace Opm
 
     void SummaryState::update_conn_var(const std::string& well, const std::string& var, std::size_t global_index, double value)
     {
-        std::string key = var + ":" + well + ":" + std::to_string(global_index);
-        if (is_total(var)) {
-            this->values[key] += value;
-            this->conn_values[var][well][global_index] += value;
-        } else {
-            this->values[key] = value;
-            this->conn_values[var][well][global_index] = value;
-        }
+        this->update_slot(this->indexed_slot(this->conn_values[var][well], well, var, global_index), value);
     }
 
     void SummaryState::update_segment_var(const std::string& well,
@@ -289,16 +406,7 @@ namespace Opm
                                           const std::size_t  segment,
                                           const double       value)
     {
-        auto& val_ref  = this->values[var + ':' + well + ':' + std::to_string(segment)];
-        auto& sval_ref = this->segment_values[var][well][segment];
-
-        if (is_total(var)) {
-            val_ref  += value;
-            sval_ref += value;
-        }
-        else {
-            val_ref = sval_ref = value;
-        }
+        this->update_slot(this->indexed_slot(this->segment_values[var][well], well, var, segment), value);
     }
 
     double SummaryState::get(const std::string& key) const
@@ -307,7 +415,7 @@ namespace Opm
         if (iter == this->values.end())
             throw std::out_of_range("No such key: " + key);
 
-        return iter->second;
+        return this->m_values[iter->second];
     }
 
     double SummaryState::get(const std::string& key, double default_value) const
@@ -316,7 +424,7 @@ namespace Opm
         if (iter == this->values.end())
             return default_value;
 
-        return iter->second;
+        return this->m_values[iter->second];
     }
 
     double SummaryState::get_elapsed() const
@@ -326,47 +434,42 @@ namespace Opm
 
     double SummaryState::get_well_var(const std::string& well, const std::string& var) const
     {
-        return this->well_values.at(var).at(well);
+        return this->m_values[this->well_values.at(var).at(well)];
     }
 
     double SummaryState::get_group_var(const std::string& group, const std::string& var) const
     {
-        return this->group_values.at(var).at(group);
+        return this->m_values[this->group_values.at(var).at(group)];
     }
 
     double SummaryState::get_conn_var(const std::string& well, const std::string& var, std::size_t global_index) const
     {
-        return this->conn_values.at(var).at(well).at(global_index);
+        return this->m_values[this->conn_values.at(var).at(well).at(global_index)];
     }
 
     double SummaryState::get_segment_var(const std::string& well,
                                          const std::string& var,
                                          const std::size_t  segment) const
     {
-        return this->segment_values.at(var).at(well).at(segment);
+        return this->m_values[this->segment_values.at(var).at(well).at(segment)];
     }
 
     double SummaryState::get_well_var(const std::string& well, const std::string& var, double default_value) const
     {
-        if (this->has_well_var(well, var))
-            return this->get_well_var(well, var);
-
-        return default_value;
+        const auto handle = this->well_var_handle(well, var);
+        return handle.has_value() ? this->get(*handle) : default_value;
     }
 
     double SummaryState::get_group_var(const std::string& group, const std::string& var, double default_value) const
     {
-        if (this->has_group_var(group, var))
-            return this->get_group_var(group, var);
-
-        return default_value;
+        const auto handle = this->group_var_handle(group, var);
+        return handle.has_value() ? this->get(*handle) : default_value;
     }
 
     double SummaryState::get_conn_var(const std::string& well, const std::string& var, std::size_t global_index, double default_value) const
     {
-        if (this->has_conn_var(well, var, global_index))
-            return this->get_conn_var(well, var, global_index);
-        return default_value;
+        const auto handle = this->conn_var_handle(well, var, global_index);
+        return handle.has_value() ? this->get(*handle) : default_value;
     }
 
     double SummaryState::get_segment_var(const std::string& well,
@@ -374,20 +477,101 @@ namespace Opm
                                          const std::size_t  segment,
                                          const double       default_value) const
     {
-        auto varPos = this->segment_values.find(var);
-        if (varPos == this->segment_values.end()) {
-            return default_value;
-        }
+        const auto handle = this->segment_var_handle(well, var, segment);
+        return handle.has_value() ? this->get(*handle) : default_value;
+    }
 
-        auto wellPos = varPos->second.find(well);
-        if (wellPos == varPos->second.end()) {
-            return default_value;
-        }
+    std::optional<SummaryState::Handle> SummaryState::handle(const std::string& key) const
+    {
+        const auto iter = this->values.find(key);
+        if (iter == this->values.end())
+            return {};
+
+        return Handle { iter->second };
+    }
+
+    std::optional<SummaryState::Handle> SummaryState::well_var_handle(const std::string& well, const std::string& var) const
+    {
+        const auto var_iter = this->well_values.find(var);
+        if (var_iter == this->well_values.end())
+            return {};
+
+        const auto iter = var_iter->second.find(well);
+        if (iter == var_iter->second.end())
+            return {};
+
+        return Handle { iter->second };
+    }
+
+    std::optional<SummaryState::Handle> SummaryState::group_var_handle(const std::string& group, const std::string& var) const
+    {
+        const auto var_iter = this->group_values.find(var);
+        if (var_iter == this->group_values.end())
+            return {};
+
+        const auto iter = var_iter->second.find(group);
+        if (iter == var_iter->second.end())
+            return {};
+
+        return Handle { iter->second };
+    }
+
+    std::optional<SummaryState::Handle> SummaryState::conn_var_handle(const std::string& well, const std::string& var, std::size_t global_index) const
+    {
+        const auto var_iter = this->conn_values.find(var);
+        if (var_iter == this->conn_values.end())
+            return {};
+
+        const auto well_iter = var_iter->second.find(well);
+        if (well_iter == var_iter->second.end())
+            return {};
+
+        const auto iter = well_iter->second.find(global_index);
+        if (iter == well_iter->second.end())
+            return {};
+
+        return Handle { iter->second };
+    }
+
+    std::optional<SummaryState::Handle> SummaryState::segment_var_handle(const std::string& well,
+                                                                         const std::string& var,
+                                                                         const std::size_t  segment) const
+    {
+        // Segment Values = [var][well][segment] -> slot
+
+        const auto var_iter = this->segment_values.find(var);
+        if (var_iter == this->segment_values.end())
+            return {};
+
+        const auto well_iter = var_iter->second.find(well);
+        if (well_iter == var_iter->second.end())
+            return {};
+
+        const auto iter = well_iter->second.find(segment);
+        if (iter == well_iter->second.end())
+            return {};
+
+        return Handle { iter->second };
+    }
+
+    void SummaryState::update(const Handle handle, const double value)
+    {
+        this->update_slot(handle.slot, value);
+    }
+
+    double SummaryState::get(const Handle handle) const
+    {
+        return this->m_values[handle.slot];
+    }
 
-        auto valPos = wellPos->second.find(segment);
-        return (valPos == wellPos->second.end())
-            ? default_value
-            : valPos->second;
+    const std::vector<double>& SummaryState::slot_values() const
+    {
+        return this->m_values;
+    }
+
+    std::uint64_t SummaryState::layout_id() const
+    {
+        return this->m_layout_id;
     }
 
     const std::vector<std::string>& SummaryState::wells() const
@@ -418,41 +602,101 @@ namespace Opm
         return var2_list(this->group_values, var);
     }
 
+    /*
+      The general values are replaced with the values in the buffer, while
+      the specialized values are replaced variable by variable. Slots which
+      are already present are kept, the slots of the values which are
+      dropped are released before the slots of the new values are added,
+      and the links from the specialized to the general values are restored
+      on the next update.
+    */
     void SummaryState::append(const SummaryState& buffer)
     {
         this->sim_start = buffer.sim_start;
         this->elapsed = buffer.elapsed;
-        this->values = buffer.values;
         this->well_names.reset();
         this->group_names.reset();
 
-        this->m_wells.insert(buffer.m_wells.begin(), buffer.m_wells.end());
-        for (const auto& [var, vals] : buffer.well_values) {
-            this->well_values.insert_or_assign(var, vals);
+        for (auto iter = this->values.begin(); iter != this->values.end(); ) {
+            if (buffer.values.count(iter->first) == 0) {
+                this->release_slot(iter->second);
+                iter = this->values.erase(iter);
+            }
+            else
+                ++iter;
         }
+        this->drop_stale_links();
+
+        for (const auto& [key, buffer_slot] : buffer.values)
+            this->m_values[this->key_slot(key)] = buffer.m_values[buffer_slot];
+
+        // Replaces the slot map with the slots in the buffer's slot map.
+        auto append_slots = [this, &buffer](auto& slots, const auto& buffer_slots, const std::string& var) {
+            for (auto iter = slots.begin(); iter != slots.end(); ) {
+                if (buffer_slots.count(iter->first) == 0) {
+                    this->release_slot(iter->second);
+                    iter = slots.erase(iter);
+                }
+                else
+                    ++iter;
+            }
+
+            for (const auto& [id, buffer_slot] : buffer_slots) {
+                auto [iter, inserted] = slots.try_emplace(id, no_link);
+                if (inserted)
+                    iter->second = this->add_slot(var);
+                this->m_values[iter->second] = buffer.m_values[buffer_slot];
+            }
+        };
+
+        // Releases the slots of the wells which are not in the buffer.
+        auto erase_wells = [this](auto& wells, const auto& buffer_wells) {
+            for (auto iter = wells.begin(); iter != wells.end(); ) {
+                if (buffer_wells.count(iter->first) == 0) {
+                    for (const auto& [_, slot] : iter->second) {
+                        (void)_;
+                        this->release_slot(slot);
+                    }
+                    iter = wells.erase(iter);
+                }
+                else
+                    ++iter;
+            }
+        };
+
+        this->m_wells.insert(buffer.m_wells.begin(), buffer.m_wells.end());
+        for (const auto& [var, buffer_slots] : buffer.well_values)
+            append_slots(this->well_values[var], buffer_slots, var);
 
         this->m_groups.insert(buffer.m_groups.begin(), buffer.m_groups.end());
-        for (const auto& [var, vals] : buffer.group_values) {
-            this->group_values.insert_or_assign(var, vals);
+        for (const auto& [var, buffer_slots] : buffer.group_values)
+            append_slots(this->group_values[var], buffer_slots, var);
+
+        for (const auto& [var, buffer_wells] : buffer.conn_values) {
+            auto& wells = this->conn_values[var];
+            erase_wells(wells, buffer_wells);
+            for (const auto& [well, buffer_slots] : buffer_wells)
+                append_slots(wells[well], buffer_slots, var);
         }
 
-        for (const auto& [var, vals] : buffer.conn_values) {
-            this->conn_values.insert_or_assign(var, vals);
+        for (const auto& [var, buffer_wells] : buffer.segment_values) {
+            auto& wells = this->segment_values[var];
+            erase_wells(wells, buffer_wells);
+            for (const auto& [well, buffer_slots] : buffer_wells)
+                append_slots(wells[well], buffer_slots, var);
         }
 
-        for (const auto& [var, vals] : buffer.segment_values) {
-            this->segment_values.insert_or_assign(var, vals);
-        }
+        this->m_layout_id = next_layout_id();
     }
 
     SummaryState::const_iterator SummaryState::begin() const
     {
-        return this->values.begin();
+        return { this->values.begin(), this->m_values };
     }
 
     SummaryState::const_iterator SummaryState::end() const
     {
-        return this->values.end();
+        return { this->values.end(), this->m_values };
     }
 
     std::size_t SummaryState::num_wells() const
@@ -469,15 +713,15 @@ namespace Opm
     {
         return (this->sim_start == other.sim_start)
             && (this->elapsed == other.elapsed)
-            && (this->values == other.values)
-            && (this->well_values == other.well_values)
+            && equal_slots(this->m_values, this->values, other.m_values, other.values)
+            && equal_slots(this->m_values, this->well_values, other.m_values, other.well_values)
             && (this->m_wells == other.m_wells)
             && (this->wells() == other.wells())
-            && (this->group_values == other.group_values)
+            && equal_slots(this->m_values, this->group_values, other.m_values, other.group_values)
             && (this->m_groups == other.m_groups)
             && (this->groups() == other.groups())
-            && (this->conn_values == other.conn_values)
-            && (this->segment_values == other.segment_values);
+            && equal_slots(this->m_values, this->conn_values, other.m_values, other.conn_values)
+            && equal_slots(this->m_values, this->segment_values, other.m_values, other.segment_values);
     }
 
     SummaryState SummaryState::serializationTestObject()
@@ -485,35 +729,20 @@ namespace Opm
         auto st = SummaryState{TimeService::from_time_t(101)};
 
         st.elapsed = 1.0;
-        st.values = {{"test1", 2.0}};
-        st.well_values = {{"test2", {{"test3", 3.0}}}};
-        st.m_wells = {"test4"};
+        st.update("test1", 2.0);
+        st.update_well_var("test3", "test2", 3.0);
+        st.m_wells.insert("test4");
         st.well_names = {"test5"};
-        st.group_values = {{"test6", {{"test7", 4.0}}}},
-        st.m_groups = {"test7"};
+        st.update_group_var("test7", "test6", 4.0);
         st.group_names = {"test8"},
-        st.conn_values = {{"test9", {{"test10", {{5, 6.0}}}}}};
-
-        {
-            auto& sval = st.segment_values["SU1"];
-            sval.emplace("W1", std::unordered_map<std::size_t, double> {
-                    { std::size_t{ 1},  123.456   },
-                    { std::size_t{ 2},   17.29    },
-                    { std::size_t{10}, -  2.71828 },
-                });
-
-            sval.emplace("W6", std::unordered_map<std::size_t, double> {
-                    { std::size_t{ 7}, 3.1415926535 },
-                });
-        }
-
-        {
-            auto& sval = st.segment_values["SUVIS"];
-            sval.emplace("I2", std::unordered_map<std::size_t, double> {
-                    { std::size_t{17},  29.0   },
-                    { std::size_t{42}, - 1.618 },
-                });
-        }
+        st.update_conn_var("test10", "test9", 5, 6.0);
+
+        st.update_segment_var("W1", "SU1",  1, 123.456);
+        st.update_segment_var("W1", "SU1",  2, 17.29);
+        st.update_segment_var("W1", "SU1", 10, -2.71828);
+        st.update_segment_var("W6", "SU1",  7, 3.1415926535);
+        st.update_segment_var("I2", "SUVIS", 17, 29.0);
+        st.update_segment_var("I2", "SUVIS", 42, -1.618);
 
         return st;
     }
@@ -24,6 +24,7 @@
 
 #include <opm/input/eclipse/Schedule/UDQ/UDQASTNode.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQEnums.hpp>
+#include <opm/input/eclipse/Schedule/UDQ/UDQProgram.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQToken.hpp>
 
 #include <opm/input/eclipse/Parser/ErrorGuard.hpp>
@@ -35,6 +36,7 @@
 #include <cstddef>
 #include <cstring>
 #include <exception>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -266,6 +268,8 @@ UDQDefine::UDQDefine(const UDQParams&                udq_params,
                           this->m_tokens,
                           parseContext,
                           errors));
+
+    this->program.reset();
 }
 
 void UDQDefine::update_status(const UDQUpdate   update,
@@ -281,6 +285,7 @@ UDQDefine UDQDefine::serializationTestObject()
     result.m_keyword = "test1";
     result.m_tokens = {UDQToken::serializationTestObject()};
     result.ast = std::make_shared<UDQASTNode>(UDQASTNode::serializationTestObject());
+    result.program.reset();
     result.m_var_type = UDQVarType::SEGMENT_VAR;
     result.string_data = "test2";
     result.m_location = KeywordLocation{"KEYWOR", "file", 100};
@@ -298,7 +303,18 @@ UDQSet UDQDefine::eval(const UDQContext& context) const
 {
     std::optional<UDQSet> res;
     try {
-        res = this->ast->eval(this->m_var_type, context);
+        // The expression is compiled on first use.  Expressions which
+        // cannot be handled by the compiled program are evaluated by the
+        // expression tree.
+        if (this->program == nullptr) {
+            this->program = std::make_shared<UDQProgram>(*this->ast, this->m_var_type);
+        }
+
+        res = this->program->eval(context);
+        if (! res.has_value()) {
+            res = this->ast->eval(this->m_var_type, context);
+        }
+
         res->name(this->m_keyword);
 
         if (!dynamic_type_check(this->var_type(), res->var_type())) {
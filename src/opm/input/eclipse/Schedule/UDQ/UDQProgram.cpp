@@ -0,0 +1,835 @@
+/*
+  Copyright 2026 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/input/eclipse/Schedule/UDQ/UDQProgram.hpp>
+
+#include <opm/input/eclipse/Schedule/UDQ/UDQASTNode.hpp>
+#include <opm/input/eclipse/Schedule/UDQ/UDQContext.hpp>
+#include <opm/input/eclipse/Schedule/UDQ/UDQEnums.hpp>
+#include <opm/input/eclipse/Schedule/UDQ/UDQFunctionTable.hpp>
+#include <opm/input/eclipse/Schedule/UDQ/UDQParams.hpp>
+#include <opm/input/eclipse/Schedule/UDQ/UDQSet.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+// Thrown when the compiled program cannot reproduce the behaviour of the
+// expression tree; the expression is then evaluated by the tree instead.
+class Unsupported : public std::runtime_error
+{
+public:
+    Unsupported()
+        : std::runtime_error("Unsupported UDQ program state")
+    {}
+};
+
+struct Column
+{
+    Opm::UDQVarType var_type = Opm::UDQVarType::NONE;
+    std::vector<double> values{};
+
+    // One byte per element rather than a packed bitmask, so that the
+    // elementwise kernels can be vectorized.
+    std::vector<unsigned char> defined{};
+
+    Column() = default;
+
+    Column(const Opm::UDQVarType type, const std::size_t size)
+        : var_type(type)
+        , values(size, 0.0)
+        , defined(size, 0)
+    {}
+
+    std::size_t size() const
+    {
+        return this->values.size();
+    }
+
+    void assign(const std::size_t index, const double value)
+    {
+        const bool finite = std::isfinite(value);
+        this->values[index] = finite ? value : 0.0;
+        this->defined[index] = finite;
+    }
+
+    void assign(const std::size_t index, const std::optional<double>& value)
+    {
+        if (value.has_value()) {
+            this->assign(index, *value);
+        }
+        else {
+            this->values[index] = 0.0;
+            this->defined[index] = 0;
+        }
+    }
+
+    std::vector<double> defined_values() const
+    {
+        std::vector<double> dv;
+        for (std::size_t index = 0; index < this->size(); ++index) {
+            if (this->defined[index]) {
+                dv.push_back(this->values[index]);
+            }
+        }
+
+        return dv;
+    }
+};
+
+bool is_scalar(const Column& column)
+{
+    return (column.var_type == Opm::UDQVarType::SCALAR)
+        || (column.var_type == Opm::UDQVarType::FIELD_VAR);
+}
+
+bool is_set(const Column& column)
+{
+    return (column.var_type == Opm::UDQVarType::WELL_VAR)
+        || (column.var_type == Opm::UDQVarType::GROUP_VAR);
+}
+
+bool has_wildcard(const std::string& name)
+{
+    return name.find_first_of("*?[\\") != std::string::npos;
+}
+
+Column scalar_column(const std::optional<double>& value)
+{
+    Column column(Opm::UDQVarType::SCALAR, 1);
+    column.assign(0, value);
+    return column;
+}
+
+// Elementwise kernel, the result is defined where both arguments are
+// defined and the result is finite.
+template <typename Op>
+void elementwise(Column& lhs, const Column& rhs, Op&& op)
+{
+    if (lhs.size() != rhs.size()) {
+        throw Unsupported{};
+    }
+
+    for (std::size_t index = 0; index < lhs.size(); ++index) {
+        const double value = op(lhs.values[index], rhs.values[index]);
+        const bool defined = lhs.defined[index] && rhs.defined[index] && std::isfinite(value);
+        lhs.values[index] = defined ? value : 0.0;
+        lhs.defined[index] = defined;
+    }
+}
+
+// Elementwise kernel applied to the defined elements only.
+template <typename Op>
+void transform_defined(Column& column, Op&& op)
+{
+    for (std::size_t index = 0; index < column.size(); ++index) {
+        const double value = op(column.values[index]);
+        const bool defined = column.defined[index] && std::isfinite(value);
+        column.values[index] = defined ? value : 0.0;
+        column.defined[index] = defined;
+    }
+}
+
+// Promotion of scalar operand to well/group set, as in udq_cast() for
+// UDQSet.
+void cast(Column& lhs, Column& rhs)
+{
+    if ((lhs.var_type == rhs.var_type) || (is_scalar(lhs) && is_scalar(rhs))) {
+        return;
+    }
+
+    auto promote = [](Column& scalar, const Column& other)
+    {
+        if (!scalar.defined[0]) {
+            throw Unsupported{};
+        }
+
+        const double value = scalar.values[0];
+        scalar.var_type = other.var_type;
+        scalar.values.assign(other.size(), value);
+        scalar.defined.assign(other.size(), 1);
+    };
+
+    if (is_scalar(lhs) && is_set(rhs)) {
+        promote(lhs, rhs);
+    }
+    else if (is_scalar(rhs) && is_set(lhs)) {
+        promote(rhs, lhs);
+    }
+    else {
+        throw Unsupported{};
+    }
+}
+
+void subtract(Column& lhs, Column rhs)
+{
+    cast(lhs, rhs);
+    elementwise(lhs, rhs, std::minus<double>{});
+}
+
+// Relative comparison used by ==, !=, <= and >=.
+template <typename Cmp>
+void compare_relative(Column& lhs, Column rhs, Cmp&& cmp)
+{
+    cast(lhs, rhs);
+
+    Column diff = lhs;
+    elementwise(diff, rhs, std::minus<double>{});
+
+    for (std::size_t index = 0; index < diff.size(); ++index) {
+        if (!diff.defined[index]) {
+            continue;
+        }
+
+        if (diff.values[index] == 0) {
+            diff.values[index] = 1;
+            continue;
+        }
+
+        const double rel_diff = diff.values[index] / lhs.values[index];
+        if (!std::isfinite(rel_diff)) {
+            throw Unsupported{};
+        }
+
+        diff.values[index] = cmp(rel_diff);
+    }
+
+    lhs = std::move(diff);
+}
+
+// The UADD, UMUL, UMIN and UMAX functions; the result is defined where at
+// least one of the arguments is defined.
+template <typename Op>
+void union_op(Column& lhs, const Column& rhs, Op&& op)
+{
+    if (lhs.size() != rhs.size()) {
+        throw Unsupported{};
+    }
+
+    for (std::size_t index = 0; index < lhs.size(); ++index) {
+        if (lhs.defined[index] && rhs.defined[index]) {
+            lhs.assign(index, op(rhs.values[index], lhs.values[index]));
+        }
+        else if (rhs.defined[index]) {
+            lhs.values[index] = rhs.values[index];
+            lhs.defined[index] = 1;
+        }
+    }
+}
+
+void binary_function(const Opm::UDQTokenType func, const double eps, Column& lhs, Column rhs)
+{
+    using TT = Opm::UDQTokenType;
+
+    switch (func) {
+    case TT::binary_op_add:
+        cast(lhs, rhs);
+        elementwise(lhs, rhs, std::plus<double>{});
+        return;
+
+    case TT::binary_op_sub:
+        subtract(lhs, std::move(rhs));
+        return;
+
+    case TT::binary_op_mul:
+        cast(lhs, rhs);
+        elementwise(lhs, rhs, std::multiplies<double>{});
+        return;
+
+    case TT::binary_op_div:
+        cast(lhs, rhs);
+        elementwise(lhs, rhs, std::divides<double>{});
+        return;
+
+    case TT::binary_op_pow:
+        // No promotion, and undefined exponents leave the base unchanged.
+        if (rhs.size() < lhs.size()) {
+            throw Unsupported{};
+        }
+
+        for (std::size_t index = 0; index < lhs.size(); ++index) {
+            if (lhs.defined[index] && rhs.defined[index]) {
+                lhs.assign(index, std::pow(lhs.values[index], rhs.values[index]));
+            }
+        }
+        return;
+
+    case TT::binary_op_uadd:
+        union_op(lhs, rhs, std::plus<double>{});
+        return;
+
+    case TT::binary_op_umul:
+        union_op(lhs, rhs, std::multiplies<double>{});
+        return;
+
+    case TT::binary_op_umin:
+        union_op(lhs, rhs, [](const double x, const double y) { return std::min(x, y); });
+        return;
+
+    case TT::binary_op_umax:
+        union_op(lhs, rhs, [](const double x, const double y) { return std::max(x, y); });
+        return;
+
+    case TT::binary_cmp_gt:
+        subtract(lhs, std::move(rhs));
+        for (std::size_t index = 0; index < lhs.size(); ++index) {
+            lhs.values[index] = lhs.defined[index] && (lhs.values[index] > 0.0);
+        }
+        return;
+
+    case TT::binary_cmp_lt:
+        subtract(lhs, std::move(rhs));
+        for (std::size_t index = 0; index < lhs.size(); ++index) {
+            lhs.values[index] = lhs.defined[index] && (lhs.values[index] < 0.0);
+        }
+        return;
+
+    case TT::binary_cmp_le:
+        compare_relative(lhs, std::move(rhs), [eps](const double rel) { return ! (rel > eps); });
+        return;
+
+    case TT::binary_cmp_ge:
+        compare_relative(lhs, std::move(rhs), [eps](const double rel) { return ! (rel < -eps); });
+        return;
+
+    case TT::binary_cmp_eq:
+        compare_relative(lhs, std::move(rhs), [eps](const double rel) { return ! (std::fabs(rel) > eps); });
+        return;
+
+    case TT::binary_cmp_ne:
+        compare_relative(lhs, std::move(rhs), [eps](const double rel) { return ! (std::fabs(rel) > eps); });
+        for (std::size_t index = 0; index < lhs.size(); ++index) {
+            if (lhs.defined[index]) {
+                lhs.values[index] = 1 - lhs.values[index];
+            }
+        }
+        return;
+
+    default:
+        throw Unsupported{};
+    }
+}
+
+void sort_function(Column& arg, const bool ascending)
+{
+    // Same node order and sort algorithm as UDQUnaryElementalFunction::SORT,
+    // so that ties are ranked identically.
+    auto sort_nodes = std::vector<std::pair<std::size_t, double>> {};
+    for (std::size_t index = 0; index < arg.size(); ++index) {
+        if (arg.defined[index]) {
+            sort_nodes.emplace_back(index, ascending ? arg.values[index] : -arg.values[index]);
+        }
+    }
+
+    std::sort(sort_nodes.begin(), sort_nodes.end(),
+              [](const auto& s1, const auto& s2)
+              {
+                  return s1.second < s2.second;
+              });
+
+    double sort_value = 1;
+    for (const auto& node : sort_nodes) {
+        arg.values[node.first] = sort_value;
+        sort_value += 1;
+    }
+}
+
+void unary_function(const Opm::UDQTokenType func, Column& arg)
+{
+    using TT = Opm::UDQTokenType;
+
+    switch (func) {
+    case TT::elemental_func_abs:
+        transform_defined(arg, [](const double x) { return std::fabs(x); });
+        return;
+
+    case TT::elemental_func_def:
+        transform_defined(arg, [](const double) { return 1.0; });
+        return;
+
+    case TT::elemental_func_exp:
+        transform_defined(arg, [](const double x) { return std::exp(x); });
+        return;
+
+    case TT::elemental_func_nint:
+        transform_defined(arg, [](const double x) { return std::nearbyint(x); });
+        return;
+
+    case TT::elemental_func_idv:
+        for (std::size_t index = 0; index < arg.size(); ++index) {
+            arg.values[index] = arg.defined[index] ? 1.0 : 0.0;
+            arg.defined[index] = 1;
+        }
+        return;
+
+    case TT::elemental_func_undef:
+        // The result set has no type, as in UDQUnaryElementalFunction::UNDEF.
+        arg.var_type = Opm::UDQVarType::NONE;
+        for (std::size_t index = 0; index < arg.size(); ++index) {
+            arg.values[index] = arg.defined[index] ? 0.0 : 1.0;
+            arg.defined[index] = !arg.defined[index];
+        }
+        return;
+
+    case TT::elemental_func_ln:
+    case TT::elemental_func_log:
+        for (std::size_t index = 0; index < arg.size(); ++index) {
+            if (arg.defined[index] && !(arg.values[index] > 0.0)) {
+                throw Unsupported{};
+            }
+        }
+
+        if (func == TT::elemental_func_ln) {
+            transform_defined(arg, [](const double x) { return std::log(x); });
+        }
+        else {
+            transform_defined(arg, [](const double x) { return std::log10(x); });
+        }
+        return;
+
+    case TT::elemental_func_sorta:
+        sort_function(arg, true);
+        return;
+
+    case TT::elemental_func_sortd:
+        sort_function(arg, false);
+        return;
+
+    default:
+        throw Unsupported{};
+    }
+}
+
+// The reductions use the same accumulation order as UDQScalarFunction, so
+// that the results are bitwise identical.
+Column scalar_function(const Opm::UDQTokenType func, const Column& arg)
+{
+    using TT = Opm::UDQTokenType;
+
+    const auto dv = arg.defined_values();
+    if (dv.empty()) {
+        return {};
+    }
+
+    switch (func) {
+    case TT::scalar_func_sum:
+        return scalar_column(std::accumulate(dv.begin(), dv.end(), 0.0));
+
+    case TT::scalar_func_prod:
+        return scalar_column(std::accumulate(dv.begin(), dv.end(), 1.0, std::multiplies<double>{}));
+
+    case TT::scalar_func_min:
+        return scalar_column(*std::min_element(dv.begin(), dv.end()));
+
+    case TT::scalar_func_max:
+        return scalar_column(*std::max_element(dv.begin(), dv.end()));
+
+    case TT::scalar_func_avea:
+        return scalar_column(std::accumulate(dv.begin(), dv.end(), 0.0) / dv.size());
+
+    case TT::scalar_func_aveg: {
+        if (std::any_of(dv.begin(), dv.end(), [](const double x) { return x <= 0; })) {
+            throw Unsupported{};
+        }
+
+        const double log_mean = std::accumulate(dv.begin(), dv.end(), 0.0,
+                                                [](double x, double y) { return x + std::log(y); }) / dv.size();
+        return scalar_column(std::exp(log_mean));
+    }
+
+    case TT::scalar_func_aveh:
+        return scalar_column(dv.size() / std::accumulate(dv.begin(), dv.end(), 0.0,
+                                                         [](double x, double y) { return x + 1.0/y; }));
+
+    case TT::scalar_func_normi:
+        return scalar_column(std::accumulate(dv.begin(), dv.end(), 0.0,
+                                             [](double x, double y) { return std::max(x, std::fabs(y)); }));
+
+    case TT::scalar_func_norm1:
+        return scalar_column(std::accumulate(dv.begin(), dv.end(), 0.0,
+                                             [](double x, double y) { return x + std::fabs(y); }));
+
+    case TT::scalar_func_norm2:
+        return scalar_column(std::sqrt(std::inner_product(dv.begin(), dv.end(), dv.begin(), 0.0)));
+
+    default:
+        throw Unsupported{};
+    }
+}
+
+class NameCache
+{
+public:
+    explicit NameCache(const Opm::UDQContext& context)
+        : context_(context)
+    {}
+
+    const std::vector<std::string>& wells()
+    {
+        if (!this->wells_.has_value()) {
+            this->wells_ = this->context_.wells();
+        }
+
+        return *this->wells_;
+    }
+
+    const std::vector<std::string>& groups()
+    {
+        if (!this->groups_.has_value()) {
+            this->groups_ = this->context_.groups();
+        }
+
+        return *this->groups_;
+    }
+
+    std::size_t well_index(const std::string& well)
+    {
+        if (this->well_index_.empty()) {
+            const auto& wells = this->wells();
+            for (std::size_t index = 0; index < wells.size(); ++index) {
+                this->well_index_.emplace(wells[index], index);
+            }
+        }
+
+        const auto pos = this->well_index_.find(well);
+        if (pos == this->well_index_.end()) {
+            throw Unsupported{};
+        }
+
+        return pos->second;
+    }
+
+private:
+    const Opm::UDQContext& context_;
+    std::optional<std::vector<std::string>> wells_{};
+    std::optional<std::vector<std::string>> groups_{};
+    std::unordered_map<std::string, std::size_t> well_index_{};
+};
+
+}
+
+namespace Opm {
+
+UDQProgram::UDQProgram(const UDQASTNode& ast, const UDQVarType target_type)
+    : m_target_type(target_type)
+{
+    this->m_valid = this->compile(ast);
+    if (! this->m_valid) {
+        this->m_code.clear();
+    }
+}
+
+bool UDQProgram::valid() const
+{
+    return this->m_valid;
+}
+
+std::size_t UDQProgram::size() const
+{
+    return this->m_code.size();
+}
+
+bool UDQProgram::compile(const UDQASTNode& node)
+{
+    Instruction instruction { OpCode::Number, node.type };
+
+    if (node.type == UDQTokenType::number) {
+        if (! std::holds_alternative<double>(node.value)) {
+            return false;
+        }
+
+        if ((this->m_target_type != UDQVarType::WELL_VAR) &&
+            (this->m_target_type != UDQVarType::GROUP_VAR) &&
+            (this->m_target_type != UDQVarType::SCALAR) &&
+            (this->m_target_type != UDQVarType::FIELD_VAR))
+        {
+            return false;
+        }
+
+        instruction.value = std::get<double>(node.value);
+    }
+    else {
+        if (! std::holds_alternative<std::string>(node.value)) {
+            return false;
+        }
+
+        instruction.keyword = std::get<std::string>(node.value);
+
+        if (node.type == UDQTokenType::ecl_expr) {
+            const auto data_type = UDQ::targetType(instruction.keyword);
+            const bool has_selector = ! node.selector.empty();
+            if (has_selector) {
+                instruction.selector = node.selector.front();
+            }
+
+            const bool scalar_selector = has_selector &&
+                (instruction.selector.find('*') == std::string::npos);
+
+            if (data_type == UDQVarType::WELL_VAR) {
+                instruction.op = !has_selector ? OpCode::WellVariable
+                    : (scalar_selector ? OpCode::WellScalar : OpCode::WellVariableSet);
+            }
+            else if (data_type == UDQVarType::GROUP_VAR) {
+                if (has_selector && !scalar_selector) {
+                    return false;
+                }
+
+                instruction.op = has_selector ? OpCode::GroupScalar : OpCode::GroupVariable;
+            }
+            else if (data_type == UDQVarType::FIELD_VAR) {
+                instruction.op = OpCode::FieldVariable;
+            }
+            else {
+                instruction.op = OpCode::Scalar;
+            }
+        }
+        else if (UDQ::scalarFunc(node.type)) {
+            if (!node.left || !this->compile(*node.left)) {
+                return false;
+            }
+
+            instruction.op = OpCode::ScalarFunction;
+        }
+        else if (UDQ::elementalUnaryFunc(node.type)) {
+            // The random number functions draw from the generators in the
+            // function table, and are always evaluated by the tree.
+            if ((node.type == UDQTokenType::elemental_func_randn) ||
+                (node.type == UDQTokenType::elemental_func_randu) ||
+                (node.type == UDQTokenType::elemental_func_rrandn) ||
+                (node.type == UDQTokenType::elemental_func_rrandu))
+            {
+                return false;
+            }
+
+            if (!node.left || !this->compile(*node.left)) {
+                return false;
+            }
+
+            instruction.op = OpCode::UnaryFunction;
+        }
+        else if (UDQ::binaryFunc(node.type)) {
+            if (!node.left || !node.right ||
+                !this->compile(*node.left) ||
+                !this->compile(*node.right))
+            {
+                return false;
+            }
+
+            instruction.op = OpCode::BinaryFunction;
+        }
+        else {
+            return false;
+        }
+    }
+
+    this->m_code.push_back(std::move(instruction));
+
+    if (node.sign != 1.0) {
+        this->m_code.push_back(Instruction { OpCode::Scale, UDQTokenType::error, node.sign });
+    }
+
+    return true;
+}
+
+std::optional<UDQSet> UDQProgram::eval(const UDQContext& context) const
+{
+    if (! this->m_valid) {
+        return std::nullopt;
+    }
+
+    // Any exception means that the tree interpreter should evaluate the
+    // expression; it will then produce the appropriate diagnostic.
+    try {
+        NameCache names(context);
+        const auto& udqft = context.function_table();
+        const double eps = udqft.getParams().cmpEpsilon();
+
+        std::vector<Column> stack;
+        auto pop = [&stack]()
+        {
+            if (stack.empty()) {
+                throw Unsupported{};
+            }
+
+            auto column = std::move(stack.back());
+            stack.pop_back();
+            return column;
+        };
+
+        for (const auto& instruction : this->m_code) {
+            switch (instruction.op) {
+            case OpCode::WellVariable: {
+                const auto& wells = names.wells();
+                Column column(UDQVarType::WELL_VAR, wells.size());
+                for (std::size_t index = 0; index < wells.size(); ++index) {
+                    column.assign(index, context.get_well_var(wells[index], instruction.keyword));
+                }
+                stack.push_back(std::move(column));
+                break;
+            }
+
+            case OpCode::WellVariableSet: {
+                Column column(UDQVarType::WELL_VAR, names.wells().size());
+                for (const auto& well : context.wells(instruction.selector)) {
+                    if (has_wildcard(well)) {
+                        throw Unsupported{};
+                    }
+
+                    column.assign(names.well_index(well), context.get_well_var(well, instruction.keyword));
+                }
+                stack.push_back(std::move(column));
+                break;
+            }
+
+            case OpCode::WellScalar:
+                stack.push_back(scalar_column(context.get_well_var(instruction.selector, instruction.keyword)));
+                break;
+
+            case OpCode::GroupVariable: {
+                const auto& groups = names.groups();
+                Column column(UDQVarType::GROUP_VAR, groups.size());
+                for (std::size_t index = 0; index < groups.size(); ++index) {
+                    column.assign(index, context.get_group_var(groups[index], instruction.keyword));
+                }
+                stack.push_back(std::move(column));
+                break;
+            }
+
+            case OpCode::GroupScalar:
+                stack.push_back(scalar_column(context.get_group_var(instruction.selector, instruction.keyword)));
+                break;
+
+            case OpCode::FieldVariable:
+                stack.push_back(scalar_column(context.get(instruction.keyword)));
+                break;
+
+            case OpCode::Scalar: {
+                const auto value = context.get(instruction.keyword);
+                if (! value.has_value()) {
+                    throw Unsupported{};
+                }
+                stack.push_back(scalar_column(value));
+                break;
+            }
+
+            case OpCode::Number: {
+                std::size_t size = 1;
+                if (this->m_target_type == UDQVarType::WELL_VAR) {
+                    size = names.wells().size();
+                }
+                else if (this->m_target_type == UDQVarType::GROUP_VAR) {
+                    size = names.groups().size();
+                }
+
+                Column column(this->m_target_type, size);
+                for (std::size_t index = 0; index < size; ++index) {
+                    column.assign(index, instruction.value);
+                }
+                stack.push_back(std::move(column));
+                break;
+            }
+
+            case OpCode::Scale: {
+                const double factor = instruction.value;
+                transform_defined(stack.back(), [factor](const double x) { return x * factor; });
+                break;
+            }
+
+            case OpCode::ScalarFunction:
+                if (! udqft.has_function(instruction.keyword)) {
+                    throw Unsupported{};
+                }
+                stack.push_back(scalar_function(instruction.func, pop()));
+                break;
+
+            case OpCode::UnaryFunction:
+                if (! udqft.has_function(instruction.keyword) || stack.empty()) {
+                    throw Unsupported{};
+                }
+                unary_function(instruction.func, stack.back());
+                break;
+
+            case OpCode::BinaryFunction: {
+                if (! udqft.has_function(instruction.keyword)) {
+                    throw Unsupported{};
+                }
+                auto rhs = pop();
+                auto lhs = pop();
+                binary_function(instruction.func, eps, lhs, std::move(rhs));
+                stack.push_back(std::move(lhs));
+                break;
+            }
+            }
+        }
+
+        if (stack.size() != 1) {
+            return std::nullopt;
+        }
+
+        const auto& result = stack.back();
+        auto set = [&result, &names]() -> UDQSet
+        {
+            switch (result.var_type) {
+            case UDQVarType::WELL_VAR:
+                return UDQSet::wells("", names.wells());
+
+            case UDQVarType::GROUP_VAR:
+                return UDQSet::groups("", names.groups());
+
+            case UDQVarType::SCALAR:
+            case UDQVarType::FIELD_VAR:
+                return { "", result.var_type };
+
+            case UDQVarType::NONE:
+                return { "", result.size() };
+
+            default:
+                throw Unsupported{};
+            }
+        }();
+
+        if (set.size() != result.size()) {
+            return std::nullopt;
+        }
+
+        for (std::size_t index = 0; index < result.size(); ++index) {
+            if (result.defined[index]) {
+                set.assign(index, result.values[index]);
+            }
+        }
+
+        return set;
+    }
+    catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+} // namespace Opm
@@ -288,8 +288,9 @@ std::size_t UDQSet::size() const
 void UDQSet::assign(const std::string& wgname, const double value)
 {
     bool assigned = false;
+    const ShellPattern pattern(wgname);
     for (auto& udq_value : this->values) {
-        if (shmatch(wgname, udq_value.wgname())) {
+        if (pattern.match(udq_value.wgname())) {
             udq_value.assign(value);
             assigned = true;
         }
@@ -311,8 +312,9 @@ void UDQSet::assign(const std::string&           wgname,
                     const std::optional<double>& value)
 {
     bool assigned = false;
+    const ShellPattern pattern(wgname);
     for (auto& udq_value : this->values) {
-        if (shmatch(wgname, udq_value.wgname())) {
+        if (pattern.match(udq_value.wgname())) {
             udq_value.assign(value);
             assigned = true;
         }
@@ -330,9 +332,10 @@ void UDQSet::assign(const std::string&           wgname,
                     const std::optional<double>& value)
 {
     auto assigned = false;
+    const ShellPattern pattern(wgname);
 
     for (auto& udq : this->values) {
-        if ((udq.number() == number) && shmatch(wgname, udq.wgname())) {
+        if ((udq.number() == number) && pattern.match(udq.wgname())) {
             udq.assign(value);
             assigned = true;
         }
@@ -19,14 +19,88 @@
 
 #include <opm/input/eclipse/Schedule/Well/NameOrder.hpp>
 
+#include <opm/common/utility/shmatch.hpp>
+
 #include <algorithm>
 #include <cstddef>
 #include <initializer_list>
+#include <numeric>
 #include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+namespace {
+
+// The sorted index holds the positions in the name list in lexicographical
+// order of the names.
+
+using SortedIndex = std::vector<std::size_t>;
+
+SortedIndex::const_iterator
+lower_bound(const std::vector<std::string>& names, const SortedIndex& index, const std::string& name)
+{
+    return std::lower_bound(index.begin(), index.end(), name,
+                            [&names](const std::size_t i, const std::string& n)
+                            { return names[i] < n; });
+}
+
+void build_index(const std::vector<std::string>& names, SortedIndex& index)
+{
+    index.resize(names.size());
+    std::iota(index.begin(), index.end(), std::size_t{0});
+    std::sort(index.begin(), index.end(),
+              [&names](const std::size_t i1, const std::size_t i2)
+              { return names[i1] < names[i2]; });
+}
+
+// The name must already have been added to the name list.
+void add_to_index(const std::vector<std::string>& names, SortedIndex& index, const std::size_t name_index)
+{
+    index.insert(lower_bound(names, index, names[name_index]), name_index);
+}
+
+bool has_name(const std::vector<std::string>& names, const SortedIndex& index, const std::string& name)
+{
+    const auto pos = lower_bound(names, index, name);
+    return (pos != index.end()) && (names[*pos] == name);
+}
+
+// Only the names starting with the literal prefix of the pattern are tested;
+// the result is in the order of the name list.
+std::vector<std::string>
+match_names(const std::vector<std::string>& names, const SortedIndex& index, const Opm::ShellPattern& pattern)
+{
+    const auto& prefix = pattern.literalPrefix();
+    if (pattern.isLiteral()) {
+        if (has_name(names, index, prefix))
+            return { prefix };
+
+        return {};
+    }
+
+    std::vector<std::size_t> matches;
+    for (auto pos = lower_bound(names, index, prefix); pos != index.end(); ++pos) {
+        const auto& name = names[*pos];
+        if (name.compare(0, prefix.size(), prefix) != 0)
+            break;
+
+        if (pattern.match(name))
+            matches.push_back(*pos);
+    }
+
+    std::sort(matches.begin(), matches.end());
+
+    std::vector<std::string> matching_names;
+    matching_names.reserve(matches.size());
+    for (const auto& name_index : matches)
+        matching_names.push_back(names[name_index]);
+
+    return matching_names;
+}
+
+}
+
 namespace Opm {
 
 void NameOrder::add(const std::string& name)
@@ -36,9 +110,15 @@ void NameOrder::add(const std::string& name)
         std::size_t insert_index = this->m_name_list.size();
         this->m_index_map.emplace( name, insert_index );
         this->m_name_list.push_back( name );
+        add_to_index(this->m_name_list, this->m_sorted_index, insert_index);
     }
 }
 
+void NameOrder::build_sorted_index()
+{
+    build_index(this->m_name_list, this->m_sorted_index);
+}
+
 NameOrder::NameOrder(const std::vector<std::string>& names)
 {
     for (const auto& w : names)
@@ -61,6 +141,11 @@ const std::vector<std::string>& NameOrder::names() const
     return this->m_name_list;
 }
 
+std::vector<std::string> NameOrder::names(const ShellPattern& pattern) const
+{
+    return match_names(this->m_name_list, this->m_sorted_index, pattern);
+}
+
 std::vector<std::string>
 NameOrder::sort(std::vector<std::string> names) const
 {
@@ -118,18 +203,20 @@ GroupOrder::GroupOrder(std::size_t max_groups)
 
 void GroupOrder::add(const std::string& gname)
 {
-    auto iter = std::find(this->m_name_list.begin(),
-                          this->m_name_list.end(), gname);
-    if (iter == this->m_name_list.end()) {
+    if (! this->has(gname)) {
         this->m_name_list.push_back(gname);
+        add_to_index(this->m_name_list, this->m_sorted_index, this->m_name_list.size() - 1);
     }
 }
 
+void GroupOrder::build_sorted_index()
+{
+    build_index(this->m_name_list, this->m_sorted_index);
+}
+
 bool GroupOrder::has(const std::string& gname) const
 {
-    auto iter = std::find(this->m_name_list.begin(),
-                          this->m_name_list.end(), gname);
-    return iter != this->m_name_list.end();
+    return has_name(this->m_name_list, this->m_sorted_index, gname);
 }
 
 const std::vector<std::string>& GroupOrder::names() const
@@ -137,6 +224,11 @@ const std::vector<std::string>& GroupOrder::names() const
     return this->m_name_list;
 }
 
+std::vector<std::string> GroupOrder::names(const ShellPattern& pattern) const
+{
+    return match_names(this->m_name_list, this->m_sorted_index, pattern);
+}
+
 GroupOrder GroupOrder::serializationTestObject()
 {
     GroupOrder go(123);
@@ -65,14 +65,8 @@ std::vector<std::string> WellMatcher::wells(const std::string& pattern) const {
 
     // Normal pattern matching
     auto star_pos = pattern.find('*');
-    if (star_pos != std::string::npos) {
-        std::vector<std::string> names;
-        for (const auto& wname : this->m_well_order) {
-            if (shmatch(pattern, wname))
-                names.push_back(wname);
-        }
-        return names;
-    }
+    if (star_pos != std::string::npos)
+        return this->m_well_order.names(ShellPattern(pattern));
 
     if (this->m_well_order.has(pattern))
         return { pattern };
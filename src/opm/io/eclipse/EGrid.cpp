@@ -32,6 +32,103 @@
 #include <numeric>
 #include <string>
 #include <stdexcept>
+#include <utility>
+
+namespace {
+
+// number of rows of cells in a tile of the geometry cache
+constexpr int geometry_tile_rows = 8;
+
+// Reads num elements from element from of the REAL array with data at
+// arr_pos in an unformatted file.
+std::vector<float> readBinaryRealSlice(std::fstream& fileH, uint64_t arr_pos, uint64_t from, uint64_t num)
+{
+    std::vector<float> result(num);
+    uint64_t n = 0;
+
+    while (n < num) {
+        const uint64_t block = (from + n) / Opm::EclIO::MaxNumBlockReal;
+        const uint64_t in_block = (from + n) % Opm::EclIO::MaxNumBlockReal;
+        const uint64_t count = std::min(num - n, Opm::EclIO::MaxNumBlockReal - in_block);
+
+        const uint64_t pos = arr_pos + block * (Opm::EclIO::MaxBlockSizeReal + 8) + 4 + in_block * Opm::EclIO::sizeOfReal;
+
+        fileH.seekg(static_cast<std::streamoff>(pos), std::ios_base::beg);
+        fileH.read(reinterpret_cast<char*>(result.data() + n), count * Opm::EclIO::sizeOfReal);
+
+        n += count;
+    }
+
+    if (!fileH)
+        throw std::runtime_error("Error reading grid geometry from EGrid file");
+
+    for (auto& value : result)
+        value = Opm::EclIO::flipEndianFloat(value);
+
+    return result;
+}
+
+// Corners of a cell from its four pillars and eight depths, see EGrid::getCellCorners()
+void cell_corners(const std::array<const float*, 4>& pillars, bool radial, const std::array<double,8>& Z,
+                  std::array<double,8>& X, std::array<double,8>& Y)
+{
+    for (int  n = 0; n < 4; n++) {
+        const float* pillar = pillars[n];
+
+        double xt;
+        double yt;
+        double xb;
+        double yb;
+
+        double zt = pillar[2];
+        double zb = pillar[5];
+
+        if (radial) {
+            xt = pillar[0] * cos(pillar[1] / 180.0 * M_PI);
+            yt = pillar[0] * sin(pillar[1] / 180.0 * M_PI);
+            xb = pillar[3] * cos(pillar[4] / 180.0 * M_PI);
+            yb = pillar[3] * sin(pillar[4] / 180.0 * M_PI);
+        } else {
+            xt = pillar[0];
+            yt = pillar[1];
+            xb = pillar[3];
+            yb = pillar[4];
+        }
+
+        X[n] = xt + (xb-xt) / (zt-zb) * (zt - Z[n]);
+        X[n+4] = xt + (xb-xt) / (zt-zb) * (zt-Z[n+4]);
+
+        Y[n] = yt+(yb-yt)/(zt-zb)*(zt-Z[n]);
+        Y[n+4] = yt+(yb-yt)/(zt-zb)*(zt-Z[n+4]);
+    }
+}
+
+// Corners of the top or bottom face of a cell, see EGrid::getXYZ_layer()
+void face_corners(const std::array<const float*, 4>& pillars, const std::array<double,4>& Z,
+                  std::array<double,4>& X, std::array<double,4>& Y)
+{
+    for (int  n = 0; n < 4; n++) {
+        const float* pillar = pillars[n];
+
+        double zt = pillar[2];
+        double zb = pillar[5];
+
+        double xt = pillar[0];
+        double yt = pillar[1];
+        double xb = pillar[3];
+        double yb = pillar[4];
+
+        if (zt == zb) {
+            X[n] = xt;
+            Y[n] = yt;
+        } else {
+            X[n] = xt + (xb-xt) / (zt-zb) * (zt - Z[n]);
+            Y[n] = yt+(yb-yt)/(zt-zb)*(zt-Z[n]);
+        }
+    }
+}
+
+}
 
 namespace Opm { namespace EclIO {
 
@@ -303,6 +400,16 @@ void EGrid::getCellCorners(const std::array<int, 3>& ijk,
                            std::array<double,8>& Y,
                            std::array<double,8>& Z)
 {
+    if (use_geometry_cache()) {
+        std::fstream fileH;
+        std::array<const float*, 4> pillars;
+
+        global_index(ijk[0], ijk[1], ijk[2]);
+        cached_cell_geometry(fileH, ijk, pillars, Z);
+        cell_corners(pillars, m_radial, Z, X, Y);
+        return;
+    }
+
     if (coord_array.empty())
         load_grid_data();
 
@@ -327,36 +434,165 @@ void EGrid::getCellCorners(const std::array<int, 3>& ijk,
     for (int n = 0; n< 8; n++)
         Z[n] = zcorn_array[zind[n]];
 
-    for (int  n = 0; n < 4; n++) {
-        double xt;
-        double yt;
-        double xb;
-        double yb;
+    std::array<const float*, 4> pillars;
 
-        double zt = coord_array[pind[n] + 2];
-        double zb = coord_array[pind[n] + 5];
+    for (int n = 0; n < 4; n++)
+        pillars[n] = coord_array.data() + pind[n];
 
-        if (m_radial) {
-            xt = coord_array[pind[n]] * cos(coord_array[pind[n] + 1] / 180.0 * M_PI);
-            yt = coord_array[pind[n]] * sin(coord_array[pind[n] + 1] / 180.0 * M_PI);
-            xb = coord_array[pind[n]+3] * cos(coord_array[pind[n] + 4] / 180.0 * M_PI);
-            yb = coord_array[pind[n]+3] * sin(coord_array[pind[n] + 4] / 180.0 * M_PI);
-        } else {
-            xt = coord_array[pind[n]];
-            yt = coord_array[pind[n] + 1];
-            xb = coord_array[pind[n] + 3];
-            yb = coord_array[pind[n] + 4];
-        }
+    cell_corners(pillars, m_radial, Z, X, Y);
+}
 
-        X[n] = xt + (xb-xt) / (zt-zb) * (zt - Z[n]);
-        X[n+4] = xt + (xb-xt) / (zt-zb) * (zt-Z[n+4]);
 
-        Y[n] = yt+(yb-yt)/(zt-zb)*(zt-Z[n]);
-        Y[n+4] = yt+(yb-yt)/(zt-zb)*(zt-Z[n+4]);
+
+void EGrid::getCellCorners(const std::vector<std::array<int, 3>>& ijk_list,
+                           std::vector<std::array<double,8>>& X,
+                           std::vector<std::array<double,8>>& Y,
+                           std::vector<std::array<double,8>>& Z)
+{
+    X.resize(ijk_list.size());
+    Y.resize(ijk_list.size());
+    Z.resize(ijk_list.size());
+
+    if (!use_geometry_cache()) {
+        for (size_t n = 0; n < ijk_list.size(); n++)
+            getCellCorners(ijk_list[n], X[n], Y[n], Z[n]);
+
+        return;
     }
+
+    // cells are visited tile by tile, such that each tile is read once
+    // also when the cache is too small for all the tiles in the list
+    auto tile_order = [](const std::array<int, 3>& ijk)
+    {
+        return std::make_pair(ijk[2], ijk[1] / geometry_tile_rows);
+    };
+
+    std::vector<std::size_t> order(ijk_list.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&ijk_list, &tile_order](std::size_t a, std::size_t b)
+    {
+        return tile_order(ijk_list[a]) < tile_order(ijk_list[b]);
+    });
+
+    std::fstream fileH;
+    std::array<const float*, 4> pillars;
+
+    for (auto n : order) {
+        const auto& ijk = ijk_list[n];
+
+        global_index(ijk[0], ijk[1], ijk[2]);
+        cached_cell_geometry(fileH, ijk, pillars, Z[n]);
+        cell_corners(pillars, m_radial, Z[n], X[n], Y[n]);
+    }
+}
+
+
+void EGrid::setGeometryCacheSize(std::size_t max_bytes)
+{
+    m_cache_max_bytes = max_bytes;
+    evict_geometry_tiles(0);
 }
 
 
+bool EGrid::use_geometry_cache() const
+{
+    return (m_cache_max_bytes > 0) && !formatted && coord_array.empty();
+}
+
+
+void EGrid::evict_geometry_tiles(std::size_t num_keep)
+{
+    while ((m_geometry_tiles.size() > num_keep) && ((m_cache_bytes > m_cache_max_bytes) || (m_cache_max_bytes == 0))) {
+        auto it = std::min_element(m_geometry_tiles.begin(), m_geometry_tiles.end(),
+                                   [](const auto& t1, const auto& t2) { return t1.second.last_use < t2.second.last_use; });
+
+        m_cache_bytes -= it->second.data.size() * sizeof(float);
+        m_geometry_tiles.erase(it);
+    }
+}
+
+
+const std::vector<float>& EGrid::geometry_tile(std::fstream& fileH, bool zcorn, int layer, int tile)
+{
+    const int64_t num_tiles = (nijk[1] + geometry_tile_rows - 1) / geometry_tile_rows;
+    const int64_t key = zcorn ? layer * num_tiles + tile : -(tile + 1);
+
+    auto it = m_geometry_tiles.find(key);
+
+    if (it != m_geometry_tiles.end()) {
+        it->second.last_use = ++m_tile_use_count;
+        return it->second.data;
+    }
+
+    if (!fileH.is_open()) {
+        fileH.open(inputFileName, std::ios::in |  std::ios::binary);
+
+        if (!fileH)
+            throw std::runtime_error("Can not open EGrid file" + this->inputFilename);
+    }
+
+    const uint64_t nx = nijk[0];
+    const uint64_t ny = nijk[1];
+    const uint64_t j0 = tile * geometry_tile_rows;
+    const uint64_t j1 = std::min(j0 + geometry_tile_rows, ny);
+
+    std::vector<float> data;
+
+    if (zcorn) {
+        // rows j0 to j1 of the top and the bottom surface of the layer
+        const uint64_t nodes_pr_surf = nx * ny * 4;
+        const uint64_t from = nodes_pr_surf * 2 * layer + j0 * nx * 4;
+        const uint64_t num = (j1 - j0) * nx * 4;
+
+        data = readBinaryRealSlice(fileH, ifStreamPos[zcorn_array_index], from, num);
+        const auto bottom = readBinaryRealSlice(fileH, ifStreamPos[zcorn_array_index], from + nodes_pr_surf, num);
+        data.insert(data.end(), bottom.begin(), bottom.end());
+    } else {
+        // pillar rows j0 to j1, including j1
+        data = readBinaryRealSlice(fileH, ifStreamPos[coord_array_index], j0 * (nx + 1) * 6, (j1 - j0 + 1) * (nx + 1) * 6);
+    }
+
+    m_cache_bytes += data.size() * sizeof(float);
+
+    auto& entry = m_geometry_tiles[key];
+    entry.data = std::move(data);
+    entry.last_use = ++m_tile_use_count;
+
+    // the COORD and ZCORN tiles of the current cell are kept
+    evict_geometry_tiles(2);
+
+    return entry.data;
+}
+
+
+void EGrid::cached_cell_geometry(std::fstream& fileH, const std::array<int, 3>& ijk,
+                                 std::array<const float*, 4>& pillars, std::array<double,8>& Z)
+{
+    const int tile = ijk[1] / geometry_tile_rows;
+    const int row = ijk[1] - tile * geometry_tile_rows;
+    const std::size_t num_rows = std::min(geometry_tile_rows, nijk[1] - tile * geometry_tile_rows);
+
+    const auto& coord = geometry_tile(fileH, false, 0, tile);
+    const auto& zcorn = geometry_tile(fileH, true, ijk[2], tile);
+
+    const std::size_t nx = nijk[0];
+    const std::size_t p0 = (row * (nx + 1) + ijk[0]) * 6;
+
+    pillars[0] = coord.data() + p0;
+    pillars[1] = pillars[0] + 6;
+    pillars[2] = pillars[0] + (nx + 1) * 6;
+    pillars[3] = pillars[2] + 6;
+
+    const std::size_t z0 = row * nx * 4 + ijk[0] * 2;
+    const std::array<std::size_t, 4> zind = { z0, z0 + 1, z0 + nx * 2, z0 + nx * 2 + 1 };
+    const std::size_t nodes_pr_tile = num_rows * nx * 4;
+
+    for (int n = 0; n < 4; n++) {
+        Z[n] = zcorn[zind[n]];
+        Z[n + 4] = zcorn[zind[n] + nodes_pr_tile];
+    }
+}
+
 
 void EGrid::getCellCorners(int globindex, std::array<double,8>& X,
                            std::array<double,8>& Y, std::array<double,8>& Z)
@@ -382,6 +618,35 @@ std::vector<std::array<float, 3>> EGrid::getXYZ_layer(int layer, const std::arra
         throw std::invalid_argument("invalid box input, i1,i2,j1 or j2 out of valid range ");
     }
 
+    std::vector<std::array<float, 3>> xyz_vector;
+
+    if (use_geometry_cache()) {
+        std::fstream fileH;
+        std::array<const float*, 4> pillars;
+        std::array<double,8> Z8;
+        std::array<double,4> X;
+        std::array<double,4> Y;
+        std::array<double,4> Z;
+
+        xyz_vector.reserve(static_cast<std::size_t>(box[1] - box[0] + 1) * (box[3] - box[2] + 1) * 4);
+
+        for (int j = box[2]; j < (box[3] + 1); j++) {
+            for (int i = box[0]; i < (box[1] + 1); i++) {
+                cached_cell_geometry(fileH, {i, j, layer}, pillars, Z8);
+
+                for (size_t n = 0; n < 4; n++)
+                    Z[n] = bottom ? Z8[n + 4] : Z8[n];
+
+                face_corners(pillars, Z, X, Y);
+
+                for (size_t n = 0; n < 4; n++)
+                    xyz_vector.push_back({static_cast<float>(X[n]), static_cast<float>(Y[n]), static_cast<float>(Z[n])});
+            }
+        }
+
+        return xyz_vector;
+    }
+
     int nodes_pr_surf = nijk[0]*nijk[1]*4;
     int zcorn_offset = nodes_pr_surf * layer * 2;
 
@@ -391,8 +656,6 @@ std::vector<std::array<float, 3>> EGrid::getXYZ_layer(int layer, const std::arra
     std::vector<float> layer_zcorn;
     layer_zcorn.reserve(nodes_pr_surf);
 
-    std::vector<std::array<float, 3>> xyz_vector;
-
     if (coord_array.size() == 0)
         coord_array = getImpl(coord_array_index, REAL, real_array, "float");
 
@@ -446,11 +709,10 @@ std::vector<float> EGrid::get_zcorn_from_disk(int layer, bool bottom)
     if (formatted)
         throw std::invalid_argument("partial loading of zcorn arrays not possible when using formatted input");
 
-    std::vector<float> zcorn_layer;
     std::fstream fileH;
 
-    int nodes_pr_surf = nijk[0]*nijk[1]*4;
-    int zcorn_offset = nodes_pr_surf * layer * 2;
+    uint64_t nodes_pr_surf = static_cast<uint64_t>(nijk[0])*nijk[1]*4;
+    uint64_t zcorn_offset = nodes_pr_surf * layer * 2;
 
     if (bottom)
         zcorn_offset+=nodes_pr_surf;
@@ -460,72 +722,8 @@ std::vector<float> EGrid::get_zcorn_from_disk(int layer, bool bottom)
     if (!fileH)
         throw std::runtime_error("Can not open EGrid file" + this->inputFilename);
 
-    std::string arrName(8,' ');
-    eclArrType arrType;
-    int64_t num;
-    int sizeOfElement;
-
-    uint64_t zcorn_pos = 0;
-
-    while (!isEOF(&fileH)) {
-
-        readBinaryHeader(fileH,arrName,num, arrType, sizeOfElement);
-
-        if (arrName == "ZCORN   "){
-            zcorn_pos = fileH.tellg();
-            break;
-        }
-
-        uint64_t sizeOfNextArray = sizeOnDiskBinary(num, arrType, sizeOfElement);
-        fileH.seekg(static_cast<std::streamoff>(sizeOfNextArray), std::ios_base::cur);
-    }
-
-    int elements_pr_block = Opm::EclIO::MaxBlockSizeReal / Opm::EclIO::sizeOfReal;
-    int num_blocks_start = zcorn_offset / elements_pr_block;
-
-    // adding size of zcorn real data before to ignored
-    uint64_t start_pos = zcorn_pos + Opm::EclIO::sizeOfReal * zcorn_offset;
-
-    // adding size of blocks (head and tail flags)
-    start_pos = start_pos + (1 + num_blocks_start * 2) * Opm::EclIO::sizeOfInte;
-
-    fileH.seekg(start_pos, std::ios_base::beg);
-
-    uint64_t zcorn_to = zcorn_offset + nodes_pr_surf;
-
-    int i1 = zcorn_offset / 1000 + 1;
-    uint64_t elemets = static_cast<uint64_t>(i1 * elements_pr_block - zcorn_offset);
-
-    uint64_t next_block = elemets < zcorn_to ? elemets : zcorn_to - zcorn_offset + 1 ;
-
-    uint64_t p1 = zcorn_offset;
-
-    while (p1 < zcorn_to){
-
-        std::vector<float> buf(next_block);
-        fileH.read(reinterpret_cast<char*>(buf.data()), buf.size()*sizeof(float));
-
-        for (size_t n = 0; n < next_block; n++)
-            zcorn_layer.push_back(Opm::EclIO::flipEndianFloat(buf[n]));
-
-        p1 = p1 + next_block;
-
-        if (p1 < zcorn_to) {
-            int dtail;
-            fileH.read(reinterpret_cast<char*>(&dtail), sizeof(dtail));
-            fileH.read(reinterpret_cast<char*>(&dtail), sizeof(dtail));
-            dtail = Opm::EclIO::flipEndianInt(dtail);
-
-            next_block = static_cast<uint64_t>(dtail) / static_cast<uint64_t>(Opm::EclIO::sizeOfReal);
-
-            if ((p1 + next_block) > zcorn_to)
-                next_block = zcorn_to - p1;
-        }
-    }
-
-    fileH.close();
-
-    return zcorn_layer;
+    // ZCORN of the selected grid, i.e. global or LGR
+    return readBinaryRealSlice(fileH, ifStreamPos[zcorn_array_index], zcorn_offset, nodes_pr_surf);
 }
 
 
@@ -550,29 +748,12 @@ void EGrid::getCellCorners(const std::array<int, 3>& ijk, const std::vector<floa
     for (int n = 0; n< 4; n++)
         Z[n] = zcorn_layer[zind[n]];
 
-    for (int  n = 0; n < 4; n++) {
-        double xt;
-        double yt;
-        double xb;
-        double yb;
-
-        double zt = coord_array[pind[n] + 2];
-        double zb = coord_array[pind[n] + 5];
-
-        xt = coord_array[pind[n]];
-        yt = coord_array[pind[n] + 1];
-        xb = coord_array[pind[n] + 3];
-        yb = coord_array[pind[n] + 4];
+    std::array<const float*, 4> pillars;
 
-        if (zt == zb) {
-            X[n] = xt;
-            Y[n] = yt;
-        } else {
-            X[n] = xt + (xb-xt) / (zt-zb) * (zt - Z[n]);
-            Y[n] = yt+(yb-yt)/(zt-zb)*(zt-Z[n]);
-        }
+    for (int n = 0; n < 4; n++)
+        pillars[n] = coord_array.data() + pind[n];
 
-    }
+    face_corners(pillars, Z, X, Y);
 }
 
 
@@ -27,10 +27,12 @@
 #include <opm/io/eclipse/EclFile.hpp>
 #include <opm/io/eclipse/EclUtil.hpp>
 #include <opm/io/eclipse/EclOutput.hpp>
+#include <opm/io/eclipse/SmryCompression.hpp>
 
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <exception>
@@ -555,10 +557,12 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData) :
 
         std::vector<ArrSourceEntry> arraySourceList;
 
+        uint64_t endPos = 0;
+
         for (std::string fileName : resultsFileList)
         {
             std::vector<std::tuple <std::string, std::uint64_t>> arrayList;
-            arrayList = this->getListOfArrays(fileName, formattedFiles[specInd]);
+            arrayList = this->getListOfArrays(fileName, formattedFiles[specInd], 0, endPos);
 
             for (size_t n = 0; n < arrayList.size(); n++) {
                 ArrSourceEntry  t1 = std::make_tuple(std::get<0>(arrayList[n]), fileName, n, std::get<1>(arrayList[n]));
@@ -573,7 +577,12 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData) :
         //       else : MINISTEP and PARAMS
 
 
-        size_t i = std::get<0>(arraySourceList[0]) == "SEQHDR" ? 1 : 0 ;
+        size_t i = (!arraySourceList.empty() && (std::get<0>(arraySourceList[0]) == "SEQHDR")) ? 1 : 0 ;
+
+        if (specInd == 0) {
+            followFile = resultsFileList.back();
+            followPos = endPos;
+        }
 
         while  (i < arraySourceList.size()) {
 
@@ -582,6 +591,21 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData) :
                 throw std::invalid_argument(message);
             }
 
+            // PARAMS not yet written, the time step is read by update()
+            if (i + 1 == arraySourceList.size()) {
+                if (specInd == 0) {
+                    followFile = std::get<1>(arraySourceList[i]);
+                    followPos = std::get<3>(arraySourceList[i]) - (formattedFiles[specInd] ? 31 : 24);
+                }
+
+                if ((step > 0) && (seqIndex.empty() || (seqIndex.back() != step - 1))) {
+                    seqIndex.push_back(step - 1);
+                    provisionalReportStep = true;
+                }
+
+                break;
+            }
+
             if (std::get<0>(arraySourceList[i+1]) != "PARAMS") {
                 std::string message="Reading summary file, expecting keyword PARAMS, found '" + std::get<0>(arraySourceList[i]) + "'";
                 throw std::invalid_argument(message);
@@ -608,10 +632,12 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData) :
                     i++;
                     reportStepNumber++;
                     seqIndex.push_back(step);
+                    provisionalReportStep = false;
                 }
             } else {
                 reportStepNumber++;
                 seqIndex.push_back(step);
+                provisionalReportStep = true;
             }
 
             if (reportStepNumber >= toReportStepNumber) {
@@ -634,8 +660,12 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData) :
 
 void ESmry::read_ministeps_from_disk()
 {
-    auto specInd = std::get<0>(miniStepList[0]);
-    auto dataFileIndex = std::get<1>(miniStepList[0]);
+    // only the ministeps added by update() are read if called again
+    if (mini_steps.size() >= miniStepList.size())
+        return;
+
+    auto specInd = std::get<0>(miniStepList[mini_steps.size()]);
+    auto dataFileIndex = std::get<1>(miniStepList[mini_steps.size()]);
     uint64_t stepFilePos;
 
     std::fstream fileH;
@@ -647,7 +677,7 @@ void ESmry::read_ministeps_from_disk()
 
     int ministep_value;
 
-    for (size_t n = 0; n < miniStepList.size(); n++) {
+    for (size_t n = mini_steps.size(); n < miniStepList.size(); n++) {
 
         if (dataFileIndex != std::get<1>(miniStepList[n])) {
             fileH.close();
@@ -667,8 +697,7 @@ void ESmry::read_ministeps_from_disk()
         if (formattedFiles[specInd]) {
             ministep_value = read_ministep_formatted(fileH);
         } else {
-            std::function<int(int)> f = Opm::EclIO::flipEndianInt;
-            auto ministep_vect = readBinaryArray<int,int>(fileH, 1, Opm::EclIO::INTE, f, sizeOfInte);
+            auto ministep_vect = readBinaryInteArray(fileH, 1);
             ministep_value = ministep_vect[0];
         }
 
@@ -680,8 +709,7 @@ void ESmry::read_ministeps_from_disk()
 
 bool ESmry::all_steps_available()
 {
-    if (mini_steps.size() == 0)
-        this->read_ministeps_from_disk();
+    this->read_ministeps_from_disk();
 
     for (size_t n = 1; n < mini_steps.size(); n++)
         if ((mini_steps[n] - mini_steps[n-1]) > 1)
@@ -690,6 +718,108 @@ bool ESmry::all_steps_available()
     return true;
 }
 
+std::size_t ESmry::update()
+{
+    auto start = std::chrono::system_clock::now();
+
+    const bool formatted = formattedFiles[0];
+    const uint64_t headerSize = formatted ? 31 : 24;
+
+    const std::filesystem::path followPath(followFile);
+    const auto extension = followPath.extension().string();
+
+    std::vector<std::string> fileList { followFile };
+
+    // non-unified data files which have been written since the last update
+    if ((extension != ".UNSMRY") && (extension != ".FUNSMRY")) {
+        for (const auto& fileName : checkForMultipleResultFiles(followPath.parent_path() / followPath.stem(), formatted))
+            if (fileName > followFile)
+                fileList.push_back(fileName);
+    }
+
+    const std::size_t oldNTstep = timeStepList.size();
+    int step = static_cast<int>(oldNTstep);
+
+    for (const auto& fileName : fileList) {
+        uint64_t endPos = 0;
+        const auto arrayList = this->getListOfArrays(fileName, formatted, fileName == followFile ? followPos : 0, endPos);
+
+        auto it = std::find(dataFileList.begin(), dataFileList.end(), fileName);
+        int dataFileIndex = it == dataFileList.end() ? -1 : static_cast<int>(std::distance(dataFileList.begin(), it));
+
+        bool complete = endPos == std::filesystem::file_size(fileName);
+        size_t i = 0;
+
+        while (i < arrayList.size()) {
+            const auto& [arrName, filePos] = arrayList[i];
+
+            if (arrName == "SEQHDR") {
+                if ((step > 0) && (seqIndex.empty() || (seqIndex.back() != step - 1)))
+                    seqIndex.push_back(step - 1);
+
+                provisionalReportStep = false;
+                i++;
+                continue;
+            }
+
+            if (arrName != "MINISTEP")
+                throw std::invalid_argument("Reading summary file, expecting keyword MINISTEP, found '" + arrName + "'");
+
+            // PARAMS not yet written, continue from this MINISTEP in the next update
+            if (i + 1 == arrayList.size()) {
+                endPos = filePos - headerSize;
+                complete = false;
+                break;
+            }
+
+            if (std::get<0>(arrayList[i + 1]) != "PARAMS")
+                throw std::invalid_argument("Reading summary file, expecting keyword PARAMS, found '" + std::get<0>(arrayList[i + 1]) + "'");
+
+            if (provisionalReportStep) {
+                seqIndex.pop_back();
+                provisionalReportStep = false;
+            }
+
+            if (dataFileIndex < 0) {
+                dataFileList.push_back(fileName);
+                dataFileIndex = static_cast<int>(dataFileList.size()) - 1;
+            }
+
+            miniStepList.emplace_back(0, dataFileIndex, filePos);
+            timeStepList.emplace_back(0, dataFileIndex, std::get<1>(arrayList[i + 1]));
+
+            i += 2;
+            step++;
+        }
+
+        followFile = fileName;
+        followPos = endPos;
+
+        if (!complete)
+            break;
+    }
+
+    // as in the constructor, the last time step is treated as a report step
+    if ((step > 0) && (seqIndex.empty() || (seqIndex.back() != step - 1))) {
+        seqIndex.push_back(step - 1);
+        provisionalReportStep = true;
+    }
+
+    nTstep = timeStepList.size();
+
+    std::vector<int> loadedVectors;
+    for (size_t n = 0; n < nVect; n++)
+        if (vectorLoaded[n])
+            loadedVectors.push_back(static_cast<int>(n));
+
+    this->readParams(loadedVectors, oldNTstep);
+
+    std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+    m_io_loading += elapsed_seconds.count();
+
+    return nTstep - oldNTstep;
+}
+
 int ESmry::read_ministep_formatted(std::fstream& fileH)
 {
     const std::size_t size = sizeOnDiskFormatted(1, Opm::EclIO::INTE, 4)+1;
@@ -713,6 +843,64 @@ std::string ESmry::read_string_from_disk(std::fstream& fileH, uint64_t size) con
 }
 
 
+namespace {
+
+/*
+  Reads of requested elements in a PARAMS array which are closer than this
+  number of bytes are coalesced into a single read. When many vectors are
+  requested this will typically end up reading each PARAMS array in one go.
+*/
+constexpr std::uint64_t maxCoalesceGap = 32 * 1024;
+
+struct ParamRead {
+    std::uint64_t offset;
+    int keyIndex;
+};
+
+struct ParamRange {
+    std::uint64_t begin;
+    std::uint64_t end;
+    std::vector<ParamRead> reads;
+};
+
+// Unformatted files are big endian, independent of the host.
+float readBigEndianFloat(const char* data)
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    const std::uint32_t bits = (static_cast<std::uint32_t>(bytes[0]) << 24)
+                             | (static_cast<std::uint32_t>(bytes[1]) << 16)
+                             | (static_cast<std::uint32_t>(bytes[2]) <<  8)
+                             |  static_cast<std::uint32_t>(bytes[3]);
+    float value;
+    std::memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+/*
+  Offset of element paramPos relative to the start of the PARAMS array
+  data, i.e. the file position of the ministep.
+*/
+std::uint64_t paramsElementOffset(int paramPos, bool formatted)
+{
+    if (formatted) {
+        const int rest = MaxBlockSizeReal % numColumnsReal;
+        const int nLinesBlock = MaxBlockSizeReal / numColumnsReal + (rest > 0);
+        const auto blockSize_f = static_cast<std::uint64_t>(MaxNumBlockReal * numColumnsReal * columnWidthReal + nLinesBlock);
+
+        const int nBlocks = paramPos / MaxBlockSizeReal;
+        const int sizeOfLastBlock = paramPos % MaxBlockSizeReal;
+        const int nLines = sizeOfLastBlock / numColumnsReal;
+
+        return nBlocks * blockSize_f + static_cast<std::uint64_t>(sizeOfLastBlock*columnWidthReal + nLines);
+    }
+
+    const std::uint64_t nFullBlocks = static_cast<std::uint64_t>(paramPos/(MaxBlockSizeReal / sizeOfReal));
+    return ((2 * nFullBlocks) + 1) * static_cast<std::uint64_t>(sizeOfInte)
+        + static_cast<std::uint64_t>(paramPos) * static_cast<std::uint64_t>(sizeOfReal);
+}
+
+}
+
 void ESmry::loadData(const std::vector<std::string>& vectList) const
 {
     auto start = std::chrono::system_clock::now();
@@ -721,41 +909,102 @@ void ESmry::loadData(const std::vector<std::string>& vectList) const
     std::vector<int> keywIndVect;
     keywIndVect.reserve(nvect);
 
+    std::vector<bool> requested(nVect, false);
     for (auto key : vectList) {
         if (!hasKey(key))
             OPM_THROW(std::invalid_argument, "error loading key " + key );
 
         auto it = keyword_index.find(key);
 
-        if (!vectorLoaded[it->second])
+        if (!vectorLoaded[it->second] && !requested[it->second]) {
+            requested[it->second] = true;
             keywIndVect.push_back(it->second);
+        }
     }
 
+    if (keywIndVect.empty())
+        return;
+
     for (auto ind : keywIndVect)
         vectorData[ind].reserve(nTstep);
 
-    std::fstream fileH;
+    this->readParams(keywIndVect, 0);
 
-    auto specInd = std::get<0>(timeStepList[0]);
-    auto dataFileIndex = std::get<1>(timeStepList[0]);
-    std::uint64_t blockSize_f;
+    for (const auto& ind : keywIndVect)
+        vectorLoaded[ind] = true;
 
+    std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+    m_io_loading += elapsed_seconds.count();
+}
+
+/*
+  Appends the values of the vectors in keywIndVect for the time steps
+  starting with fromStep to vectorData.
+*/
+void ESmry::readParams(const std::vector<int>& keywIndVect, std::size_t fromStep) const
+{
+    if (fromStep >= timeStepList.size())
+        return;
+
+    /*
+      The requested elements are sorted on their position in the PARAMS
+      array of the current SMSPEC file, and elements which are close are
+      grouped into ranges which are read with one read() call per ministep.
+    */
+    std::vector<ParamRange> ranges;
+    std::vector<int> undefinedVectors;
+
+    auto makeRanges = [&](int specInd)
     {
-        const int rest = MaxBlockSizeReal % numColumnsReal;
-        const int nLinesBlock = MaxBlockSizeReal / numColumnsReal + (rest > 0);
+        ranges.clear();
+        undefinedVectors.clear();
 
-        blockSize_f= static_cast<std::uint64_t>(MaxNumBlockReal * numColumnsReal * columnWidthReal + nLinesBlock);
-    }
+        std::vector<ParamRead> reads;
+        for (auto ind : keywIndVect) {
+            auto it = arrayPos[specInd].find(ind);
+            if (it == arrayPos[specInd].end())
+                // undefined vector in current summary file. Typically when loading
+                // base restart run and including base run data. Vectors can be added to restart runs
+                undefinedVectors.push_back(ind);
+            else
+                reads.push_back({ paramsElementOffset(it->second, formattedFiles[specInd]), ind });
+        }
+
+        std::sort(reads.begin(), reads.end(),
+                  [](const ParamRead& r1, const ParamRead& r2) { return r1.offset < r2.offset; });
+
+        const std::uint64_t elementSize = formattedFiles[specInd] ? columnWidthReal : sizeOfReal;
+        for (const auto& read : reads) {
+            if (ranges.empty() || (read.offset > ranges.back().end + maxCoalesceGap))
+                ranges.push_back({ read.offset, read.offset, {} });
+
+            auto& range = ranges.back();
+            range.end = read.offset + elementSize;
+            range.reads.push_back(read);
+        }
+    };
+
+    std::fstream fileH;
+
+    auto specInd = std::get<0>(timeStepList[fromStep]);
+    auto dataFileIndex = std::get<1>(timeStepList[fromStep]);
 
     if (formattedFiles[specInd])
         fileH.open(dataFileList[dataFileIndex], std::ios::in);
     else
         fileH.open(dataFileList[dataFileIndex], std::ios::in |  std::ios::binary);
 
-    for (const auto& ministep : timeStepList) {
+    makeRanges(specInd);
+
+    std::vector<char> buffer;
+    for (auto step = fromStep; step < timeStepList.size(); ++step) {
+        const auto& ministep = timeStepList[step];
         if (dataFileIndex != std::get<1>(ministep)) {
             fileH.close();
-            specInd = std::get<0>(ministep);
+            if (specInd != std::get<0>(ministep)) {
+                specInd = std::get<0>(ministep);
+                makeRanges(specInd);
+            }
             dataFileIndex = std::get<1>(ministep);
 
             if (formattedFiles[specInd])
@@ -764,59 +1013,33 @@ void ESmry::loadData(const std::vector<std::string>& vectList) const
                 fileH.open(dataFileList[dataFileIndex], std::ios::in |  std::ios::binary);
         }
 
-        const auto stepFilePos = std::get<2>(ministep);;
-
-        for (auto ind : keywIndVect) {
-            auto it = arrayPos[specInd].find(ind);
-            if (it == arrayPos[specInd].end()) {
-                // undefined vector in current summary file. Typically when loading
-                // base restart run and including base run data. Vectors can be added to restart runs
-                vectorData[ind].push_back(std::nanf(""));
-            }
-            else {
-                int paramPos = it->second;
-
-                if (formattedFiles[specInd]) {
-                    std::uint64_t elementPos = 0;
-                    int nBlocks = paramPos / MaxBlockSizeReal;
-                    int sizeOfLastBlock = paramPos %  MaxBlockSizeReal;
-
-                    if (nBlocks > 0)
-                        elementPos = static_cast<uint64_t>(nBlocks * blockSize_f);
-
-                    int nLines = sizeOfLastBlock / numColumnsReal;
-                    elementPos = stepFilePos + elementPos + static_cast<std::uint64_t>(sizeOfLastBlock*columnWidthReal + nLines);
+        const auto stepFilePos = std::get<2>(ministep);
 
-                    fileH.seekg (elementPos, fileH.beg);
+        for (auto ind : undefinedVectors)
+            vectorData[ind].push_back(std::nanf(""));
 
-                    const std::size_t size = columnWidthReal;
-                    std::vector<char> buffer(size);
-                    fileH.read (buffer.data(), size);
-                    vectorData[ind].push_back(std::strtof(buffer.data(), nullptr));
-                }
-                else {
-                    const std::uint64_t nFullBlocks = static_cast<std::uint64_t>(paramPos/(MaxBlockSizeReal / sizeOfReal));
-                    std::uint64_t elementPos = ((2 * nFullBlocks) + 1) * static_cast<std::uint64_t>(sizeOfInte);
-                    elementPos += static_cast<std::uint64_t>(paramPos) * static_cast<std::uint64_t>(sizeOfReal) + stepFilePos;
+        for (const auto& range : ranges) {
+            const auto size = range.end - range.begin;
 
-                    fileH.seekg (elementPos, fileH.beg);
+            // Formatted values are parsed with strtof() and need a terminator.
+            buffer.resize(size + 1);
+            buffer[size] = '\0';
 
-                    float value;
-                    fileH.read(reinterpret_cast<char*>(&value), sizeOfReal);
+            fileH.seekg (stepFilePos + range.begin, fileH.beg);
+            fileH.read (buffer.data(), size);
 
-                    vectorData[ind].push_back(Opm::EclIO::flipEndianFloat(value));
-                }
+            if (formattedFiles[specInd]) {
+                for (const auto& read : range.reads)
+                    vectorData[read.keyIndex].push_back(std::strtof(buffer.data() + (read.offset - range.begin), nullptr));
+            }
+            else {
+                for (const auto& read : range.reads)
+                    vectorData[read.keyIndex].push_back(readBigEndianFloat(buffer.data() + (read.offset - range.begin)));
             }
         }
     }
 
     fileH.close();
-
-    for (const auto& ind : keywIndVect)
-        vectorLoaded[ind] = true;
-
-    std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
-    m_io_loading += elapsed_seconds.count();
 }
 
 std::vector<int> ESmry::makeKeywPosVector(int specInd) const
@@ -943,8 +1166,14 @@ void ESmry::loadData() const
 }
 
 
+/*
+  Lists the arrays in a summary data file, starting with the array header at
+  fromPos. An array which is not completely written, i.e. from an active run,
+  ends the list. On return endPos is the position after the last complete
+  array.
+*/
 std::vector<std::tuple <std::string, uint64_t>>
-ESmry::getListOfArrays(std::string filename, bool formatted)
+ESmry::getListOfArrays(const std::string& filename, bool formatted, uint64_t fromPos, uint64_t& endPos) const
 {
     std::vector<std::tuple <std::string, uint64_t>> resultVect;
 
@@ -954,14 +1183,18 @@ ESmry::getListOfArrays(std::string filename, bool formatted)
 
     int64_t num;
 
+    const uint64_t fileSize = std::filesystem::file_size(filename);
+    const uint64_t headerSize = formatted ? 31 : 24;
+
     if (formatted)
         ptr = fopen(filename.c_str(),"r");  // r for read, files opened as text files
     else
         ptr = fopen(filename.c_str(),"rb");  // r for read, b for binary
 
-    bool endOfFile = false;
+    endPos = fromPos;
+    fseek(ptr, static_cast<long int>(fromPos), SEEK_SET);
 
-    while (!endOfFile)
+    while (endPos + headerSize <= fileSize)
     {
         Opm::EclIO::eclArrType arrType;
 
@@ -1020,26 +1253,19 @@ ESmry::getListOfArrays(std::string filename, bool formatted)
             }
         }
 
-        uint64_t filePos = static_cast<uint64_t>(ftell(ptr));
+        uint64_t filePos = endPos + headerSize;
+        uint64_t sizeOfNextArray = 0;
 
-        std::tuple <std::string, uint64_t> t1;
-        t1 = std::make_tuple(Opm::EclIO::trimr(arrName), filePos);
-        resultVect.push_back(t1);
+        if (num > 0)
+            sizeOfNextArray = formatted ? sizeOnDiskFormatted(num, arrType, 4) : sizeOnDiskBinary(num, arrType, 4);
 
-        if (num > 0) {
-            if (formatted) {
-                uint64_t sizeOfNextArray = sizeOnDiskFormatted(num, arrType, 4);
-                fseek(ptr, static_cast<long int>(sizeOfNextArray), SEEK_CUR);
-            } else {
-                uint64_t sizeOfNextArray = sizeOnDiskBinary(num, arrType, 4);
-                fseek(ptr, static_cast<long int>(sizeOfNextArray), SEEK_CUR);
-            }
-        }
+        if (filePos + sizeOfNextArray > fileSize)
+            break;
 
-        if (fgetc(ptr) == EOF)
-            endOfFile = true;
-        else
-            fseek(ptr, -1, SEEK_CUR);
+        resultVect.emplace_back(Opm::EclIO::trimr(arrName), filePos);
+
+        endPos = filePos + sizeOfNextArray;
+        fseek(ptr, static_cast<long int>(endPos), SEEK_SET);
     }
 
     fclose(ptr);
@@ -1047,7 +1273,7 @@ ESmry::getListOfArrays(std::string filename, bool formatted)
     return resultVect;
 }
 
-bool ESmry::make_esmry_file()
+bool ESmry::make_esmry_file(bool compressed)
 {
     // check that loadBaseRunData is not set, this function only works for single smspec files
     // function will not replace existing lodsmry files (since this is already loaded by this class)
@@ -1056,8 +1282,7 @@ bool ESmry::make_esmry_file()
     if (!fromSingleRun)
         OPM_THROW(std::invalid_argument, "creating esmry file only possible when loadBaseRunData=false");
 
-    if (mini_steps.size() == 0)
-        this->read_ministeps_from_disk();
+    this->read_ministeps_from_disk();
 
     std::filesystem::path path = inputFileName.parent_path();
     std::filesystem::path rootName = inputFileName.stem();
@@ -1110,12 +1335,18 @@ bool ESmry::make_esmry_file()
 
             outFile.write("KEYCHECK", keyword);
             outFile.write("UNITS", units);
-            outFile.write<int>("RSTEP", is_rstep);
-            outFile.write<int>("TSTEP", mini_steps);
 
-            for (size_t n = 0; n < vectorData.size(); n++ ) {
-                const std::string vect_name = fmt::format("V{}", n);
-                outFile.write<float>(vect_name, vectorData[n]);
+            if (compressed) {
+                writeCompressedSmryChunks(outFile, is_rstep, mini_steps, vectorData, timeStepList.size());
+
+            } else {
+                outFile.write<int>("RSTEP", is_rstep);
+                outFile.write<int>("TSTEP", mini_steps);
+
+                for (size_t n = 0; n < vectorData.size(); n++ ) {
+                    const std::string vect_name = fmt::format("V{}", n);
+                    outFile.write<float>(vect_name, vectorData[n]);
+                }
             }
         }
 
@@ -1395,9 +1626,10 @@ const std::vector<std::string>& ESmry::keywordList() const
 std::vector<std::string> ESmry::keywordList(const std::string& pattern) const
 {
     std::vector<std::string> list;
+    const ShellPattern shell_pattern(pattern);
 
-    for (auto key : keyword)
-        if (shmatch(pattern, key))
+    for (const auto& key : keyword)
+        if (shell_pattern.match(key))
             list.push_back(key);
 
     return list;
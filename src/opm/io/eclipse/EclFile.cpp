@@ -23,15 +23,29 @@
 #include <fmt/format.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <exception>
 #include <functional>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <iterator>
 #include <string>
 #include <numeric>
 #include <cmath>
 
+namespace {
+
+/*
+  Upper limit for the size on disk of the arrays which are loaded
+  concurrently with more than one thread. Arrays are loaded in batches
+  below this size, and a batch is completed before the next is started.
+*/
+constexpr std::uint64_t max_parallel_load_bytes = std::uint64_t{256} << 20;
+
+}
+
 namespace Opm { namespace EclIO {
 
 void EclFile::load(bool preload) {
@@ -113,27 +127,68 @@ EclFile::EclFile(const std::string& filename, bool preload) :
 
 
 void EclFile::loadBinaryArray(std::fstream& fileH, std::size_t arrIndex)
+{
+    this->createArray(arrIndex);
+    this->readBinaryArrayData(fileH, arrIndex);
+    arrayLoaded[arrIndex] = true;
+}
+
+
+/*
+  Inserts the (empty) storage for the array in the map of the array type.
+  When loading with multiple threads all the entries are created up front,
+  so that the worker threads only assign to existing elements of the maps.
+*/
+void EclFile::createArray(std::size_t arrIndex)
+{
+    switch (array_type[arrIndex]) {
+    case INTE:
+        inte_array[arrIndex];
+        break;
+    case REAL:
+        real_array[arrIndex];
+        break;
+    case DOUB:
+        doub_array[arrIndex];
+        break;
+    case LOGI:
+        logi_array[arrIndex];
+        break;
+    case CHAR:
+    case C0NN:
+        char_array[arrIndex];
+        break;
+    case MESS:
+        break;
+    default:
+        OPM_THROW(std::runtime_error, "Asked to read unexpected array type");
+        break;
+    }
+}
+
+
+void EclFile::readBinaryArrayData(std::fstream& fileH, std::size_t arrIndex)
 {
     fileH.seekg (ifStreamPos[arrIndex], fileH.beg);
 
     switch (array_type[arrIndex]) {
     case INTE:
-        inte_array[arrIndex] = readBinaryInteArray(fileH, array_size[arrIndex]);
+        inte_array.find(arrIndex)->second = readBinaryInteArray(fileH, array_size[arrIndex]);
         break;
     case REAL:
-        real_array[arrIndex] = readBinaryRealArray(fileH, array_size[arrIndex]);
+        real_array.find(arrIndex)->second = readBinaryRealArray(fileH, array_size[arrIndex]);
         break;
     case DOUB:
-        doub_array[arrIndex] = readBinaryDoubArray(fileH, array_size[arrIndex]);
+        doub_array.find(arrIndex)->second = readBinaryDoubArray(fileH, array_size[arrIndex]);
         break;
     case LOGI:
-        logi_array[arrIndex] = readBinaryLogiArray(fileH, array_size[arrIndex]);
+        logi_array.find(arrIndex)->second = readBinaryLogiArray(fileH, array_size[arrIndex]);
         break;
     case CHAR:
-        char_array[arrIndex] = readBinaryCharArray(fileH, array_size[arrIndex]);
+        char_array.find(arrIndex)->second = readBinaryCharArray(fileH, array_size[arrIndex]);
         break;
     case C0NN:
-        char_array[arrIndex] = readBinaryC0nnArray(fileH, array_size[arrIndex], array_element_size[arrIndex]);
+        char_array.find(arrIndex)->second = readBinaryC0nnArray(fileH, array_size[arrIndex], array_element_size[arrIndex]);
         break;
     case MESS:
         break;
@@ -141,8 +196,85 @@ void EclFile::loadBinaryArray(std::fstream& fileH, std::size_t arrIndex)
         OPM_THROW(std::runtime_error, "Asked to read unexpected array type");
         break;
     }
+}
 
-    arrayLoaded[arrIndex] = true;
+
+/*
+  Loads the binary arrays in arrIndex with num_threads threads, each
+  reading through its own file stream. The threads pick the next array
+  from a shared counter, and every array is stored in its own entry in the
+  array maps, so the result does not depend on the scheduling.
+*/
+void EclFile::loadBinaryArraysParallel(const std::vector<int>& arrIndex)
+{
+    std::vector<int> unique;
+    {
+        std::vector<bool> requested(array_name.size(), false);
+        for (int ind : arrIndex) {
+            if (!requested[ind]) {
+                requested[ind] = true;
+                unique.push_back(ind);
+            }
+        }
+    }
+
+    for (int ind : unique)
+        this->createArray(ind);
+
+    auto batch_begin = unique.begin();
+    while (batch_begin != unique.end()) {
+        auto batch_end = batch_begin;
+        std::uint64_t batch_size = 0;
+        while (batch_end != unique.end()) {
+            const auto size = ifStreamPos[*batch_end + 1] - ifStreamPos[*batch_end];
+            if ((batch_end != batch_begin) && (batch_size + size > max_parallel_load_bytes))
+                break;
+
+            batch_size += size;
+            ++batch_end;
+        }
+
+        std::atomic<std::size_t> next{0};
+        const auto batch_length = static_cast<std::size_t>(std::distance(batch_begin, batch_end));
+        auto worker = [this, &next, batch_begin, batch_length]()
+        {
+            std::fstream fileH(inputFilename, std::ios::in | std::ios::binary);
+            if (!fileH)
+                OPM_THROW(std::runtime_error, "Could not open file: '" + inputFilename +"'");
+
+            for (auto n = next++; n < batch_length; n = next++)
+                this->readBinaryArrayData(fileH, *(batch_begin + n));
+        };
+
+        std::vector<std::future<void>> workers;
+        const auto num_workers = std::min(num_threads, batch_length);
+        for (std::size_t n = 1; n < num_workers; n++)
+            workers.push_back(std::async(std::launch::async, worker));
+
+        std::exception_ptr error;
+        try {
+            worker();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        for (auto& future : workers) {
+            try {
+                future.get();
+            } catch (...) {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+
+        for (auto it = batch_begin; it != batch_end; ++it)
+            arrayLoaded[*it] = true;
+
+        batch_begin = batch_end;
+    }
 }
 
 void EclFile::loadFormattedArray(const std::string& fileStr, std::size_t arrIndex, int64_t fromPos)
@@ -150,16 +282,16 @@ void EclFile::loadFormattedArray(const std::string& fileStr, std::size_t arrInde
 
     switch (array_type[arrIndex]) {
     case INTE:
-        inte_array[arrIndex] = readFormattedInteArray(fileStr, array_size[arrIndex], fromPos);
+        inte_array[arrIndex] = readFormattedInteArray(fileStr, array_size[arrIndex], fromPos, num_threads);
         break;
     case REAL:
-        real_array[arrIndex] = readFormattedRealArray(fileStr, array_size[arrIndex], fromPos);
+        real_array[arrIndex] = readFormattedRealArray(fileStr, array_size[arrIndex], fromPos, num_threads);
         break;
     case DOUB:
-        doub_array[arrIndex] = readFormattedDoubArray(fileStr, array_size[arrIndex], fromPos);
+        doub_array[arrIndex] = readFormattedDoubArray(fileStr, array_size[arrIndex], fromPos, num_threads);
         break;
     case LOGI:
-        logi_array[arrIndex] = readFormattedLogiArray(fileStr, array_size[arrIndex], fromPos);
+        logi_array[arrIndex] = readFormattedLogiArray(fileStr, array_size[arrIndex], fromPos, num_threads);
         break;
     case CHAR:
         char_array[arrIndex] = readFormattedCharArray(fileStr, array_size[arrIndex], fromPos, sizeOfChar);
@@ -181,7 +313,7 @@ void EclFile::loadFormattedArray(const std::string& fileStr, std::size_t arrInde
 void EclFile::loadData()
 {
 
-    if (formatted) {
+    if (formatted || (num_threads > 1)) {
 
         std::vector<int> arrIndices(array_name.size());
         std::iota(arrIndices.begin(), arrIndices.end(), 0);
@@ -230,6 +362,17 @@ void EclFile::loadData(const std::string& name)
             }
         }
 
+    } else if (num_threads > 1) {
+
+        std::vector<int> arrIndices;
+        for (size_t i = 0; i < array_name.size(); i++) {
+            if (array_name[i] == name) {
+                arrIndices.push_back(i);
+            }
+        }
+
+        this->loadBinaryArraysParallel(arrIndices);
+
     } else {
 
         std::fstream fileH;
@@ -271,6 +414,8 @@ void EclFile::loadData(const std::vector<int>& arrIndex)
             loadFormattedArray(fileStr, ind, 0);
         }
 
+    } else if ((num_threads > 1) && (arrIndex.size() > 1)) {
+        this->loadBinaryArraysParallel(arrIndex);
     } else {
         std::fstream fileH;
         fileH.open(inputFilename, std::ios::in |  std::ios::binary);
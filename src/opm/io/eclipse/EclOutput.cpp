@@ -16,15 +16,19 @@
    along with OPM.  If not, see <http://www.gnu.org/licenses/>.
    */
 
+#include <config.h>
 #include <opm/io/eclipse/EclOutput.hpp>
 #include <opm/io/eclipse/EclUtil.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
 
 #include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <future>
 #include <iterator>
 #include <iomanip>
 #include <iostream>
@@ -33,6 +37,154 @@
 #include <stdexcept>
 #include <typeinfo>
 
+namespace {
+
+constexpr std::size_t formatted_buffer_size = 32;
+constexpr std::size_t formatted_blocks_per_range = 16;
+
+// Writes the value as printf("%.*e") does, returns the end of the output.
+char* write_scientific(char* first, char* last, const double value, const int precision)
+{
+#if HAVE_FLOATING_POINT_CHARCONV
+    return std::to_chars(first, last, value, std::chars_format::scientific, precision).ptr;
+#else
+    return first + std::snprintf(first, last - first, "%.*e", precision, value);
+#endif
+}
+
+/*
+  Writes the value as 0.dddd..E+xx, i.e. with the decimal point moved one
+  place to the left compared to the C style scientific notation. The digits
+  are the correctly rounded ones, as given by printf("%.*E"). When
+  drop_exp_char is true the exponent character is left out for three digit
+  exponents. The value must be finite and nonzero.
+*/
+char* write_ecl_scientific(char* out, const double value, const int precision,
+                           const char exp_char, const bool drop_exp_char)
+{
+    char buffer[formatted_buffer_size];
+    const auto end = write_scientific(buffer, buffer + sizeof buffer, value, precision);
+
+    const char* p = buffer;
+    if (*p == '-')
+        *out++ = *p++;
+
+    *out++ = '0';
+    *out++ = '.';
+    *out++ = p[0];
+    out = std::copy_n(p + 2, precision, out);
+
+    // The mantissa is followed by e+xx or e+xxx.
+    const char* e = p + 2 + precision;
+    int exp = 0;
+    for (const char* digit = e + 2; digit != end; ++digit)
+        exp = 10*exp + (*digit - '0');
+
+    if (e[1] == '-')
+        exp = -exp;
+
+    exp += 1;
+    if (!drop_exp_char || ((exp > -100) && (exp < 100)))
+        *out++ = exp_char;
+
+    *out++ = (exp < 0) ? '-' : '+';
+    const int abs_exp = std::abs(exp);
+    if (abs_exp >= 100)
+        *out++ = static_cast<char>('0' + abs_exp / 100);
+
+    *out++ = static_cast<char>('0' + (abs_exp / 10) % 10);
+    *out++ = static_cast<char>('0' + abs_exp % 10);
+    return out;
+}
+
+char* write_string(char* out, const char* str)
+{
+    return std::copy(str, str + std::strlen(str), out);
+}
+
+// Common handling of zero, NaN and infinity; returns nullptr otherwise.
+char* write_special(char* out, const double value, const char* zero)
+{
+    if (value == 0.0)
+        return write_string(out, zero);
+
+    if (std::isnan(value))
+        return write_string(out, "NAN");
+
+    if (std::isinf(value))
+        return write_string(out, (value > 0) ? "INF" : "-INF");
+
+    return nullptr;
+}
+
+char* format_real_ecl(char* out, const float value)
+{
+    if (auto* end = write_special(out, value, "0.00000000E+00"))
+        return end;
+
+    return write_ecl_scientific(out, value, 7, 'E', false);
+}
+
+char* format_doub_ecl(char* out, const double value)
+{
+    if (auto* end = write_special(out, value, "0.00000000000000D+00"))
+        return end;
+
+    return write_ecl_scientific(out, value, 13, 'D', true);
+}
+
+// The IX style is plain %E, with at least two exponent digits.
+char* format_ix(char* out, const double value, const int precision)
+{
+    auto* end = write_scientific(out, out + formatted_buffer_size, value, precision);
+
+    std::replace(out, end, 'e', 'E');
+    return end;
+}
+
+char* format_real_ix(char* out, const float value)
+{
+    if (auto* end = write_special(out, value, " 0.0000000E+00"))
+        return end;
+
+    return format_ix(out, value, 7);
+}
+
+char* format_doub_ix(char* out, const double value)
+{
+    if (auto* end = write_special(out, value, " 0.0000000000000E+00"))
+        return end;
+
+    return format_ix(out, value, 13);
+}
+
+char* format_element(char* out, const int value, bool)
+{
+    return std::to_chars(out, out + formatted_buffer_size, value).ptr;
+}
+
+char* format_element(char* out, const float value, const bool ix)
+{
+    return ix ? format_real_ix(out, value) : format_real_ecl(out, value);
+}
+
+char* format_element(char* out, const double value, const bool ix)
+{
+    return ix ? format_doub_ix(out, value) : format_doub_ecl(out, value);
+}
+
+char* format_element(char* out, const bool value, bool)
+{
+    return write_string(out, value ? "  T" : "  F");
+}
+
+char* format_element(char* out, char, bool)
+{
+    return out;
+}
+
+} // Anonymous namespace
+
 namespace Opm { namespace EclIO {
 
 EclOutput::EclOutput(const std::string&            filename,
@@ -456,139 +608,39 @@ void EclOutput::writeFormattedHeader(const std::string& arrName, int size, eclAr
 
 std::string EclOutput::make_real_string_ecl(float value) const
 {
-    constexpr std::size_t buf_size = 15;
-    char buffer [buf_size];
-    std::snprintf (buffer, sizeof buffer, "%10.7E", value);
-
-    if (value == 0.0) {
-        return "0.00000000E+00";
-    } else {
-        if (std::isnan(value))
-            return "NAN";
-
-        if (std::isinf(value)) {
-            if (value > 0)
-                return "INF";
-            else
-                return "-INF";
-        }
-
-        std::string tmpstr(buffer);
-
-        int exp =  value < 0.0 ? std::stoi(tmpstr.substr(11, 3)) :  std::stoi(tmpstr.substr(10, 3));
-
-        if (value < 0.0) {
-            tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 7) + "E";
-        } else {
-            tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 7) +"E";
-        }
-
-        std::snprintf (buffer, sizeof buffer, "%+03i", exp+1);
-        tmpstr = tmpstr+buffer;
-
-        return tmpstr;
-    }
+    char buffer[formatted_buffer_size];
+    return { buffer, format_real_ecl(buffer, value) };
 }
 
 std::string EclOutput::make_real_string_ix(float value) const
 {
-    constexpr std::size_t buf_size = 15;
-    char buffer [buf_size];
-    std::snprintf (buffer, sizeof buffer, "%10.7E", value);
-
-    if (value == 0.0) {
-        return " 0.0000000E+00";
-    } else {
-        if (std::isnan(value))
-            return "NAN";
-
-        if (std::isinf(value)) {
-            if (value > 0)
-                return "INF";
-            else
-                return "-INF";
-        }
-
-        std::string tmpstr(buffer);
-
-        return tmpstr;
-    }
+    char buffer[formatted_buffer_size];
+    return { buffer, format_real_ix(buffer, value) };
 }
 
 
 std::string EclOutput::make_doub_string_ecl(double value) const
 {
-    char buffer [21 + 1];
-    std::snprintf (buffer, sizeof buffer, "%19.13E", value);
-
-    if (value == 0.0) {
-        return "0.00000000000000D+00";
-    } else {
-        if (std::isnan(value))
-            return "NAN";
-
-        if (std::isinf(value)) {
-            if (value > 0)
-                return "INF";
-            else
-                return "-INF";
-        }
-
-        std::string tmpstr(buffer);
-        int exp = value < 0.0 ? std::stoi(tmpstr.substr(17, 4)) : std::stoi(tmpstr.substr(16, 4));
-        const bool use_exp_char = (exp >= -100) && (exp < 99);
-
-        if (value < 0.0) {
-            if (use_exp_char) {
-                tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 13) + "D";
-            } else {
-                tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 13);
-            }
-        } else {
-            if (use_exp_char) {
-                tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 13) + "D";
-            } else {
-                tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 13);
-            }
-        }
-
-        std::snprintf(buffer, sizeof buffer, "%+03i", exp + 1);
-        tmpstr = tmpstr + buffer;
-        return tmpstr;
-    }
+    char buffer[formatted_buffer_size];
+    return { buffer, format_doub_ecl(buffer, value) };
 }
 
 std::string EclOutput::make_doub_string_ix(double value) const
 {
-    char buffer [21];
-    std::snprintf (buffer, sizeof buffer, "%19.13E", value);
-
-    if (value == 0.0) {
-        return " 0.0000000000000E+00";
-    } else {
-        if (std::isnan(value))
-            return "NAN";
-
-        if (std::isinf(value)) {
-            if (value > 0)
-                return "INF";
-            else
-                return "-INF";
-        }
-
-        std::string tmpstr(buffer);
-
-        return tmpstr;
-    }
+    char buffer[formatted_buffer_size];
+    return { buffer, format_doub_ix(buffer, value) };
 }
 
 
+/*
+  The formatted array is written in ranges of whole blocks. The line
+  breaks only depend on the position within the block, so the ranges are
+  formatted independently - with num_threads threads - and written to the
+  file in order.
+*/
 template <typename T>
 void EclOutput::writeFormattedArray(const std::vector<T>& data)
 {
-    int size = data.size();
-    int n = 0;
-
     eclArrType arrType = MESS;
     if (typeid(T) == typeid(int)) {
         arrType = INTE;
@@ -600,54 +652,65 @@ void EclOutput::writeFormattedArray(const std::vector<T>& data)
         arrType = LOGI;
     }
 
-
     auto sizeData = block_size_data_formatted(arrType);
 
-    int maxBlockSize = std::get<0>(sizeData);
-    int nColumns = std::get<1>(sizeData);
-    int columnWidth = std::get<2>(sizeData);
-
-    for (int i = 0; i < size; i++) {
-        n++;
-
-        switch (arrType) {
-        case INTE:
-            ofileH << std::setw(columnWidth) << data[i];
-            break;
-        case REAL:
-            if (ix_standard)
-                ofileH << std::setw(columnWidth) << make_real_string_ix(data[i]);
-            else
-                ofileH << std::setw(columnWidth) << make_real_string_ecl(data[i]);
-            break;
-        case DOUB:
-            if (ix_standard)
-                ofileH << std::setw(columnWidth) << make_doub_string_ix(data[i]);
-            else
-                ofileH << std::setw(columnWidth) << make_doub_string_ecl(data[i]);
-            break;
-        case LOGI:
-            if (data[i]) {
-                ofileH << "  T";
-            } else {
-                ofileH << "  F";
+    const std::size_t maxBlockSize = std::get<0>(sizeData);
+    const std::size_t nColumns = std::get<1>(sizeData);
+    const int columnWidth = std::get<2>(sizeData);
+
+    auto format_range = [&data, maxBlockSize, nColumns, columnWidth, ix = this->ix_standard]
+        (const std::size_t begin, const std::size_t end)
+    {
+        std::string text;
+        text.reserve((end - begin) * (columnWidth + 1) + 1);
+
+        char buffer[formatted_buffer_size];
+        std::size_t n = 0;
+        for (std::size_t i = begin; i < end; i++) {
+            n++;
+
+            const auto length = format_element(buffer, data[i], ix) - buffer;
+            if (length < columnWidth)
+                text.append(columnWidth - length, ' ');
+
+            text.append(buffer, length);
+
+            if ((n % nColumns) == 0 || (n % maxBlockSize) == 0) {
+                text.push_back('\n');
+            }
+
+            if ((n % maxBlockSize) == 0) {
+                n=0;
             }
-            break;
-        default:
-            break;
         }
 
-        if ((n % nColumns) == 0 || (n % maxBlockSize) == 0) {
-            ofileH << std::endl;
+        if ((n % nColumns) != 0 && (n % maxBlockSize) != 0) {
+            text.push_back('\n');
         }
 
-        if ((n % maxBlockSize) == 0) {
-            n=0;
+        return text;
+    };
+
+    const std::size_t size = data.size();
+    const std::size_t range_size = formatted_blocks_per_range * maxBlockSize;
+
+    for (std::size_t begin = 0; begin < size; begin += num_threads * range_size) {
+        if (num_threads == 1) {
+            ofileH << format_range(begin, std::min(begin + range_size, size));
+            continue;
+        }
+
+        std::vector<std::future<std::string>> ranges;
+        for (std::size_t range_begin = begin;
+             (range_begin < size) && (ranges.size() < num_threads);
+             range_begin += range_size)
+        {
+            ranges.push_back(std::async(std::launch::async, format_range, range_begin,
+                                        std::min(range_begin + range_size, size)));
         }
-    }
 
-    if ((n % nColumns) != 0 && (n % maxBlockSize) != 0) {
-        ofileH << std::endl;
+        for (auto& range : ranges)
+            ofileH << range.get();
     }
 }
 
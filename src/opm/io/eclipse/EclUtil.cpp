@@ -16,16 +16,24 @@
    along with OPM.  If not, see <http://www.gnu.org/licenses/>.
    */
 
+#include <config.h>
 #include <opm/io/eclipse/EclUtil.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
 
 #include <algorithm>
 #include <array>
+#include <cctype>
+#include <charconv>
 #include <stdexcept>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
 #include <fstream>
+#include <future>
 #include <cstring>
+#include <type_traits>
 
 int Opm::EclIO::flipEndianInt(int num)
 {
@@ -414,6 +422,84 @@ void Opm::EclIO::readFormattedHeader(std::fstream& fileH, std::string& arrName,
     }
 }
 
+namespace {
+
+/*
+  Converts an array of big endian numbers to host byte order in place. The
+  loop has no calls and no branches, so the compiler will vectorize it.
+*/
+template<typename T>
+void flipEndianArray(T* data, std::size_t size)
+{
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+    using Word = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+    auto* bytes = reinterpret_cast<char*>(data);
+    for (std::size_t i = 0; i < size; i++) {
+        Word word;
+        std::memcpy(&word, bytes + i*sizeof(T), sizeof(T));
+        if constexpr (sizeof(T) == 4)
+            word = __builtin_bswap32(word);
+        else
+            word = __builtin_bswap64(word);
+        std::memcpy(bytes + i*sizeof(T), &word, sizeof(T));
+    }
+}
+
+/*
+  Reads a binary array of INTE, REAL or DOUB values. The payload of each
+  Fortran record is read straight into the result vector, and the byte
+  order is converted in one pass over the complete array afterwards.
+*/
+template<typename T>
+std::vector<T> readBinaryNumericArray(std::fstream& fileH, const int64_t size, Opm::EclIO::eclArrType type)
+{
+    const auto [sizeOfElement, maxBlockSize] = Opm::EclIO::block_size_data_binary(type);
+
+    if (sizeOfElement != static_cast<int>(sizeof(T)))
+        OPM_THROW(std::logic_error, "Element size does not match array type");
+
+    const int maxNumberOfElements = maxBlockSize / sizeOfElement;
+
+    std::vector<T> arr(size);
+    int64_t rest = size;
+    int64_t pos = 0;
+
+    while (rest > 0) {
+        int dhead;
+        fileH.read(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+        dhead = Opm::EclIO::flipEndianInt(dhead);
+        const int num = dhead / sizeOfElement;
+
+        if ((num > maxNumberOfElements) || (num < 0) || (num > rest)) {
+            OPM_THROW(std::runtime_error, "Error reading binary data, inconsistent header data or incorrect number of elements");
+        }
+
+        fileH.read(reinterpret_cast<char*>(arr.data() + pos), static_cast<std::streamsize>(num) * sizeof(T));
+
+        pos += num;
+        rest -= num;
+
+        if (num < maxNumberOfElements && rest != 0) {
+            std::string message = "Error reading binary data, incorrect number of elements";
+            OPM_THROW(std::runtime_error, message);
+        }
+
+        int dtail;
+        fileH.read(reinterpret_cast<char*>(&dtail), sizeof(dtail));
+        dtail = Opm::EclIO::flipEndianInt(dtail);
+
+        if (dhead != dtail) {
+            OPM_THROW(std::runtime_error, "Error reading binary data, tail not matching header.");
+        }
+    }
+
+    flipEndianArray(arr.data(), arr.size());
+    return arr;
+}
+
+}
+
 template<typename T, typename T2>
 std::vector<T> Opm::EclIO::readBinaryArray(std::fstream& fileH, const int64_t size, Opm::EclIO::eclArrType type,
                                std::function<T(T2)>& flip, int elementSize)
@@ -483,22 +569,19 @@ std::vector<T> Opm::EclIO::readBinaryArray(std::fstream& fileH, const int64_t si
 
 std::vector<int> Opm::EclIO::readBinaryInteArray(std::fstream &fileH, const int64_t size)
 {
-    std::function<int(int)> f = Opm::EclIO::flipEndianInt;
-    return readBinaryArray<int,int>(fileH, size, Opm::EclIO::INTE, f, sizeOfInte);
+    return readBinaryNumericArray<int>(fileH, size, Opm::EclIO::INTE);
 }
 
 
 std::vector<float> Opm::EclIO::readBinaryRealArray(std::fstream& fileH, const int64_t size)
 {
-    std::function<float(float)> f = Opm::EclIO::flipEndianFloat;
-    return readBinaryArray<float,float>(fileH, size, Opm::EclIO::REAL, f, sizeOfReal);
+    return readBinaryNumericArray<float>(fileH, size, Opm::EclIO::REAL);
 }
 
 
 std::vector<double> Opm::EclIO::readBinaryDoubArray(std::fstream& fileH, const int64_t size)
 {
-    std::function<double(double)> f = Opm::EclIO::flipEndianDouble;
-    return readBinaryArray<double,double>(fileH, size, Opm::EclIO::DOUB, f, sizeOfDoub);
+    return readBinaryNumericArray<double>(fileH, size, Opm::EclIO::DOUB);
 }
 
 std::vector<bool> Opm::EclIO::readBinaryLogiArray(std::fstream &fileH, const int64_t size)
@@ -554,6 +637,203 @@ std::vector<std::string> Opm::EclIO::readBinaryC0nnArray(std::fstream& fileH, co
 }
 
 
+namespace {
+
+constexpr int64_t min_parallel_formatted_size = 1 << 16;
+
+bool isFormattedSpace(const char c)
+{
+    return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t');
+}
+
+bool parseFormattedValue(const char* first, const char* last, int& value)
+{
+    if ((first != last) && (*first == '+'))
+        ++first;
+
+    const auto [ptr, ec] = std::from_chars(first, last, value);
+    return (ec == std::errc{}) && (ptr == last);
+}
+
+/*
+  Numbers may use D as exponent character, and the exponent character is
+  left out in double precision values with three digit exponents, e.g.
+  0.10000000000000-100. The token is copied to a buffer with a regular E
+  exponent before it is converted.
+*/
+bool parseFormattedValue(const char* first, const char* last, double& value)
+{
+    std::array<char, 64> buffer;
+    if (last - first + 2 > static_cast<std::ptrdiff_t>(buffer.size()))
+        return false;
+
+    if ((first != last) && (*first == '+'))
+        ++first;
+
+    char* out = buffer.data();
+    bool has_exp = false;
+    for (const char* c = first; c != last; ++c) {
+        if ((*c == 'D') || (*c == 'd') || (*c == 'E') || (*c == 'e')) {
+            *out++ = 'E';
+            has_exp = true;
+        } else {
+            if (!has_exp && (c != first) && ((*c == '-') || (*c == '+'))
+                && std::isdigit(static_cast<unsigned char>(c[-1])))
+            {
+                *out++ = 'E';
+                has_exp = true;
+            }
+            *out++ = *c;
+        }
+    }
+    *out = '\0';
+
+#if HAVE_FLOATING_POINT_CHARCONV
+    const auto [ptr, ec] = std::from_chars(buffer.data(), out, value);
+    if (ec == std::errc::result_out_of_range) {
+        // Denormals and values outside the double range.
+        value = std::strtod(buffer.data(), nullptr);
+        return true;
+    }
+
+    return (ec == std::errc{}) && (ptr == out);
+#else
+    char* end = nullptr;
+    value = std::strtod(buffer.data(), &end);
+    return (out != buffer.data()) && (end == out);
+#endif
+}
+
+// Values outside the float range are accepted, they are written by OPM Flow.
+bool parseFormattedValue(const char* first, const char* last, float& value)
+{
+    double dvalue;
+    if (!parseFormattedValue(first, last, dvalue))
+        return false;
+
+    value = static_cast<float>(dvalue);
+    return true;
+}
+
+bool parseFormattedValue(const char* first, const char*, bool& value)
+{
+    if (*first == 'T')
+        value = true;
+    else if (*first == 'F')
+        value = false;
+    else
+        return false;
+
+    return true;
+}
+
+/*
+  Parses at most max_count whitespace separated values from [first, last)
+  and appends them to values. An invalid value is an error, unless
+  stop_at_invalid is true in which case parsing ends there.
+*/
+template<typename T>
+void parseFormattedValues(const char* first, const char* last, const int64_t max_count,
+                          const bool stop_at_invalid, std::vector<T>& values)
+{
+    int64_t count = 0;
+    while (count < max_count) {
+        while ((first != last) && isFormattedSpace(*first))
+            ++first;
+
+        if (first == last)
+            break;
+
+        const char* token_end = first;
+        while ((token_end != last) && !isFormattedSpace(*token_end))
+            ++token_end;
+
+        T value;
+        if (!parseFormattedValue(first, token_end, value)) {
+            if (stop_at_invalid)
+                break;
+
+            std::string message = "Could not convert '" + std::string(first, token_end) + "' to a numeric value";
+            if constexpr (std::is_same_v<T, bool>)
+                message = "Could not convert '" + std::string(first, token_end) + "' to a bool value ";
+
+            OPM_THROW(std::invalid_argument, message);
+        }
+
+        values.push_back(value);
+        first = token_end;
+        ++count;
+    }
+}
+
+/*
+  Reads size values of a formatted INTE, REAL, DOUB or LOGI array. Large
+  arrays are split at line boundaries and the parts are parsed on separate
+  threads. All parts but the last must then consist of array values only,
+  the last part is allowed to continue past the end of the array.
+*/
+template<typename T>
+std::vector<T> readFormattedValues(const std::string& file_str, const int64_t size,
+                                   const int64_t fromPos, const std::size_t num_threads)
+{
+    const char* first = file_str.data() + fromPos;
+    const char* last = file_str.data() + file_str.size();
+
+    std::vector<T> arr;
+
+    if ((num_threads < 2) || (size < min_parallel_formatted_size)) {
+        arr.reserve(size);
+        parseFormattedValues(first, last, size, false, arr);
+    } else {
+        std::vector<const char*> bounds { first };
+        const auto part_size = (last - first) / static_cast<std::ptrdiff_t>(num_threads);
+        for (std::size_t part = 1; part < num_threads; part++) {
+            const char* bound = std::max(bounds.back(), first + part * part_size);
+            const void* eol = std::memchr(bound, '\n', last - bound);
+            bounds.push_back(eol ? static_cast<const char*>(eol) + 1 : last);
+        }
+        bounds.push_back(last);
+
+        std::vector<std::vector<T>> parts(num_threads);
+        std::vector<std::future<void>> workers;
+        for (std::size_t part = 0; part < num_threads; part++) {
+            const bool is_last = (part + 1) == num_threads;
+            workers.push_back(std::async(std::launch::async,
+                [&parts, &bounds, part, is_last, size]()
+                {
+                    parseFormattedValues(bounds[part], bounds[part + 1], size, is_last, parts[part]);
+                }));
+        }
+
+        std::exception_ptr error;
+        for (auto& worker : workers) {
+            try {
+                worker.get();
+            } catch (...) {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+
+        arr.reserve(size);
+        for (const auto& part : parts) {
+            const auto num = std::min<int64_t>(part.size(), size - arr.size());
+            arr.insert(arr.end(), part.begin(), part.begin() + num);
+        }
+    }
+
+    if (static_cast<int64_t>(arr.size()) != size)
+        OPM_THROW(std::runtime_error, "Error reading formatted data, unexpected end of array");
+
+    return arr;
+}
+
+}
+
+
 template<typename T>
 std::vector<T> Opm::EclIO::readFormattedArray(const std::string& file_str, const int size, int64_t fromPos,
                                  std::function<T(const std::string&)>& process)
@@ -577,15 +857,10 @@ std::vector<T> Opm::EclIO::readFormattedArray(const std::string& file_str, const
 }
 
 
-std::vector<int> Opm::EclIO::readFormattedInteArray(const std::string& file_str, const int64_t size, int64_t fromPos)
+std::vector<int> Opm::EclIO::readFormattedInteArray(const std::string& file_str, const int64_t size, int64_t fromPos,
+                                                    std::size_t num_threads)
 {
-
-    std::function<int(const std::string&)> f = [](const std::string& val)
-                                               {
-                                                   return std::stoi(val);
-                                               };
-
-    return readFormattedArray(file_str, size, fromPos, f);
+    return readFormattedValues<int>(file_str, size, fromPos, num_threads);
 }
 
 
@@ -614,18 +889,10 @@ std::vector<std::string> Opm::EclIO::readFormattedCharArray(const std::string& f
 }
 
 
-std::vector<float> Opm::EclIO::readFormattedRealArray(const std::string& file_str, const int64_t size, int64_t fromPos)
+std::vector<float> Opm::EclIO::readFormattedRealArray(const std::string& file_str, const int64_t size, int64_t fromPos,
+                                                      std::size_t num_threads)
 {
-
-    std::function<float(const std::string&)> f = [](const std::string& val)
-                                                 {
-                                                     // tskille: temporary fix, need to be discussed. OPM flow writes numbers
-                                                     // that are outside valid range for float, and function stof will fail
-                                                     double dtmpv = std::stod(val);
-                                                     return dtmpv;
-                                                 };
-
-    return readFormattedArray<float>(file_str, size, fromPos, f);
+    return readFormattedValues<float>(file_str, size, fromPos, num_threads);
 }
 
 std::vector<std::string> Opm::EclIO::readFormattedRealRawStrings(const std::string& file_str, const int64_t size, int64_t fromPos)
@@ -641,46 +908,15 @@ std::vector<std::string> Opm::EclIO::readFormattedRealRawStrings(const std::stri
 }
 
 
-std::vector<bool> Opm::EclIO::readFormattedLogiArray(const std::string& file_str, const int64_t size, int64_t fromPos)
+std::vector<bool> Opm::EclIO::readFormattedLogiArray(const std::string& file_str, const int64_t size, int64_t fromPos,
+                                                     std::size_t num_threads)
 {
-
-    std::function<bool(const std::string&)> f = [](const std::string& val)
-                                                {
-                                                    if (val[0] == 'T') {
-                                                        return true;
-                                                    } else if (val[0] == 'F') {
-                                                        return false;
-                                                    } else {
-                                                        std::string message="Could not convert '" + val + "' to a bool value ";
-                                                        OPM_THROW(std::invalid_argument, message);
-                                                    }
-                                                };
-
-    return readFormattedArray<bool>(file_str, size, fromPos, f);
+    return readFormattedValues<bool>(file_str, size, fromPos, num_threads);
 }
 
-std::vector<double> Opm::EclIO::readFormattedDoubArray(const std::string& file_str, const int64_t size, int64_t fromPos)
+std::vector<double> Opm::EclIO::readFormattedDoubArray(const std::string& file_str, const int64_t size, int64_t fromPos,
+                                                       std::size_t num_threads)
 {
-
-    std::function<double(const std::string&)> f = [](std::string val)
-                                                  {
-                                                      auto p1 = val.find_first_of("D");
-
-                                                      if (p1 != std::string::npos) {
-                                                          val.replace(p1,1,"E");
-                                                      }
-
-                                                      p1 = val.find_first_of("E");
-
-                                                      if (p1 == std::string::npos) {
-                                                          auto p2 = val.find_first_of("-+", 1);
-
-                                                          if (p2 != std::string::npos)
-                                                              val = val.insert(p2,"E");
-                                                      }
-                                                      return std::stod(val);
-                                                  };
-
-    return readFormattedArray<double>(file_str, size, fromPos, f);
+    return readFormattedValues<double>(file_str, size, fromPos, num_threads);
 }
 
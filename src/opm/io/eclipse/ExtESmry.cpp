@@ -23,6 +23,7 @@
 #include <opm/common/utility/shmatch.hpp>
 #include <opm/io/eclipse/EclFile.hpp>
 #include <opm/io/eclipse/EclUtil.hpp>
+#include <opm/io/eclipse/SmryCompression.hpp>
 
 #include <algorithm>
 #include <numeric>
@@ -62,6 +63,147 @@ Opm::time_point make_date(const std::vector<int>& datetime) {
     return Opm::TimeService::from_time_t( Opm::asTimeT(ts) );
 }
 
+// size of a binary array including the 24 byte header
+uint64_t arraySizeOnDisk(int64_t num, Opm::EclIO::eclArrType arrType, int elementSize)
+{
+    return 24 + Opm::EclIO::sizeOnDiskBinary(num, arrType, elementSize);
+}
+
+// Reads num elements, starting at element from, of the binary INTE array
+// with header at position arr_pos.
+
+std::vector<int> readBinaryInteSlice(std::fstream& fileH, uint64_t arr_pos, int64_t from, int64_t num)
+{
+    std::vector<int> result(num);
+
+    int64_t n = 0;
+
+    while (n < num) {
+        const int64_t block = (from + n) / Opm::EclIO::MaxNumBlockInte;
+        const int64_t in_block = (from + n) % Opm::EclIO::MaxNumBlockInte;
+        const int64_t count = std::min(num - n, Opm::EclIO::MaxNumBlockInte - in_block);
+
+        const uint64_t pos = arr_pos + 24 + block * (Opm::EclIO::MaxBlockSizeInte + 8) + 4 + in_block * Opm::EclIO::sizeOfInte;
+
+        fileH.seekg(static_cast<std::streamoff>(pos), std::ios_base::beg);
+        fileH.read(reinterpret_cast<char*>(result.data() + n), count * Opm::EclIO::sizeOfInte);
+
+        n += count;
+    }
+
+    if (!fileH)
+        throw std::runtime_error("Error reading compressed summary data");
+
+    for (auto& value : result)
+        value = Opm::EclIO::flipEndianInt(value);
+
+    return result;
+}
+
+// Checks that the VINDEX array of a compressed chunk, with the start of each
+// of the num_vect vectors in VDATA, is consistent with the size of VDATA.
+
+void check_vindex(const std::vector<int>& vindex, std::size_t num_vect, int64_t vdata_size)
+{
+    if (vindex.size() != num_vect + 1)
+        throw std::runtime_error("Invalid size of VINDEX array in compressed summary data");
+
+    if ((vindex.front() < 0) || !std::is_sorted(vindex.begin(), vindex.end()) || (vindex.back() > vdata_size))
+        throw std::runtime_error("Invalid VINDEX array in compressed summary data");
+}
+
+// Reads RSTEP and TSTEP from all chunks of an ESMRY file written in chunks, see
+// ExtSmryOutput and SmryCompression.hpp. The file stream should be positioned
+// after the header of the first CHUNK array. A chunk which is only partly
+// written, i.e. from an active run or a run which was stopped, is ignored.
+// On return chunks_end is the file offset after the last complete chunk.
+
+bool read_esmry_chunks(std::fstream& fileH, const std::filesystem::path& inputFileName, int64_t arr_size,
+                       std::size_t num_vect, std::vector<int>& rstep, std::vector<int>& tstep,
+                       std::vector<Opm::EclIO::SmryChunkEntry>& chunks, uint64_t& chunks_end)
+{
+    using Opm::EclIO::SmryCodec;
+
+    const auto file_size = static_cast<uint64_t>(std::filesystem::file_size(inputFileName));
+
+    std::string arrName;
+    Opm::EclIO::eclArrType arrType;
+    int sizeOfElement;
+
+    while (true) {
+
+        if ((arr_size != 2) && (arr_size != 3))
+            OPM_THROW(std::invalid_argument, "reading CHUNK, invalid esmry file " + inputFileName.string() );
+
+        if (static_cast<uint64_t>(fileH.tellg()) + Opm::EclIO::sizeOnDiskBinary(arr_size, Opm::EclIO::INTE, Opm::EclIO::sizeOfInte) > file_size)
+            break;
+
+        const auto chunk = Opm::EclIO::readBinaryInteArray(fileH, arr_size);
+
+        if (static_cast<std::size_t>(chunk[1]) != num_vect)
+            OPM_THROW(std::invalid_argument, "reading CHUNK, invalid esmry file " + inputFileName.string() );
+
+        const int64_t num_tstep = chunk[0];
+        const int codec = arr_size == 3 ? chunk[2] : static_cast<int>(SmryCodec::None);
+
+        const uint64_t vect_offset = static_cast<uint64_t>(fileH.tellg())
+            + 2 * arraySizeOnDisk(num_tstep, Opm::EclIO::INTE, Opm::EclIO::sizeOfInte);
+
+        uint64_t chunk_end = vect_offset;
+
+        if (codec == static_cast<int>(SmryCodec::None)) {
+            chunk_end += num_vect * arraySizeOnDisk(num_tstep, Opm::EclIO::REAL, Opm::EclIO::sizeOfReal);
+
+        } else if (codec == static_cast<int>(SmryCodec::XorFloat)) {
+            // size of VDATA is found from its header
+            chunk_end += arraySizeOnDisk(num_vect + 1, Opm::EclIO::INTE, Opm::EclIO::sizeOfInte);
+
+            if (chunk_end + 24 > file_size)
+                break;
+
+            const auto pos = fileH.tellg();
+            fileH.seekg(static_cast<std::streamoff>(chunk_end), std::ios_base::beg);
+            Opm::EclIO::readBinaryHeader(fileH, arrName, arr_size, arrType, sizeOfElement);
+
+            if ((arrName != "VDATA   ") or (arrType != Opm::EclIO::INTE))
+                OPM_THROW(std::invalid_argument, "reading VDATA, invalid esmry file " + inputFileName.string() );
+
+            chunk_end += arraySizeOnDisk(arr_size, Opm::EclIO::INTE, Opm::EclIO::sizeOfInte);
+            fileH.seekg(pos);
+
+        } else {
+            OPM_THROW(std::invalid_argument, "unknown compression in esmry file " + inputFileName.string() );
+        }
+
+        if (chunk_end > file_size)
+            break;
+
+        for (auto* steps : {&rstep, &tstep}) {
+            Opm::EclIO::readBinaryHeader(fileH, arrName, arr_size, arrType, sizeOfElement);
+
+            if ((arr_size != num_tstep) or (arrType != Opm::EclIO::INTE))
+                OPM_THROW(std::invalid_argument, "reading chunk, invalid esmry file " + inputFileName.string() );
+
+            const auto steps_chunk = Opm::EclIO::readBinaryInteArray(fileH, arr_size);
+            steps->insert(steps->end(), steps_chunk.begin(), steps_chunk.end());
+        }
+
+        chunks.emplace_back(vect_offset, num_tstep, codec);
+        chunks_end = chunk_end;
+
+        if (chunk_end + 24 > file_size)
+            break;
+
+        fileH.seekg(static_cast<std::streamoff>(chunk_end), std::ios_base::beg);
+        Opm::EclIO::readBinaryHeader(fileH, arrName, arr_size, arrType, sizeOfElement);
+
+        if ((arrName != "CHUNK   ") or (arrType != Opm::EclIO::INTE))
+            OPM_THROW(std::invalid_argument, "reading CHUNK, invalid esmry file " + inputFileName.string() );
+    }
+
+    return !chunks.empty();
+}
+
 
 }
 
@@ -116,13 +258,14 @@ ExtESmry::ExtESmry(const std::string &filename, bool loadBaseRunData) :
     ExtSmryHeadType ext_esmry_head;
 
     uint64_t rstep_offset;
+    std::vector<SmryChunkEntry> chunks;
 
-    bool res = open_esmry(m_inputFileName, ext_esmry_head, rstep_offset);
+    bool res = open_esmry(m_inputFileName, ext_esmry_head, rstep_offset, chunks, m_chunks_end);
     int n_attempts = 1;
 
     while ((!res) && (n_attempts < 10)){
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        res = open_esmry(m_inputFileName, ext_esmry_head, rstep_offset);
+        res = open_esmry(m_inputFileName, ext_esmry_head, rstep_offset, chunks, m_chunks_end);
         n_attempts ++;
     }
 
@@ -131,6 +274,7 @@ ExtESmry::ExtESmry(const std::string &filename, bool loadBaseRunData) :
 
     m_startdat = std::get<0>(ext_esmry_head);
     m_rstep_offset.push_back(rstep_offset);
+    m_chunks.push_back(chunks);
 
     std::map<std::string, int> key_index;
 
@@ -174,10 +318,13 @@ ExtESmry::ExtESmry(const std::string &filename, bool loadBaseRunData) :
 
             m_esmry_files.push_back(rstESmryFile);
 
-            if (!open_esmry(rstESmryFile, ext_esmry_head, rstep_offset))
+            uint64_t chunks_end;
+
+            if (!open_esmry(rstESmryFile, ext_esmry_head, rstep_offset, chunks, chunks_end))
                 OPM_THROW( std::runtime_error, "when opening ESMRY file" + rstESmryFile.string() );
 
             m_rstep_offset.push_back(rstep_offset);
+            m_chunks.push_back(chunks);
 
             m_rstep_v.push_back(std::get<4>(ext_esmry_head));
             m_tstep_v.push_back(std::get<5>(ext_esmry_head));
@@ -238,6 +385,90 @@ ExtESmry::ExtESmry(const std::string &filename, bool loadBaseRunData) :
 }
 
 
+std::size_t ExtESmry::update()
+{
+    if (m_chunks[0].empty())
+        return 0;
+
+    auto start = std::chrono::system_clock::now();
+
+    const auto file_size = static_cast<uint64_t>(std::filesystem::file_size(m_inputFileName));
+
+    if (m_chunks_end + 24 > file_size)
+        return 0;
+
+    std::fstream fileH;
+
+    fileH.open(m_inputFileName, std::ios::in |  std::ios::binary);
+
+    if (!fileH)
+        return 0;
+
+    std::string arrName;
+    int64_t arr_size;
+    Opm::EclIO::eclArrType arrType;
+    int sizeOfElement;
+
+    std::vector<int> rstep;
+    std::vector<int> tstep;
+    std::vector<SmryChunkEntry> chunks;
+    uint64_t chunks_end = m_chunks_end;
+
+    try {
+        fileH.seekg(static_cast<std::streamoff>(m_chunks_end), std::ios_base::beg);
+        Opm::EclIO::readBinaryHeader(fileH, arrName, arr_size, arrType, sizeOfElement);
+
+        if ((arrName != "CHUNK   ") or (arrType != Opm::EclIO::INTE))
+            OPM_THROW(std::invalid_argument, "reading CHUNK, invalid esmry file " + m_inputFileName.string() );
+
+        if (!read_esmry_chunks(fileH, m_inputFileName, arr_size, m_keyword_index[0].size(), rstep, tstep, chunks, chunks_end))
+            return 0;
+
+    } catch (const std::runtime_error& error)
+    {
+        return 0;
+    }
+
+    fileH.close();
+
+    const std::size_t first_chunk = m_chunks[0].size();
+    m_chunks[0].insert(m_chunks[0].end(), chunks.begin(), chunks.end());
+
+    // the new time steps are appended to the vectors which are already loaded
+    std::vector<int> keyIndexVect;
+
+    for (size_t n = 0; n < m_nVect; n++)
+        if (m_vectorLoaded[n])
+            keyIndexVect.push_back(static_cast<int>(n));
+
+    if (!keyIndexVect.empty() &&
+        !load_esmry(m_keyword, keyIndexVect, keyIndexVect, 0, static_cast<int>(rstep.size()) - 1, first_chunk)) {
+
+        m_chunks[0].resize(first_chunk);
+        return 0;
+    }
+
+    m_chunks_end = chunks_end;
+
+    m_rstep_v[0].insert(m_rstep_v[0].end(), rstep.begin(), rstep.end());
+    m_tstep_v[0].insert(m_tstep_v[0].end(), tstep.begin(), tstep.end());
+    m_nTstep_v[0] = m_tstep_v[0].size();
+    m_tstep_range[0] = std::make_tuple(0, m_tstep_v[0].size() - 1);
+
+    for (size_t n = 0; n < rstep.size(); n++)
+        if (rstep[n] == 1)
+            m_seqIndex.push_back(m_nTstep + n);
+
+    m_rstep.insert(m_rstep.end(), rstep.begin(), rstep.end());
+    m_tstep.insert(m_tstep.end(), tstep.begin(), tstep.end());
+    m_nTstep = m_rstep.size();
+
+    std::chrono::duration<double> elapsed_seconds = std::chrono::system_clock::now() - start;
+    m_io_loading += elapsed_seconds.count();
+
+    return rstep.size();
+}
+
 std::vector<float> ExtESmry::get_at_rstep(const std::string& name)
 {
     auto full_vect = this->get(name);
@@ -268,7 +499,8 @@ bool ExtESmry::all_steps_available()
     return true;
 }
 
-bool ExtESmry::open_esmry(const std::filesystem::path& inputFileName, ExtSmryHeadType& ext_smry_head, uint64_t& rstep_offset)
+bool ExtESmry::open_esmry(const std::filesystem::path& inputFileName, ExtSmryHeadType& ext_smry_head, uint64_t& rstep_offset,
+                          std::vector<SmryChunkEntry>& chunks, uint64_t& chunks_end)
 {
     std::fstream fileH;
 
@@ -374,11 +606,29 @@ bool ExtESmry::open_esmry(const std::filesystem::path& inputFileName, ExtSmryHea
         return false;
     }
 
+    std::vector<int> rstep;
+    std::vector<int> tstep;
+
+    chunks.clear();
+
+    if (arrName == "CHUNK   ") {
+
+        try {
+            if (!read_esmry_chunks(fileH, inputFileName, arr_size, keywords.size(), rstep, tstep, chunks, chunks_end))
+                return false;
+        } catch (const std::runtime_error& error)
+        {
+            return false;
+        }
+
+        ext_smry_head = std::make_tuple(startdat, rst_entry, keywords, units, rstep, tstep);
+
+        return true;
+    }
+
     if ((arrName != "RSTEP   ") or (arrType != Opm::EclIO::INTE))
         OPM_THROW(std::invalid_argument, "Reading RSTEP, invalid esmry file " + inputFileName.string() );
 
-    std::vector<int> rstep;
-
     try {
         rstep = Opm::EclIO::readBinaryInteArray(fileH, arr_size);
     } catch (const std::runtime_error& error)
@@ -396,8 +646,6 @@ bool ExtESmry::open_esmry(const std::filesystem::path& inputFileName, ExtSmryHea
     if ((arrName != "TSTEP   ") or (arrType != Opm::EclIO::INTE))
         OPM_THROW(std::invalid_argument, "reading TSTEP, invalid esmry file " + inputFileName.string() );
 
-    std::vector<int> tstep;
-
     try {
         tstep = Opm::EclIO::readBinaryInteArray(fileH, arr_size);
     } catch (const std::runtime_error& error)
@@ -426,7 +674,7 @@ void ExtESmry::updatePathAndRootName(std::filesystem::path& dir, std::filesystem
 
 
 bool ExtESmry::load_esmry(const std::vector<std::string>& stringVect, const std::vector<int>& keyIndexVect,
-                               const std::vector<int>& loadKeyIndex, int ind, int to_ind )
+                               const std::vector<int>& loadKeyIndex, int ind, int to_ind, std::size_t first_chunk)
 {
     std::fstream fileH;
 
@@ -437,75 +685,121 @@ bool ExtESmry::load_esmry(const std::vector<std::string>& stringVect, const std:
 
     std::string arrName;
     Opm::EclIO::eclArrType arrType;
-    int64_t num_tstep;
     int sizeOfElement;
 
-    // Read actual number of time steps on disk from RSTEP array before loading
-    // data. Notice that number of time steps can be different than what it was when
-    // the ESMRY file was opened. The simulation may have progressed if this is an
-    // ESMRY file from an active run
+    std::vector<SmryChunkEntry> chunks = m_chunks[ind];
 
-    fileH.seekg (m_rstep_offset[ind], fileH.beg);
+    if (chunks.empty()) {
 
-    try {
-        Opm::EclIO::readBinaryHeader(fileH, arrName, num_tstep, arrType, sizeOfElement);
-    } catch (const std::runtime_error& error)
-    {
-        return false;
-    }
+        // Read actual number of time steps on disk from RSTEP array before loading
+        // data. Notice that number of time steps can be different than what it was when
+        // the ESMRY file was opened. The simulation may have progressed if this is an
+        // ESMRY file from an active run
 
-    auto smry_arr_size = sizeOnDiskBinary(num_tstep, Opm::EclIO::REAL, sizeOfReal);
+        int64_t num_tstep;
 
-    std::vector<std::vector<float>> smry_data;
-    smry_data.resize(loadKeyIndex.size(), {});
+        fileH.seekg (m_rstep_offset[ind], fileH.beg);
 
-    for (size_t n = 0 ; n < loadKeyIndex.size(); n++) {
+        try {
+            Opm::EclIO::readBinaryHeader(fileH, arrName, num_tstep, arrType, sizeOfElement);
+        } catch (const std::runtime_error& error)
+        {
+            return false;
+        }
 
-        const auto& key = stringVect[loadKeyIndex[n]];
+        // adding size of TSTEP and RSTEP INTE data and binary headers
+        uint64_t pos = m_rstep_offset[ind] + 2 * arraySizeOnDisk(num_tstep, Opm::EclIO::INTE, sizeOfInte);
 
-        if ( m_keyword_index[ind].find(key) == m_keyword_index[ind].end() ) {
+        chunks.emplace_back(pos, num_tstep, static_cast<int>(SmryCodec::None));
+    }
 
-            smry_data[n].resize(to_ind + 1, 0.0 );
+    std::vector<std::vector<float>> smry_data;
+    smry_data.resize(loadKeyIndex.size(), {});
 
-        } else {
+    size_t num_loaded = 0;
 
-            int key_ind = m_keyword_index[ind].at(key);
+    try {
+        for (auto chunk = chunks.begin() + first_chunk; chunk != chunks.end(); ++chunk) {
+            const auto& [vect_offset, num_tstep, codec] = *chunk;
 
-            uint64_t pos = m_rstep_offset[ind] + smry_arr_size*static_cast<uint64_t>(key_ind);
+            if (num_loaded > static_cast<size_t>(to_ind))
+                break;
 
-            // adding size of TSTEP and RSTEP INTE data
-            pos = pos + 2 * sizeOnDiskBinary(num_tstep, Opm::EclIO::INTE, sizeOfInte);
+            std::vector<int> vindex;
+            uint64_t vdata_offset = 0;
 
-            pos = pos + static_cast<uint64_t>(2 * 24);  // adding size of binary headers (TSTEP and RSTEP)
-            pos = pos + static_cast<uint64_t>(key_ind * 24);  // adding size of binary headers
+            if (codec == static_cast<int>(SmryCodec::XorFloat)) {
+                int64_t size;
+
+                fileH.seekg (vect_offset, fileH.beg);
+                readBinaryHeader(fileH, arrName, size, arrType, sizeOfElement);
 
-            fileH.seekg (pos, fileH.beg);
+                if (arrName != "VINDEX  ")
+                    return false;
 
-            int64_t size;
+                vindex = readBinaryInteArray(fileH, size);
+                vdata_offset = static_cast<uint64_t>(fileH.tellg());
 
-            try {
                 readBinaryHeader(fileH, arrName, size, arrType, sizeOfElement);
-            } catch (const std::runtime_error& error)
-            {
-                return false;
+
+                if (arrName != "VDATA   ")
+                    return false;
+
+                check_vindex(vindex, m_keyword_index[ind].size(), size);
             }
 
-            arrName = Opm::EclIO::trimr(arrName);
+            for (size_t n = 0 ; n < loadKeyIndex.size(); n++) {
 
-            std::string checkName = "V" + std::to_string(key_ind);
+                const auto key_it = m_keyword_index[ind].find(stringVect[loadKeyIndex[n]]);
 
-            if (arrName != checkName)
-                return false;
+                if (key_it == m_keyword_index[ind].end())
+                    continue;
 
-            try {
-                smry_data[n] = readBinaryRealArray(fileH, size);
-            } catch (const std::runtime_error& error)
-            {
-                return false;
+                const int key_ind = key_it->second;
+
+                if (codec == static_cast<int>(SmryCodec::XorFloat)) {
+
+                    const auto words = readBinaryInteSlice(fileH, vdata_offset, vindex[key_ind],
+                                                           vindex[key_ind + 1] - vindex[key_ind]);
+
+                    decompressSmryVector(words.data(), words.size(), num_tstep, smry_data[n]);
+
+                } else {
+
+                    auto smry_arr_size = arraySizeOnDisk(num_tstep, Opm::EclIO::REAL, sizeOfReal);
+
+                    uint64_t pos = vect_offset + smry_arr_size*static_cast<uint64_t>(key_ind);
+
+                    fileH.seekg (pos, fileH.beg);
+
+                    int64_t size;
+
+                    readBinaryHeader(fileH, arrName, size, arrType, sizeOfElement);
+
+                    arrName = Opm::EclIO::trimr(arrName);
+
+                    if (arrName != "V" + std::to_string(key_ind))
+                        return false;
+
+                    auto chunk_data = readBinaryRealArray(fileH, size);
+                    smry_data[n].insert(smry_data[n].end(), chunk_data.begin(), chunk_data.end());
+                }
             }
+
+            num_loaded += num_tstep;
         }
+    } catch (const std::runtime_error& error)
+    {
+        return false;
     }
 
+    if (num_loaded <= static_cast<size_t>(to_ind))
+        return false;
+
+    for (size_t n = 0 ; n < loadKeyIndex.size(); n++)
+        if ( m_keyword_index[ind].find(stringVect[loadKeyIndex[n]]) == m_keyword_index[ind].end() )
+            smry_data[n].resize(to_ind + 1, 0.0 );
+
     fileH.close();
 
     for (size_t n = 0 ; n < loadKeyIndex.size(); n++)
@@ -600,9 +894,10 @@ std::vector<Opm::time_point> ExtESmry::dates() {
 std::vector<std::string> ExtESmry::keywordList(const std::string& pattern) const
 {
     std::vector<std::string> list;
+    const ShellPattern shell_pattern(pattern);
 
     for (const auto& key : m_keyword)
-        if (shmatch( pattern, key) )
+        if (shell_pattern.match(key))
             list.push_back(key);
 
     return list;
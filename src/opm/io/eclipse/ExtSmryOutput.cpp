@@ -20,6 +20,7 @@
 #include <opm/io/eclipse/EclFile.hpp>
 #include <opm/io/eclipse/ExtSmryOutput.hpp>
 #include <opm/io/eclipse/EclOutput.hpp>
+#include <opm/io/eclipse/SmryCompression.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 
 #include <opm/input/eclipse/EclipseState/EclipseState.hpp>
@@ -34,10 +35,11 @@ namespace Opm { namespace EclIO {
 
 
 ExtSmryOutput::ExtSmryOutput(const std::vector<std::string>& valueKeys, const std::vector<std::string>& valueUnits,
-                 const EclipseState& es, const time_t start_time)
+                 const EclipseState& es, const time_t start_time, bool compressed, bool chunked)
 {
     m_nVect = valueKeys.size();
     m_nTimeSteps = 0;
+    m_committed_size = 0;
     m_last_write = std::chrono::system_clock::now();
 
     IOConfig ioconf = es.getIOConfig();
@@ -53,6 +55,11 @@ ExtSmryOutput::ExtSmryOutput(const std::vector<std::string>& valueKeys, const st
     }
 
     m_fmt = es.cfg().io().getFMTOUT();
+    m_compressed = compressed;
+    m_chunked = chunked || compressed;
+
+    if ((m_chunked) && (m_fmt))
+        throw std::invalid_argument("The chunked ESMRY layout is only supported for unformatted output");
 
     auto dims = es.gridDims();
 
@@ -87,24 +94,58 @@ void ExtSmryOutput::write(const std::vector<float>& ts_data, int report_step, bo
     // flow is yet not supporting rptonly in summary
     // tstep = {0,1,2 .. , m_nTimeSteps-1}
 
-    if (m_tstep.size()==0)
-        m_tstep.push_back(0);
-    else
-        m_tstep.push_back(m_tstep.back()+1);
+    m_tstep.push_back(m_nTimeSteps);
 
     for (size_t n = 0; n < static_cast<size_t>(m_nVect); n++)
         m_smrydata[n].push_back(ts_data[n]);
 
-    if ((is_final_summary) || (elapsed_seconds.count() > m_min_write_interval))
+    // compressed chunks have a fixed size, time steps which do not fill a
+    // chunk are kept until the next write
+
+    std::size_t num_write = m_rstep.size();
+
+    if ((m_compressed) && (!is_final_summary))
+        num_write -= num_write % compressedSmryChunkSize;
+
+    if (!m_chunked) {
+        if ((is_final_summary) || (elapsed_seconds.count() > m_min_write_interval)) {
+            if (write_classic())
+                m_last_write = std::chrono::system_clock::now();
+            else
+                Opm::OpmLog::warning("Not able to write summary data to ESMRY file " + m_outputFileName);
+        }
+
+    } else if ((is_final_summary) || ((elapsed_seconds.count() > m_min_write_interval) && (num_write > 0)))
     {
-        const auto tp = std::chrono::system_clock::now();
-        auto sec_since_epoch = std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
+        if (write_chunk(num_write)) {
+            m_last_write = std::chrono::system_clock::now();
 
-        std::filesystem::path esmry_file(m_outputFileName);
-        std::filesystem::path rootName = esmry_file.parent_path() / esmry_file.stem();           
+            m_rstep.erase(m_rstep.begin(), m_rstep.begin() + num_write);
+            m_tstep.erase(m_tstep.begin(), m_tstep.begin() + num_write);
 
-        std::string tmp_file_name = rootName.string() + "_TMP_" + std::to_string(sec_since_epoch) + ".ESMRY";
-        
+            for (auto& smry_vect : m_smrydata)
+                smry_vect.erase(smry_vect.begin(), smry_vect.begin() + num_write);
+
+        } else {
+            // time steps are kept in memory and written with the next chunk
+            Opm::OpmLog::warning("Not able to write summary data to ESMRY file " + m_outputFileName);
+        }
+    }
+
+    m_nTimeSteps++;
+}
+
+bool ExtSmryOutput::write_classic()
+{
+    const auto tp = std::chrono::system_clock::now();
+    auto sec_since_epoch = std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
+
+    std::filesystem::path esmry_file(m_outputFileName);
+    std::filesystem::path rootName = esmry_file.parent_path() / esmry_file.stem();
+
+    std::string tmp_file_name = rootName.string() + "_TMP_" + std::to_string(sec_since_epoch) + ".ESMRY";
+
+    try {
         {
             Opm::EclIO::EclOutput outFile(tmp_file_name, m_fmt, std::ios::out);
 
@@ -127,31 +168,88 @@ void ExtSmryOutput::write(const std::vector<float>& ts_data, int report_step, bo
             }
         }
 
-        if (rename_tmpfile(tmp_file_name)){
-            m_last_write = std::chrono::system_clock::now();
-        } else {
-            Opm::OpmLog::warning("Not able to rename temporary ESMRY file " + tmp_file_name);
-            std::filesystem::path tmp_file(tmp_file_name);        
-            std::filesystem::remove(tmp_file);
-        }
+        std::filesystem::rename(std::filesystem::path(tmp_file_name), esmry_file);
+
+    } catch (...) {
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::path(tmp_file_name), ec);
+        return false;
     }
 
-    m_nTimeSteps++;
+    return true;
 }
 
-bool ExtSmryOutput::rename_tmpfile(const std::string& tmp_fname)
+bool ExtSmryOutput::write_chunk(std::size_t num_tstep)
 {
+    std::filesystem::path esmry_file(m_outputFileName);
+    std::uintmax_t chunk_size = 0;
+
     try {
-        std::filesystem::path from_file(tmp_fname);
-        std::filesystem::path to_file(m_outputFileName);
-        std::filesystem::rename(from_file, to_file);
-    } catch (...){
+        // remove what is left of a chunk from a failed write
+        if ((m_committed_size > 0) && (std::filesystem::file_size(esmry_file) != m_committed_size))
+            std::filesystem::resize_file(esmry_file, m_committed_size);
+
+        {
+            const auto mode = m_committed_size > 0 ? std::ios::app : std::ios::out;
+            Opm::EclIO::EclOutput outFile(m_outputFileName, m_fmt, mode);
+
+            if (m_committed_size == 0) {
+                outFile.write<int>("START", m_start_date_vect);
+
+                if (m_restart_rootn.size() > 0) {
+                    outFile.write<std::string>("RESTART", {m_restart_rootn});
+                    outFile.write<int>("RSTNUM", {m_restart_step});
+                }
+
+                outFile.write("KEYCHECK", m_smry_keys);
+                outFile.write("UNITS", m_smryUnits);
+            }
+
+            if (m_compressed) {
+                chunk_size = writeCompressedSmryChunks(outFile, m_rstep, m_tstep, m_smrydata, num_tstep);
+
+            } else {
+                outFile.write<int>("CHUNK", {static_cast<int>(num_tstep), m_nVect});
+                outFile.write<int>("RSTEP", m_rstep);
+                outFile.write<int>("TSTEP", m_tstep);
+
+                for (size_t n = 0; n < static_cast<size_t>(m_nVect); n++ ) {
+                    std::string vect_name="V" + std::to_string(n);
+                    outFile.write<float>(vect_name, m_smrydata[n]);
+                }
+
+                chunk_size = chunk_size_on_disk();
+            }
+        }
+
+        const auto file_size = std::filesystem::file_size(esmry_file);
+
+        if ((m_committed_size > 0) && (file_size != m_committed_size + chunk_size)) {
+            std::filesystem::resize_file(esmry_file, m_committed_size);
+            return false;
+        }
+
+        m_committed_size = file_size;
+
+    } catch (...) {
         return false;
     }
 
     return true;
 }
 
+std::uintmax_t ExtSmryOutput::chunk_size_on_disk() const
+{
+    // all binary headers are 24 bytes
+    const auto num_tstep = static_cast<int64_t>(m_rstep.size());
+
+    std::uintmax_t size = 3 * 24 + sizeOnDiskBinary(2, Opm::EclIO::INTE, Opm::EclIO::sizeOfInte);
+    size += 2 * sizeOnDiskBinary(num_tstep, Opm::EclIO::INTE, Opm::EclIO::sizeOfInte);
+    size += static_cast<std::uintmax_t>(m_nVect) * (24 + sizeOnDiskBinary(num_tstep, Opm::EclIO::REAL, Opm::EclIO::sizeOfReal));
+
+    return size;
+}
+
 
 std::vector<std::string> ExtSmryOutput::make_modified_keys(const std::vector<std::string>& valueKeys, const GridDims& dims)
 {
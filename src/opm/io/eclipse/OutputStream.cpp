@@ -32,7 +32,10 @@
 #include <fstream>
 #include <iomanip>
 #include <ios>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -97,6 +100,121 @@ namespace {
         }
     } // namespace FileExtension
 
+    /// In-process index of the SEQNUM positions in unified restart files.
+    ///
+    /// Opening a unified restart file at a particular report step requires
+    /// the position of that step's SEQNUM array.  Forming an ERst object
+    /// for this purpose scans all array headers in the file, so the
+    /// positions are instead recorded here as report steps are written.
+    /// ERst is only needed the first time a file is opened by the process,
+    /// or if the file has been changed by others since the last write.
+    class SeqnumIndex
+    {
+    public:
+        /// Position at which to write report step \p seqnum, or nullopt
+        /// if the index of \p fname is unknown or out of date.  Returns
+        /// \code streampos{ streamoff{-1} } \endcode for simple append.
+        std::optional<std::streampos>
+        writePosition(const std::string& fname, const int seqnum)
+        {
+            std::lock_guard<std::mutex> guard{ this->lock_ };
+
+            auto entry = this->files_.find(fname);
+            if ((entry == this->files_.end()) || !this->isCurrent(fname, entry->second)) {
+                return std::nullopt;
+            }
+
+            const auto pos = entry->second.seqnumPos.lower_bound(seqnum);
+
+            return (pos == entry->second.seqnumPos.end())
+                ? std::streampos(std::streamoff(-1))
+                : pos->second;
+        }
+
+        /// Replace index of \p fname with SEQNUM positions of file
+        /// contents.
+        void reset(const std::string& fname,
+                   std::map<int, std::streampos> seqnumPos)
+        {
+            std::lock_guard<std::mutex> guard{ this->lock_ };
+
+            auto& entry = this->files_[fname];
+
+            entry = Entry{};
+            entry.seqnumPos = std::move(seqnumPos);
+        }
+
+        /// Record that report step \p seqnum starts at position \p pos,
+        /// and that all later report steps have been discarded.
+        void startStep(const std::string& fname, const int seqnum,
+                       const std::streampos pos)
+        {
+            std::lock_guard<std::mutex> guard{ this->lock_ };
+
+            auto& entry = this->files_[fname];
+
+            entry.seqnumPos.erase(entry.seqnumPos.lower_bound(seqnum),
+                                  entry.seqnumPos.end());
+            entry.seqnumPos.emplace(seqnum, pos);
+            entry.size.reset();
+        }
+
+        /// Record file state once report step has been written and
+        /// the output stream closed.
+        void finishStep(const std::string& fname)
+        {
+            std::lock_guard<std::mutex> guard{ this->lock_ };
+
+            auto entry = this->files_.find(fname);
+            if (entry == this->files_.end()) {
+                return;
+            }
+
+            std::error_code ec;
+            const auto size  = std::filesystem::file_size(fname, ec);
+            const auto mtime = std::filesystem::last_write_time(fname, ec);
+
+            if (ec) {
+                this->files_.erase(entry);
+                return;
+            }
+
+            entry->second.size  = size;
+            entry->second.mtime = mtime;
+        }
+
+    private:
+        struct Entry
+        {
+            std::map<int, std::streampos> seqnumPos{};
+
+            /// File size and modification time after last write.  Size
+            /// is unset while a report step is being written.
+            std::optional<std::uintmax_t> size{};
+            std::filesystem::file_time_type mtime{};
+        };
+
+        std::mutex lock_{};
+        std::map<std::string, Entry> files_{};
+
+        bool isCurrent(const std::string& fname, const Entry& entry) const
+        {
+            std::error_code ec;
+            const auto size  = std::filesystem::file_size(fname, ec);
+            const auto mtime = std::filesystem::last_write_time(fname, ec);
+
+            return !ec && entry.size.has_value()
+                && (size == *entry.size) && (mtime == entry.mtime);
+        }
+    };
+
+    SeqnumIndex& seqnumIndex()
+    {
+        static SeqnumIndex index{};
+
+        return index;
+    }
+
     namespace Open
     {
         namespace Init
@@ -300,7 +418,8 @@ Restart(const ResultSet& rset,
 
     if (unif.set) {
         // Run uses unified restart files.
-        this->openUnified(fname, fmt.set, seqnum);
+        this->unifiedFileName_ = std::filesystem::absolute(fname).string();
+        this->openUnified(this->unifiedFileName_, fmt.set, seqnum);
 
         // Write SEQNUM value to stream to start new output sequence.
         this->stream_->write("SEQNUM", std::vector<int>{ seqnum });
@@ -313,16 +432,25 @@ Restart(const ResultSet& rset,
 }
 
 Opm::EclIO::OutputStream::Restart::~Restart()
-{}
+{
+    this->closeUnified();
+}
 
 Opm::EclIO::OutputStream::Restart::Restart(Restart&& rhs)
     : stream_{ std::move(rhs.stream_) }
-{}
+    , unifiedFileName_{ std::move(rhs.unifiedFileName_) }
+{
+    rhs.unifiedFileName_.clear();
+}
 
 Opm::EclIO::OutputStream::Restart&
 Opm::EclIO::OutputStream::Restart::operator=(Restart&& rhs)
 {
+    this->closeUnified();
+
     this->stream_ = std::move(rhs.stream_);
+    this->unifiedFileName_ = std::move(rhs.unifiedFileName_);
+    rhs.unifiedFileName_.clear();
 
     return *this;
 }
@@ -381,31 +509,69 @@ openUnified(const std::string& fname,
             const bool         formatted,
             const int          seqnum)
 {
-    // Determine if we're creating a new output/restart file or
-    // if we're opening an existing one, possibly at a specific
-    // write position.
-    auto rst = Open::Restart::read(fname);
+    auto& index = seqnumIndex();
 
-    if (rst == nullptr) {
-        // No such unified restart file exists.  Create new file.
-        this->openNew(fname, formatted);
-    }
-    else if (! rst->hasKey("SEQNUM")) {
-        // File with correct filename exists but does not appear
-        // to be an actual unified restart file.
-        throw std::invalid_argument {
-            "Purported existing unified restart file '"
-            + std::filesystem::path{fname}.filename().string()
-            + "' does not appear to be a unified restart file"
-        };
+    if (const auto writePos = index.writePosition(fname, seqnum);
+        writePos.has_value())
+    {
+        // File last written by this process and not changed since.  The
+        // write position is known without scanning the file.
+        this->openExisting(fname, formatted, *writePos);
     }
     else {
-        // Restart file exists and appears to be a unified restart
-        // resource.  Open writable restart stream backed by the
-        // specific file.
-        this->openExisting(fname, formatted,
-                           rst->restartStepWritePosition(seqnum));
+        // Determine if we're creating a new output/restart file or
+        // if we're opening an existing one, possibly at a specific
+        // write position.
+        auto rst = Open::Restart::read(fname);
+
+        if (rst == nullptr) {
+            // No such unified restart file exists.  Create new file and
+            // forget any positions recorded for an earlier file with the
+            // same name.
+            index.reset(fname, {});
+            this->openNew(fname, formatted);
+        }
+        else if (! rst->hasKey("SEQNUM")) {
+            // File with correct filename exists but does not appear
+            // to be an actual unified restart file.
+            throw std::invalid_argument {
+                "Purported existing unified restart file '"
+                + std::filesystem::path{fname}.filename().string()
+                + "' does not appear to be a unified restart file"
+            };
+        }
+        else {
+            // Restart file exists and appears to be a unified restart
+            // resource.  Open writable restart stream backed by the
+            // specific file.
+            auto seqnumPos = std::map<int, std::streampos>{};
+            for (const auto& step : rst->listOfReportStepNumbers()) {
+                seqnumPos.emplace(step, rst->restartStepWritePosition(step));
+            }
+
+            index.reset(fname, std::move(seqnumPos));
+
+            this->openExisting(fname, formatted,
+                               rst->restartStepWritePosition(seqnum));
+        }
     }
+
+    // New report step's SEQNUM array starts at the current end of file.
+    index.startStep(fname, seqnum,
+                    static_cast<std::streamoff>(std::filesystem::file_size(fname)));
+}
+
+void
+Opm::EclIO::OutputStream::Restart::closeUnified()
+{
+    if (this->unifiedFileName_.empty() || (this->stream_ == nullptr)) {
+        return;
+    }
+
+    // Close stream before recording the file state in the index.
+    this->stream_.reset();
+
+    seqnumIndex().finishStep(this->unifiedFileName_);
 }
 
 void
@@ -0,0 +1,266 @@
+/*
+   Copyright 2026 Equinor ASA.
+
+   This file is part of the Open Porous Media project (OPM).
+
+   OPM is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   OPM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+   */
+
+
+#include <opm/io/eclipse/SmryCompression.hpp>
+
+#include <opm/io/eclipse/EclOutput.hpp>
+#include <opm/io/eclipse/EclUtil.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+std::uint32_t low_mask(int num_bits)
+{
+    return num_bits >= 32 ? 0xFFFFFFFFu : (std::uint32_t{1} << num_bits) - 1;
+}
+
+std::uint32_t float_bits(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    return bits;
+}
+
+float bits_float(std::uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+// Bits are packed into 32 bit words, most significant bit first.
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<int>& words)
+        : words_(words)
+    {}
+
+    void put(std::uint32_t value, int num_bits)
+    {
+        acc_ = (acc_ << num_bits) | (value & low_mask(num_bits));
+        num_acc_ += num_bits;
+
+        if (num_acc_ >= 32) {
+            num_acc_ -= 32;
+            push(static_cast<std::uint32_t>(acc_ >> num_acc_));
+        }
+    }
+
+    void flush()
+    {
+        if (num_acc_ > 0) {
+            push(static_cast<std::uint32_t>(acc_ << (32 - num_acc_)));
+            num_acc_ = 0;
+        }
+    }
+
+private:
+    std::vector<int>& words_;
+    std::uint64_t acc_ = 0;
+    int num_acc_ = 0;
+
+    void push(std::uint32_t word)
+    {
+        int value;
+        std::memcpy(&value, &word, sizeof value);
+        words_.push_back(value);
+    }
+};
+
+class BitReader
+{
+public:
+    BitReader(const int* words, std::size_t num_words)
+        : words_(words)
+        , num_words_(num_words)
+    {}
+
+    std::uint32_t get(int num_bits)
+    {
+        if (num_acc_ < num_bits) {
+            if (pos_ == num_words_)
+                throw std::runtime_error("Compressed summary vector is truncated");
+
+            std::uint32_t word;
+            std::memcpy(&word, words_ + pos_++, sizeof word);
+
+            acc_ = (acc_ << 32) | word;
+            num_acc_ += 32;
+        }
+
+        num_acc_ -= num_bits;
+        return static_cast<std::uint32_t>(acc_ >> num_acc_) & low_mask(num_bits);
+    }
+
+private:
+    const int* words_;
+    std::size_t num_words_;
+    std::size_t pos_ = 0;
+    std::uint64_t acc_ = 0;
+    int num_acc_ = 0;
+};
+
+}
+
+namespace Opm { namespace EclIO {
+
+/*
+  The first value is stored with all 32 bits. For the following values the
+  XOR with the previous value is stored as
+
+    0                        value equal to previous value
+    10 <bits>                changed bits within the window of the previous
+                             value which was stored with control bits 11
+    11 <lead> <len> <bits>   5 bits number of leading zeros, 5 bits number
+                             of changed bits - 1 and then the changed bits
+*/
+
+std::vector<int> compressSmryVector(const float* data, std::size_t size)
+{
+    std::vector<int> words;
+
+    if (size == 0)
+        return words;
+
+    BitWriter writer(words);
+
+    auto prev = float_bits(data[0]);
+    writer.put(prev, 32);
+
+    int lead = -1;
+    int trail = 0;
+
+    for (std::size_t n = 1; n < size; n++) {
+        const auto bits = float_bits(data[n]);
+        const auto xor_bits = bits ^ prev;
+        prev = bits;
+
+        if (xor_bits == 0) {
+            writer.put(0, 1);
+            continue;
+        }
+
+        const int num_lead = __builtin_clz(xor_bits);
+        const int num_trail = __builtin_ctz(xor_bits);
+
+        if ((lead >= 0) && (num_lead >= lead) && (num_trail >= trail)) {
+            writer.put(0b10, 2);
+            writer.put(xor_bits >> trail, 32 - lead - trail);
+        } else {
+            lead = num_lead;
+            trail = num_trail;
+
+            const int len = 32 - lead - trail;
+
+            writer.put(0b11, 2);
+            writer.put(lead, 5);
+            writer.put(len - 1, 5);
+            writer.put(xor_bits >> trail, len);
+        }
+    }
+
+    writer.flush();
+
+    return words;
+}
+
+void decompressSmryVector(const int* words, std::size_t num_words, std::size_t size,
+                          std::vector<float>& result)
+{
+    if (size == 0)
+        return;
+
+    result.reserve(result.size() + size);
+
+    BitReader reader(words, num_words);
+
+    auto prev = reader.get(32);
+    result.push_back(bits_float(prev));
+
+    int lead = 0;
+    int trail = 0;
+
+    for (std::size_t n = 1; n < size; n++) {
+        if (reader.get(1) == 1) {
+            if (reader.get(1) == 1) {
+                lead = static_cast<int>(reader.get(5));
+                trail = 32 - lead - static_cast<int>(reader.get(5)) - 1;
+
+                if (trail < 0)
+                    throw std::runtime_error("Invalid compressed summary vector");
+            }
+
+            prev ^= reader.get(32 - lead - trail) << trail;
+        }
+
+        result.push_back(bits_float(prev));
+    }
+}
+
+std::uintmax_t writeCompressedSmryChunks(EclOutput& outFile,
+                                         const std::vector<int>& rstep,
+                                         const std::vector<int>& tstep,
+                                         const std::vector<std::vector<float>>& data,
+                                         std::size_t num_tstep)
+{
+    const auto num_vect = data.size();
+
+    std::vector<int> vindex(num_vect + 1);
+    std::vector<int> vdata;
+
+    std::uintmax_t size_on_disk = 0;
+
+    for (std::size_t from = 0; from < num_tstep; from += compressedSmryChunkSize) {
+        const auto to = std::min(num_tstep, from + compressedSmryChunkSize);
+        const auto num_chunk = static_cast<std::int64_t>(to - from);
+
+        vdata.clear();
+
+        for (std::size_t n = 0; n < num_vect; n++) {
+            vindex[n] = static_cast<int>(vdata.size());
+
+            const auto words = compressSmryVector(data[n].data() + from, to - from);
+            vdata.insert(vdata.end(), words.begin(), words.end());
+        }
+
+        vindex[num_vect] = static_cast<int>(vdata.size());
+
+        outFile.write<int>("CHUNK", {static_cast<int>(num_chunk), static_cast<int>(num_vect),
+                                     static_cast<int>(SmryCodec::XorFloat)});
+        outFile.write<int>("RSTEP", std::vector<int>(rstep.begin() + from, rstep.begin() + to));
+        outFile.write<int>("TSTEP", std::vector<int>(tstep.begin() + from, tstep.begin() + to));
+        outFile.write<int>("VINDEX", vindex);
+        outFile.write<int>("VDATA", vdata);
+
+        // all binary headers are 24 bytes
+        size_on_disk += 5 * 24 + sizeOnDiskBinary(3, INTE, sizeOfInte);
+        size_on_disk += 2 * sizeOnDiskBinary(num_chunk, INTE, sizeOfInte);
+        size_on_disk += sizeOnDiskBinary(vindex.size(), INTE, sizeOfInte);
+        size_on_disk += sizeOnDiskBinary(vdata.size(), INTE, sizeOfInte);
+    }
+
+    return size_on_disk;
+}
+
+}} // namespace Opm::EclIO
@@ -31,8 +31,12 @@
 #include <opm/input/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/input/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/input/eclipse/EclipseState/IOConfig/IOConfig.hpp>
+#include <opm/input/eclipse/Schedule/Action/State.hpp>
 #include <opm/input/eclipse/Schedule/RPTConfig.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
+#include <opm/input/eclipse/Schedule/SummaryState.hpp>
+#include <opm/input/eclipse/Schedule/UDQ/UDQState.hpp>
+#include <opm/input/eclipse/Schedule/Well/WellTestState.hpp>
 #include <opm/input/eclipse/Schedule/Well/WellConnections.hpp>
 #include <opm/input/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
 
@@ -54,12 +58,18 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <functional>
 #include <limits>
 #include <memory>     // unique_ptr
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <utility>    // move
 
@@ -98,6 +108,97 @@ void ensure_directory_exists( const std::filesystem::path& odir )
     }
 }
 
+/*
+  Bounded queue of output tasks which are executed in order by one I/O
+  thread. The first exception thrown by a task is kept, the remaining
+  tasks are discarded, and the exception is rethrown on the thread which
+  calls push() or flush().
+*/
+class OutputQueue {
+public:
+    explicit OutputQueue(std::size_t max_pending)
+        : max_pending_(std::max(max_pending, std::size_t{1}))
+        , thread_([this]() { this->run(); })
+    {}
+
+    ~OutputQueue() {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->stop_ = true;
+        }
+        this->task_available_.notify_one();
+        this->thread_.join();
+    }
+
+    void push(std::function<void()> task) {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->task_done_.wait(lock, [this]() {
+            return this->error_ || (this->tasks_.size() < this->max_pending_);
+        });
+        this->rethrow();
+
+        this->tasks_.push_back(std::move(task));
+        lock.unlock();
+        this->task_available_.notify_one();
+    }
+
+    void flush() {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->task_done_.wait(lock, [this]() {
+            return this->tasks_.empty() && !this->busy_;
+        });
+        this->rethrow();
+    }
+
+private:
+    std::size_t max_pending_;
+    std::deque<std::function<void()>> tasks_{};
+    bool busy_{false};
+    bool stop_{false};
+    std::exception_ptr error_{};
+    std::mutex mutex_{};
+    std::condition_variable task_available_{};
+    std::condition_variable task_done_{};
+    std::thread thread_;
+
+    // Called with the mutex held.
+    void rethrow() {
+        if (this->error_)
+            std::rethrow_exception(std::exchange(this->error_, nullptr));
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        while (true) {
+            this->task_available_.wait(lock, [this]() {
+                return this->stop_ || !this->tasks_.empty();
+            });
+            if (this->tasks_.empty())
+                return;
+
+            auto task = std::move(this->tasks_.front());
+            this->tasks_.pop_front();
+            this->busy_ = true;
+            lock.unlock();
+
+            std::exception_ptr error{};
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+            this->busy_ = false;
+            if (error) {
+                this->error_ = error;
+                this->tasks_.clear();
+            }
+            this->task_done_.notify_all();
+        }
+    }
+};
+
 }
 
 namespace Opm {
@@ -114,6 +215,19 @@ class EclipseIO::Impl {
 
         void recordSummaryOutput(const double secs_elapsed);
 
+        void writeStep(const Action::State& action_state,
+                       const WellTestState& wtest_state,
+                       const SummaryState&  st,
+                       const UDQState&      udq_state,
+                       const int            report_step,
+                       const bool           isSubstep,
+                       const double         secs_elapsed,
+                       const RestartValue&  value,
+                       const bool           write_double,
+                       const bool           write_summary);
+
+        void flush();
+
         const EclipseState& es;
         EclipseGrid grid;
         const Schedule& schedule;
@@ -123,6 +237,7 @@ class EclipseIO::Impl {
         out::Summary summary;
         bool output_enabled;
         std::optional<RestartIO::Helpers::AggregateAquiferData> aquiferData{std::nullopt};
+        std::unique_ptr<OutputQueue> outputQueue{};
 
 private:
     mutable bool sumthin_active_{false};
@@ -263,42 +378,29 @@ void EclipseIO::writeInitial( data::Solution simProps, std::map<std::string, std
 
 }
 
-// implementation of the writeTimeStep method
-void EclipseIO::writeTimeStep(const Action::State& action_state,
-                              const WellTestState& wtest_state,
-                              const SummaryState& st,
-                              const UDQState& udq_state,
-                              int report_step,
-                              bool  isSubstep,
-                              double secs_elapsed,
-                              RestartValue value,
-                              const bool write_double)
- {
-    if (! this->impl->output_enabled) {
-        return;
-    }
-
-    const auto& es = this->impl->es;
-    const auto& grid = this->impl->grid;
-    const auto& schedule = this->impl->schedule;
-    const auto& ioConfig = es.cfg().io();
+void EclipseIO::Impl::writeStep(const Action::State& action_state,
+                                const WellTestState& wtest_state,
+                                const SummaryState&  st,
+                                const UDQState&      udq_state,
+                                const int            report_step,
+                                const bool           isSubstep,
+                                const double         secs_elapsed,
+                                const RestartValue&  value,
+                                const bool           write_double,
+                                const bool           write_summary)
+{
+    const auto& ioConfig = this->es.cfg().io();
 
-    const bool final_step { report_step == static_cast<int>(schedule.size()) - 1 };
+    const bool final_step { report_step == static_cast<int>(this->schedule.size()) - 1 };
     const bool is_final_summary = final_step && !isSubstep;
 
-    if ((report_step > 0) &&
-        this->impl->wantSummaryOutput(report_step, isSubstep, secs_elapsed))
-    {
-        this->impl->summary.add_timestep(st, report_step, isSubstep);
-        this->impl->summary.write(is_final_summary);
-
-        this->impl->recordSummaryOutput(secs_elapsed);
+    if (write_summary) {
+        this->summary.add_timestep(st, report_step, isSubstep);
+        this->summary.write(is_final_summary);
     }
 
-
-    if (final_step && !isSubstep && this->impl->summaryConfig.createRunSummary()) {
-        std::filesystem::path outputDir { this->impl->outputDir } ;
-        std::filesystem::path outputFile { outputDir / this->impl->baseName } ;
+    if (is_final_summary && this->summaryConfig.createRunSummary()) {
+        std::filesystem::path outputFile { std::filesystem::path { this->outputDir } / this->baseName } ;
         EclIO::ESmry(outputFile).write_rsm_file();
     }
 
@@ -307,24 +409,25 @@ void EclipseIO::writeTimeStep(const Action::State& action_state,
       but there is an unsupported option to the RPTSCHED keyword which
       will request restart output from every timestep.
     */
-    if(!isSubstep && schedule.write_rst_file(report_step))
+    if(!isSubstep && this->schedule.write_rst_file(report_step))
     {
         EclIO::OutputStream::Restart rstFile {
-            EclIO::OutputStream::ResultSet { this->impl->outputDir,
-                                             this->impl->baseName },
+            EclIO::OutputStream::ResultSet { this->outputDir,
+                                             this->baseName },
             report_step,
             EclIO::OutputStream::Formatted { ioConfig.getFMTOUT() },
             EclIO::OutputStream::Unified   { ioConfig.getUNIFOUT() }
         };
 
         RestartIO::save(rstFile, report_step, secs_elapsed, value,
-                        es, grid, schedule, action_state, wtest_state, st,
-                        udq_state, this->impl->aquiferData, write_double);
+                        this->es, this->grid, this->schedule, action_state,
+                        wtest_state, st, udq_state, this->aquiferData,
+                        write_double);
     }
 
     // RFT file written only if requested and never for substeps.
     if (const auto& [wantRFT, haveExistingRFT] =
-        this->impl->wantRFTOutput(report_step, isSubstep);
+        this->wantRFTOutput(report_step, isSubstep);
         wantRFT)
     {
         // Open existing RFT file if report step is after first RFT event.
@@ -333,15 +436,81 @@ void EclipseIO::writeTimeStep(const Action::State& action_state,
         };
 
         EclIO::OutputStream::RFT rftFile {
-            EclIO::OutputStream::ResultSet { this->impl->outputDir,
-                                             this->impl->baseName },
+            EclIO::OutputStream::ResultSet { this->outputDir,
+                                             this->baseName },
             EclIO::OutputStream::Formatted { ioConfig.getFMTOUT() },
             openExisting
         };
 
-        RftIO::write(report_step, secs_elapsed, es.getUnits(),
-                     grid, schedule, value.wells, rftFile);
+        RftIO::write(report_step, secs_elapsed, this->es.getUnits(),
+                     this->grid, this->schedule, value.wells, rftFile);
+    }
+}
+
+void EclipseIO::Impl::flush()
+{
+    if (this->outputQueue)
+        this->outputQueue->flush();
+}
+
+// implementation of the writeTimeStep method
+void EclipseIO::writeTimeStep(const Action::State& action_state,
+                              const WellTestState& wtest_state,
+                              const SummaryState& st,
+                              const UDQState& udq_state,
+                              int report_step,
+                              bool  isSubstep,
+                              double secs_elapsed,
+                              RestartValue value,
+                              const bool write_double)
+ {
+    if (! this->impl->output_enabled) {
+        return;
+    }
+
+    const auto& grid = this->impl->grid;
+    const auto& schedule = this->impl->schedule;
+
+    const bool final_step { report_step == static_cast<int>(schedule.size()) - 1 };
+
+    // The SUMTHIN bookkeeping depends on the order of the calls, and is
+    // therefore done here rather than on the I/O thread.
+    const bool write_summary = (report_step > 0) &&
+        this->impl->wantSummaryOutput(report_step, isSubstep, secs_elapsed);
+
+    if (write_summary)
+        this->impl->recordSummaryOutput(secs_elapsed);
+
+    if (this->impl->outputQueue) {
+        struct Snapshot {
+            Action::State action_state;
+            WellTestState wtest_state;
+            SummaryState st;
+            UDQState udq_state;
+            RestartValue value;
+        };
+
+        auto snapshot = std::make_shared<Snapshot>(Snapshot {
+            action_state, wtest_state, st, udq_state, std::move(value)
+        });
+
+        this->impl->outputQueue->push([impl = this->impl.get(), snapshot,
+                                       report_step, isSubstep, secs_elapsed,
+                                       write_double, write_summary]()
+        {
+            impl->writeStep(snapshot->action_state, snapshot->wtest_state,
+                            snapshot->st, snapshot->udq_state, report_step,
+                            isSubstep, secs_elapsed, snapshot->value,
+                            write_double, write_summary);
+        });
+
+        if (final_step && !isSubstep)
+            this->impl->flush();
     }
+    else
+        this->impl->writeStep(action_state, wtest_state, st, udq_state,
+                              report_step, isSubstep, secs_elapsed, value,
+                              write_double, write_summary);
 
     if (!isSubstep) {
         for (const auto& report : schedule[report_step].rpt_config.get()) {
@@ -357,8 +526,25 @@ void EclipseIO::writeTimeStep(const Action::State& action_state,
     }
  }
 
+void EclipseIO::setAsyncOutput(const std::size_t max_pending_steps)
+{
+    this->impl->flush();
+
+    if (max_pending_steps == 0)
+        this->impl->outputQueue.reset();
+    else
+        this->impl->outputQueue = std::make_unique<OutputQueue>(max_pending_steps);
+}
+
+void EclipseIO::flushOutput()
+{
+    this->impl->flush();
+}
+
 
 RestartValue EclipseIO::loadRestart(Action::State& action_state, SummaryState& summary_state, const std::vector<RestartKey>& solution_keys, const std::vector<RestartKey>& extra_keys) const {
+    this->impl->flush();
+
     const auto& es                       = this->impl->es;
     const auto& grid                     = this->impl->grid;
     const auto& schedule                 = this->impl->schedule;
@@ -389,10 +575,22 @@ EclipseIO::EclipseIO( const EclipseState& es,
 }
 
 const out::Summary& EclipseIO::summary() {
+    this->impl->flush();
     return this->impl->summary;
 }
 
 
-EclipseIO::~EclipseIO() {}
+EclipseIO::~EclipseIO()
+{
+    try {
+        this->impl->flush();
+    }
+    catch (const std::exception& e) {
+        OpmLog::error(std::string { "Writing output failed: " } + e.what());
+    }
+    catch (...) {
+        OpmLog::error("Writing output failed: Unknown exception");
+    }
+}
 
 } // namespace Opm
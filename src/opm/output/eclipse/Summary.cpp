@@ -71,16 +71,19 @@
 #include <cassert>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <cctype>
 #include <ctime>
 #include <exception>
 #include <filesystem>
 #include <functional>
+#include <future>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <regex>
 #include <stdexcept>
 #include <string>
@@ -507,7 +510,7 @@ struct fn_args
     const Opm::out::RegionCache& regionCache;
     const Opm::EclipseGrid& grid;
     const Opm::Schedule& schedule;
-    const std::vector< std::pair< std::string, double > > eff_factors;
+    const std::vector< std::pair< std::string, double > >& eff_factors;
     const Opm::Inplace& initial_inplace;
     const Opm::Inplace& inplace;
     const Opm::UnitSystem& unit_system;
@@ -570,15 +573,16 @@ measure rate_unit<Opm::data::GuideRateValue::Item::Gas>() { return measure::gas_
 template <> constexpr
 measure rate_unit<Opm::data::GuideRateValue::Item::ResV>() { return measure::rate; }
 
+// The efficiency factors are sorted by well name, see EfficiencyFactor.
 double efac( const std::vector<std::pair<std::string,double>>& eff_factors, const std::string& name)
 {
-    auto it = std::find_if(eff_factors.begin(), eff_factors.end(),
-        [&name](const std::pair<std::string, double>& elem)
+    auto it = std::lower_bound(eff_factors.begin(), eff_factors.end(), name,
+        [](const std::pair<std::string, double>& elem, const std::string& key)
     {
-        return elem.first == name;
+        return elem.first < key;
     });
 
-    return (it != eff_factors.end()) ? it->second : 1.0;
+    return ((it != eff_factors.end()) && (it->first == name)) ? it->second : 1.0;
 }
 
 inline bool
@@ -2557,6 +2561,7 @@ void updateValue(const Opm::EclIO::SummaryNode& node, const double value, Opm::S
  * Regions and fields will have the well and group efficiency applied for both
  * rates and accumulated values.
  *
+ * The factors are sorted by well name to allow binary search in efac().
  */
 struct EfficiencyFactor
 {
@@ -2609,6 +2614,276 @@ void EfficiencyFactor::setFactors(const Opm::EclIO::SummaryNode&       node,
 
         this->factors.emplace_back(well->name(), eff_factor);
     }
+
+    std::sort(this->factors.begin(), this->factors.end(),
+              [](const Factor& f1, const Factor& f2)
+              {
+                  return f1.first < f2.first;
+              });
+}
+
+/*
+ * The wells and efficiency factors needed by the function evaluators only
+ * change when the schedule changes, but used to be recomputed for every
+ * summary vector at every time step.  The evaluation plan caches them per
+ * report step, and all summary vectors of the same entity - e.g. the well
+ * level vectors of well 'OP_1', or the group level vectors of group 'G1' -
+ * share a single well set.
+ *
+ * The plan is rebuilt when the report step changes, and when any of the
+ * well or group objects of the report step has been replaced, e.g. by an
+ * ACTIONX block.  The plan holds on to the well and group objects, so the
+ * cached pointers stay valid until the plan is rebuilt.
+ */
+class EvaluationPlan
+{
+public:
+    using WellList = std::vector<const Opm::Well*>;
+    using FacColl  = EfficiencyFactor::FacColl;
+
+    struct Resolved
+    {
+        const WellList& wells;
+        const FacColl&  factors;
+    };
+
+    // Key of the well set for node, or an empty string if node does not
+    // need any wells.
+    static std::string wellSetKey(const Opm::EclIO::SummaryNode& node);
+
+    // Must be called before the summary vectors of a time step are
+    // evaluated.  The validity of the cached well sets is checked when the
+    // first well set is requested.
+    void setStep(const Opm::Schedule& schedule, const int sim_step);
+
+    Resolved resolve(const std::string&             key,
+                     const Opm::EclIO::SummaryNode& node,
+                     const Opm::out::RegionCache&   regionCache);
+
+private:
+    struct WellSet
+    {
+        WellList wells{};
+
+        // Index 0: all group efficiency factors applied.  Index 1: group
+        // efficiency factors applied up to, but not including, the group
+        // of the well set.
+        std::array<std::optional<FacColl>, 2> factors{};
+    };
+
+    const Opm::Schedule* schedule_{nullptr};
+    int sim_step_{-1};
+    bool checked_{false};
+
+    int plan_step_{-1};
+    std::vector<std::shared_ptr<Opm::Well>>  well_objects_{};
+    std::vector<std::shared_ptr<Opm::Group>> group_objects_{};
+    std::unordered_map<std::string, WellSet> well_sets_{};
+
+    void checkValidity();
+};
+
+template <typename Objects, typename Ptr>
+bool same_objects(const Objects& objects, const std::vector<Ptr>& cached)
+{
+    return (objects.size() == cached.size())
+        && std::equal(cached.begin(), cached.end(), objects.begin(),
+                      [](const Ptr& ptr, const auto& elm)
+                      {
+                          return ptr.get() == elm.second.get();
+                      });
+}
+
+std::string EvaluationPlan::wellSetKey(const Opm::EclIO::SummaryNode& node)
+{
+    using Cat = Opm::EclIO::SummaryNode::Category;
+
+    if (! need_wells(node)) {
+        return "";
+    }
+
+    switch (node.category) {
+    case Cat::Well:
+    case Cat::Connection:
+    case Cat::Completion:
+    case Cat::Segment:
+        return "W:" + node.wgname;
+
+    case Cat::Group:
+        return "G:" + node.wgname;
+
+    case Cat::Field:
+        return "F:";
+
+    case Cat::Region:
+        return fmt::format("R:{}:{}", node.fip_region.value_or(""), node.number);
+
+    default:
+        return "";
+    }
+}
+
+void EvaluationPlan::setStep(const Opm::Schedule& schedule, const int sim_step)
+{
+    this->schedule_ = &schedule;
+    this->sim_step_ = sim_step;
+    this->checked_ = false;
+}
+
+void EvaluationPlan::checkValidity()
+{
+    const auto& sched_state = (*this->schedule_)[this->sim_step_];
+
+    const auto valid = (this->plan_step_ == this->sim_step_)
+        && same_objects(sched_state.wells, this->well_objects_)
+        && same_objects(sched_state.groups, this->group_objects_);
+
+    if (! valid) {
+        this->plan_step_ = this->sim_step_;
+        this->well_sets_.clear();
+
+        this->well_objects_.clear();
+        for (const auto& [_, well] : sched_state.wells) {
+            (void)_;
+            this->well_objects_.push_back(well);
+        }
+
+        this->group_objects_.clear();
+        for (const auto& [_, group] : sched_state.groups) {
+            (void)_;
+            this->group_objects_.push_back(group);
+        }
+    }
+
+    this->checked_ = true;
+}
+
+EvaluationPlan::Resolved
+EvaluationPlan::resolve(const std::string&             key,
+                        const Opm::EclIO::SummaryNode& node,
+                        const Opm::out::RegionCache&   regionCache)
+{
+    static const WellList no_wells{};
+    static const FacColl  no_factors{};
+
+    if (key.empty()) {
+        return { no_wells, no_factors };
+    }
+
+    if (! this->checked_) {
+        this->checkValidity();
+    }
+
+    // Look up before inserting; a resolve() call which finds everything
+    // in place does not modify the plan and is safe to run concurrently.
+    auto pos = this->well_sets_.find(key);
+    if (pos == this->well_sets_.end()) {
+        pos = this->well_sets_.emplace(key, WellSet{}).first;
+        pos->second.wells = find_wells(*this->schedule_, node, this->sim_step_, regionCache);
+    }
+
+    auto& well_set = pos->second;
+
+    using Cat = Opm::EclIO::SummaryNode::Category;
+    const bool is_group = node.category == Cat::Group;
+    const bool is_rate  = node.type != Opm::EclIO::SummaryNode::Type::Total;
+
+    if (is_rate && !is_group &&
+        (node.category != Cat::Field) && (node.category != Cat::Region))
+    {
+        return { well_set.wells, no_factors };
+    }
+
+    auto& factors = well_set.factors[(is_group && is_rate) ? 1 : 0];
+    if (! factors.has_value()) {
+        EfficiencyFactor efac{};
+        efac.setFactors(node, *this->schedule_, well_set.wells, this->sim_step_);
+        factors = std::move(efac.factors);
+    }
+
+    return { well_set.wells, *factors };
+}
+
+/*
+ * SummaryState handles of the values written by the evaluators, keyed by
+ * the address of the evaluator's node or key.  The handles are dropped when
+ * the slot layout of the SummaryState changes, other than through the
+ * updates applied with the cache.
+ */
+class SlotCache
+{
+public:
+    void update(const Opm::EclIO::SummaryNode& node, const double value, Opm::SummaryState& st);
+    void update(const std::string& key, const double value, Opm::SummaryState& st);
+
+private:
+    std::uint64_t layout_id_{0};
+    std::unordered_map<const void*, Opm::SummaryState::Handle> handles_{};
+
+    template <typename Update, typename Find>
+    void update(const void* id, const double value, Opm::SummaryState& st,
+                Update&& update, Find&& find);
+};
+
+template <typename Update, typename Find>
+void SlotCache::update(const void* id, const double value, Opm::SummaryState& st,
+                       Update&& update, Find&& find)
+{
+    if (st.layout_id() != this->layout_id_) {
+        this->handles_.clear();
+        this->layout_id_ = st.layout_id();
+    }
+
+    auto pos = this->handles_.find(id);
+    if (pos != this->handles_.end()) {
+        st.update(pos->second, value);
+        return;
+    }
+
+    update();
+
+    const auto handle = find();
+    if (handle.has_value()) {
+        this->handles_.emplace(id, *handle);
+    }
+
+    // Adding the slot did not move any of the cached slots.
+    this->layout_id_ = st.layout_id();
+}
+
+void SlotCache::update(const Opm::EclIO::SummaryNode& node, const double value, Opm::SummaryState& st)
+{
+    using Cat = Opm::EclIO::SummaryNode::Category;
+
+    this->update(&node, value, st,
+                 [&node, value, &st]() { updateValue(node, value, st); },
+                 [&node, &st]() -> std::optional<Opm::SummaryState::Handle>
+                 {
+                     switch (node.category) {
+                     case Cat::Well:
+                         return st.well_var_handle(node.wgname, node.keyword);
+
+                     case Cat::Group:
+                     case Cat::Node:
+                         return st.group_var_handle(node.wgname, node.keyword);
+
+                     case Cat::Connection:
+                         return st.conn_var_handle(node.wgname, node.keyword, node.number);
+
+                     case Cat::Segment:
+                         return st.segment_var_handle(node.wgname, node.keyword, node.number);
+
+                     default:
+                         return st.handle(node.unique_key());
+                     }
+                 });
+}
+
+void SlotCache::update(const std::string& key, const double value, Opm::SummaryState& st)
+{
+    this->update(&key, value, st,
+                 [&key, value, &st]() { st.update(key, value); },
+                 [&key, &st]() { return st.handle(key); });
 }
 
 namespace Evaluator {
@@ -2619,6 +2894,7 @@ namespace Evaluator {
         const Opm::EclipseGrid& grid;
         const Opm::out::RegionCache& reg;
         const Opm::Inplace initial_inplace;
+        EvaluationPlan& plan;
     };
 
     struct SimulatorResults
@@ -2633,6 +2909,55 @@ namespace Evaluator {
         const std::unordered_map<std::string, Opm::data::InterRegFlowMap>& ireg;
     };
 
+    /*
+     * Summary values computed by the evaluators.  The values are buffered
+     * so that the evaluators can run concurrently, and are applied to the
+     * SummaryState in the order in which they were computed.  The nodes and
+     * keys are referenced, not copied, and must outlive the buffer contents.
+     */
+    class Results
+    {
+    public:
+        void update(const Opm::EclIO::SummaryNode& node, const double value)
+        {
+            this->values_.push_back({ &node, nullptr, value });
+        }
+
+        void update(const std::string& key, const double value)
+        {
+            this->values_.push_back({ nullptr, &key, value });
+        }
+
+        void clear()
+        {
+            this->values_.clear();
+        }
+
+        void apply(Opm::SummaryState& st, SlotCache& slots)
+        {
+            for (const auto& value : this->values_) {
+                if (value.node != nullptr) {
+                    slots.update(*value.node, value.value, st);
+                }
+                else {
+                    slots.update(*value.key, value.value, st);
+                }
+            }
+
+            this->values_.clear();
+        }
+
+    private:
+        struct Value
+        {
+            const Opm::EclIO::SummaryNode* node;
+            const std::string* key;
+            double value;
+        };
+
+        std::vector<Value> values_{};
+    };
+
     class Base
     {
     public:
@@ -2642,7 +2967,17 @@ namespace Evaluator {
                             const double            stepSize,
                             const InputData&        input,
                             const SimulatorResults& simRes,
-                            Opm::SummaryState&      st) const = 0;
+                            const Opm::SummaryState& st,
+                            Results&                result) const = 0;
+
+        // Called sequentially, before update(), when the evaluators are
+        // run concurrently.  Must resolve any shared state which update()
+        // would otherwise modify.
+        virtual void prepare(const InputData& /* input */) const {}
+
+        // Evaluators reading summary vectors computed in the same time
+        // step are not run concurrently with any other evaluator.
+        virtual bool readsSummaryVectors() const { return false; }
     };
 
     class FunctionRelation : public Base
@@ -2651,6 +2986,7 @@ namespace Evaluator {
         explicit FunctionRelation(Opm::EclIO::SummaryNode node, ofun fcn)
             : node_(std::move(node))
             , fcn_ (std::move(fcn))
+            , well_set_key_(EvaluationPlan::wellSetKey(this->node_))
         {
             if (this->use_number()) {
                 this->number_ = this->node_.number;
@@ -2661,37 +2997,42 @@ namespace Evaluator {
                     const double            stepSize,
                     const InputData&        input,
                     const SimulatorResults& simRes,
-                    Opm::SummaryState&      st) const override
+                    const Opm::SummaryState& st,
+                    Results&                result) const override
         {
-            const auto get_wells = need_wells(this->node_);
-
-            const auto wells = get_wells
-                ? find_wells(input.sched, this->node_,
-                             static_cast<int>(sim_step), input.reg)
-                : std::vector<const Opm::Well*>{};
-
-            EfficiencyFactor efac{};
-            efac.setFactors(this->node_, input.sched, wells, sim_step);
+            const auto plan = input.plan.resolve(this->well_set_key_, this->node_, input.reg);
 
             const fn_args args {
-                wells, this->group_name(), this->node_.keyword, stepSize, static_cast<int>(sim_step),
+                plan.wells, this->group_name(), this->node_.keyword, stepSize, static_cast<int>(sim_step),
                 std::max(0, this->number_),
                 this->node_.fip_region,
                 st, simRes.wellSol, simRes.grpNwrkSol,
                 input.reg, input.grid, input.sched,
-                std::move(efac.factors), input.initial_inplace, simRes.inplace,
+                plan.factors, input.initial_inplace, simRes.inplace,
                 input.sched.getUnits()
             };
 
             const auto& usys = input.es.getUnits();
             const auto  prm  = this->fcn_(args);
 
-            updateValue(this->node_, usys.from_si(prm.unit, prm.value), st);
+            result.update(this->node_, usys.from_si(prm.unit, prm.value));
+        }
+
+        void prepare(const InputData& input) const override
+        {
+            input.plan.resolve(this->well_set_key_, this->node_, input.reg);
+        }
+
+        bool readsSummaryVectors() const override
+        {
+            // ROEW is computed from the COPT vectors, see roew().
+            return this->node_.keyword.rfind("ROEW", 0) == 0;
         }
 
     private:
         Opm::EclIO::SummaryNode node_;
         ofun                    fcn_;
+        std::string             well_set_key_;
         int                     number_{0};
 
         std::string group_name() const
@@ -2732,7 +3073,8 @@ namespace Evaluator {
                     const double         /* stepSize */,
                     const InputData&        input,
                     const SimulatorResults& simRes,
-                    Opm::SummaryState&      st) const override
+                    const Opm::SummaryState& /* st */,
+                    Results&                result) const override
         {
             auto xPos = simRes.block.find(this->lookupKey());
             if (xPos == simRes.block.end()) {
@@ -2740,7 +3082,7 @@ namespace Evaluator {
             }
 
             const auto& usys = input.es.getUnits();
-            updateValue(this->node_, usys.from_si(this->m_, xPos->second), st);
+            result.update(this->node_, usys.from_si(this->m_, xPos->second));
         }
 
     private:
@@ -2766,7 +3108,8 @@ namespace Evaluator {
                     const double         /* stepSize */,
                     const InputData&        input,
                     const SimulatorResults& simRes,
-                    Opm::SummaryState&      st) const override
+                    const Opm::SummaryState& /* st */,
+                    Results&                result) const override
         {
             auto xPos = simRes.aquifers.find(this->node_.number);
             if (xPos == simRes.aquifers.end()) {
@@ -2774,7 +3117,7 @@ namespace Evaluator {
             }
 
             const auto& usys = input.es.getUnits();
-            updateValue(this->node_, usys.from_si(this->m_, xPos->second.get(this->node_.keyword)), st);
+            result.update(this->node_, usys.from_si(this->m_, xPos->second.get(this->node_.keyword)));
         }
     private:
         Opm::EclIO::SummaryNode  node_;
@@ -2794,7 +3137,8 @@ namespace Evaluator {
                     const double         /* stepSize */,
                     const InputData&        input,
                     const SimulatorResults& simRes,
-                    Opm::SummaryState&      st) const override
+                    const Opm::SummaryState& /* st */,
+                    Results&                result) const override
         {
             if (this->node_.number < 0)
                 return;
@@ -2810,7 +3154,7 @@ namespace Evaluator {
             const auto  val  = xPos->second[ix];
             const auto& usys = input.es.getUnits();
 
-            updateValue(this->node_, usys.from_si(this->m_, val), st);
+            result.update(this->node_, usys.from_si(this->m_, val));
         }
 
     private:
@@ -2841,7 +3185,8 @@ namespace Evaluator {
                     const double            stepSize,
                     const InputData&        input,
                     const SimulatorResults& simRes,
-                    Opm::SummaryState&      st) const override
+                    const Opm::SummaryState& /* st */,
+                    Results&                result) const override
         {
             if (this->component_ == Component::NumComponents) {
                 return;
@@ -2860,7 +3205,7 @@ namespace Evaluator {
             const auto& usys = input.es.getUnits();
             const auto  val  = this->getValue(flow->first, flow->second, stepSize);
 
-            updateValue(this->node_, usys.from_si(this->m_, val), st);
+            result.update(this->node_, usys.from_si(this->m_, val));
         }
 
     private:
@@ -3029,7 +3374,8 @@ namespace Evaluator {
                     const double         /* stepSize */,
                     const InputData&        input,
                     const SimulatorResults& simRes,
-                    Opm::SummaryState&      st) const override
+                    const Opm::SummaryState& /* st */,
+                    Results&                result) const override
         {
             auto xPos = simRes.single.find(this->node_.keyword);
             if (xPos == simRes.single.end())
@@ -3038,7 +3384,7 @@ namespace Evaluator {
             const auto  val  = xPos->second;
             const auto& usys = input.es.getUnits();
 
-            updateValue(this->node_, usys.from_si(this->m_, val), st);
+            result.update(this->node_, usys.from_si(this->m_, val));
         }
 
     private:
@@ -3053,7 +3399,8 @@ namespace Evaluator {
                     const double            /* stepSize */,
                     const InputData&        /* input */,
                     const SimulatorResults& /* simRes */,
-                    Opm::SummaryState&      /* st */) const override
+                    const Opm::SummaryState& /* st */,
+                    Results&                /* result */) const override
         {
             // No-op
         }
@@ -3070,15 +3417,18 @@ namespace Evaluator {
                     const double               stepSize,
                     const InputData&           input,
                     const SimulatorResults& /* simRes */,
-                    Opm::SummaryState&         st) const override
+                    const Opm::SummaryState&   st,
+                    Results&                   result) const override
         {
+            static const auto time_key = std::string { "TIME" };
+
             const auto& usys = input.es.getUnits();
 
             const auto m   = ::Opm::UnitSystem::measure::time;
             const auto val = st.get_elapsed() + stepSize;
 
-            st.update(this->saveKey_, usys.from_si(m, val));
-            st.update("TIME", usys.from_si(m, val));
+            result.update(this->saveKey_, usys.from_si(m, val));
+            result.update(time_key, usys.from_si(m, val));
         }
 
     private:
@@ -3096,10 +3446,11 @@ namespace Evaluator {
                     const double               stepSize,
                     const InputData&           input,
                     const SimulatorResults& /* simRes */,
-                    Opm::SummaryState&         st) const override
+                    const Opm::SummaryState&   st,
+                    Results&                   result) const override
         {
             auto sim_time = make_sim_time(input.sched, st, stepSize);
-            st.update(this->saveKey_, sim_time.day());
+            result.update(this->saveKey_, sim_time.day());
         }
 
     private:
@@ -3117,10 +3468,11 @@ namespace Evaluator {
                     const double               stepSize,
                     const InputData&           input,
                     const SimulatorResults& /* simRes */,
-                    Opm::SummaryState&         st) const override
+                    const Opm::SummaryState&   st,
+                    Results&                   result) const override
         {
             auto sim_time = make_sim_time(input.sched, st, stepSize);
-            st.update(this->saveKey_, sim_time.month());
+            result.update(this->saveKey_, sim_time.month());
         }
 
     private:
@@ -3138,10 +3490,11 @@ namespace Evaluator {
                     const double               stepSize,
                     const InputData&           input,
                     const SimulatorResults& /* simRes */,
-                    Opm::SummaryState&         st) const override
+                    const Opm::SummaryState&   st,
+                    Results&                   result) const override
         {
             auto sim_time = make_sim_time(input.sched, st, stepSize);
-            st.update(this->saveKey_, sim_time.year());
+            result.update(this->saveKey_, sim_time.year());
         }
 
     private:
@@ -3159,13 +3512,14 @@ namespace Evaluator {
                     const double               stepSize,
                     const InputData&        /* input */,
                     const SimulatorResults& /* simRes */,
-                    Opm::SummaryState&         st) const override
+                    const Opm::SummaryState&   st,
+                    Results&                   result) const override
         {
             using namespace ::Opm::unit;
 
             const auto val = st.get_elapsed() + stepSize;
 
-            st.update(this->saveKey_, convert::to(val, ecl_year));
+            result.update(this->saveKey_, convert::to(val, ecl_year));
         }
 
     private:
@@ -3768,6 +4122,11 @@ public:
               const InterRegFlowValues&          interreg_flows,
               SummaryState&                      st) const;
 
+    void setNumThreads(const std::size_t numThreads)
+    {
+        this->numThreads_ = std::max(numThreads, std::size_t{1});
+    }
+
     void internal_store(const SummaryState& st, const int report_step, bool isSubstep);
     void write(const bool is_final_summary);
     PAvgCalculatorCollection wbp_calculators(std::size_t report_step) const;
@@ -3797,6 +4156,11 @@ private:
 
     mutable int miniStepID_{0};
     mutable double prevEvalTime_{std::numeric_limits<double>::lowest()};
+    mutable EvaluationPlan plan_{};
+    mutable std::vector<Evaluator::Results> results_{};
+    mutable SlotCache slotCache_{};
+
+    std::size_t numThreads_{1};
 
     int prevCreate_{-1};
     int prevReportStepID_{-1};
@@ -3805,6 +4169,8 @@ private:
     SummaryOutputParameters                  outputParameters_{};
     std::unordered_map<std::string, EvalPtr> extra_parameters{};
     std::vector<std::string> valueKeys_{};
+    std::vector<std::optional<SummaryState::Handle>> valueHandles_{};
+    std::uint64_t valueHandlesLayout_{0};
     std::vector<std::string> valueUnits_{};
     std::vector<MiniStep>    unwritten_{};
 
@@ -3833,6 +4199,13 @@ private:
 
     void createSMSpecIfNecessary();
     void createSmryStreamIfNecessary(const int report_step);
+
+    void evaluate(const std::vector<const Evaluator::Base*>& evaluators,
+                  const int                                  sim_step,
+                  const double                               duration,
+                  const Evaluator::InputData&                input,
+                  const Evaluator::SimulatorResults&         simRes,
+                  SummaryState&                              st) const;
 };
 
 Opm::out::Summary::SummaryImplementation::
@@ -3874,7 +4247,9 @@ SummaryImplementation(const EclipseState&  es,
         std::filesystem::remove(esmryFileName);
 
     if ((writeEsmry) and (es.cfg().io().getFMTOUT()==false))
-        this->esmry_ = std::make_unique<Opm::EclIO::ExtSmryOutput>(this->valueKeys_, this->valueUnits_, es, sched.posixStartTime());
+        this->esmry_ = std::make_unique<Opm::EclIO::ExtSmryOutput>(this->valueKeys_, this->valueUnits_, es, sched.posixStartTime(),
+                                                                   es.cfg().io().getCompressedESMRY(),
+                                                                   es.cfg().io().getChunkedESMRY());
 
     if ((writeEsmry) and (es.cfg().io().getFMTOUT()))
         OpmLog::warning("ESMRY only supported for unformatted output.  Request ignored.");
@@ -3887,13 +4262,25 @@ internal_store(const SummaryState& st, const int report_step, bool isSubstep)
 
     const auto nParam = this->valueKeys_.size();
 
+    if ((this->valueHandles_.size() != nParam) ||
+        (this->valueHandlesLayout_ != st.layout_id()))
+    {
+        this->valueHandles_.clear();
+        for (const auto& key : this->valueKeys_) {
+            this->valueHandles_.push_back(st.handle(key));
+        }
+
+        this->valueHandlesLayout_ = st.layout_id();
+    }
+
+    const auto& values = st.slot_values();
     for (auto i = decltype(nParam){0}; i < nParam; ++i) {
-        if (! st.has(this->valueKeys_[i]))
+        if (! this->valueHandles_[i].has_value())
             // Parameter not yet evaluated (e.g., well/group not
             // yet active).  Nothing to do here.
             continue;
 
-        ms.params[i] = st.get(this->valueKeys_[i]);
+        ms.params[i] = values[this->valueHandles_[i]->slot];
     }
 }
 
@@ -3937,8 +4324,10 @@ eval(const int                          sim_step,
     single_values["TIMESTEP"] = duration;
     st.update("TIMESTEP", this->es_.get().getUnits().from_si(Opm::UnitSystem::measure::time, duration));
 
+    this->plan_.setStep(this->sched_, sim_step);
+
     const Evaluator::InputData input {
-        this->es_, this->sched_, this->grid_, this->regCache_, initial_inplace
+        this->es_, this->sched_, this->grid_, this->regCache_, initial_inplace, this->plan_
     };
 
     const Evaluator::SimulatorResults simRes {
@@ -3946,15 +4335,21 @@ eval(const int                          sim_step,
         region_values, block_values, aquifer_values, interreg_flows
     };
 
+    auto evaluators = std::vector<const Evaluator::Base*>{};
+    evaluators.reserve(this->outputParameters_.getEvaluators().size() +
+                       this->extra_parameters.size());
+
     for (auto& evalPtr : this->outputParameters_.getEvaluators()) {
-        evalPtr->update(sim_step, duration, input, simRes, st);
+        evaluators.push_back(evalPtr.get());
     }
 
     for (auto& [_, evalPtr] : this->extra_parameters) {
         (void)_;
-        evalPtr->update(sim_step, duration, input, simRes, st);
+        evaluators.push_back(evalPtr.get());
     }
 
+    this->evaluate(evaluators, sim_step, duration, input, simRes, st);
+
     st.update_elapsed(duration);
 
     if (secs_elapsed > this->prevEvalTime_) {
@@ -3963,6 +4358,100 @@ eval(const int                          sim_step,
     }
 }
 
+/*
+ * The evaluators are run in order.  Consecutive evaluators which do not
+ * read summary vectors of the same time step form a batch, which is split
+ * into one contiguous part per thread when the batch is large enough.  The
+ * buffered results of the parts are applied to the SummaryState in part
+ * order, so the SummaryState is the same as if all evaluators had been run
+ * sequentially.
+ */
+void
+Opm::out::Summary::SummaryImplementation::
+evaluate(const std::vector<const Evaluator::Base*>& evaluators,
+         const int                                  sim_step,
+         const double                               duration,
+         const Evaluator::InputData&                input,
+         const Evaluator::SimulatorResults&         simRes,
+         SummaryState&                              st) const
+{
+    // Smallest number of evaluators worth starting a thread for.
+    const auto min_part_size = std::ptrdiff_t{256};
+
+    // Discard results left over by an evaluator which threw in a
+    // previous call.
+    this->results_.resize(this->numThreads_);
+    for (auto& results : this->results_) {
+        results.clear();
+    }
+
+    auto run = [sim_step, duration, &input, &simRes, &st]
+        (auto first, auto last, Evaluator::Results& results)
+    {
+        for (; first != last; ++first) {
+            (*first)->update(sim_step, duration, input, simRes, st, results);
+        }
+    };
+
+    auto begin = evaluators.begin();
+    while (begin != evaluators.end()) {
+        auto end = std::find_if(begin, evaluators.end(),
+                                [](const Evaluator::Base* evaluator)
+                                {
+                                    return evaluator->readsSummaryVectors();
+                                });
+
+        if (end == begin) {
+            ++end;
+        }
+
+        const auto size = std::distance(begin, end);
+        const auto num_parts = std::min(static_cast<std::ptrdiff_t>(this->numThreads_),
+                                        size / min_part_size);
+
+        if (num_parts < 2) {
+            run(begin, end, this->results_[0]);
+            this->results_[0].apply(st, this->slotCache_);
+        }
+        else {
+            std::for_each(begin, end, [&input](const Evaluator::Base* evaluator)
+                                      { evaluator->prepare(input); });
+
+            std::vector<std::future<void>> workers;
+            for (std::ptrdiff_t part = 0; part < num_parts; ++part) {
+                const auto first = begin + part*size/num_parts;
+                const auto last  = begin + (part + 1)*size/num_parts;
+
+                workers.push_back(std::async(std::launch::async,
+                    [&run, &results = this->results_[part], first, last]()
+                    {
+                        run(first, last, results);
+                    }));
+            }
+
+            std::exception_ptr error;
+            for (auto& worker : workers) {
+                try {
+                    worker.get();
+                } catch (...) {
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+
+            for (std::ptrdiff_t part = 0; part < num_parts; ++part) {
+                this->results_[part].apply(st, this->slotCache_);
+            }
+        }
+
+        begin = end;
+    }
+}
+
 void Opm::out::Summary::SummaryImplementation::write(const bool is_final_summary)
 {
     const auto zero = std::vector<MiniStep>::size_type{0};
@@ -4414,6 +4903,11 @@ void Summary::add_timestep(const SummaryState& st, const int report_step, bool i
     this->pImpl_->internal_store(st, report_step, isSubstep);
 }
 
+void Summary::setNumThreads(const std::size_t numThreads)
+{
+    this->pImpl_->setNumThreads(numThreads);
+}
+
 void Summary::write(const bool is_final_summary) const
 {
     this->pImpl_->write(is_final_summary);
@@ -126,6 +126,32 @@ BOOST_AUTO_TEST_CASE(getKeywordList_OK) {
 }
 
 
+BOOST_AUTO_TEST_CASE(keyword_index_follows_addKeyword) {
+    Deck deck;
+    Parser parser;
+    for (std::size_t i = 0; i < 100; i++) {
+        deck.addKeyword( DeckKeyword( parser.getKeyword("GRID")));
+        deck.addKeyword( DeckKeyword( parser.getKeyword("EDIT")));
+
+        BOOST_CHECK( deck.hasKeyword("GRID") );
+        BOOST_CHECK_EQUAL( i + 1, deck.count("EDIT") );
+        BOOST_CHECK_EQUAL( 2*i + 1, deck.index("EDIT").back() );
+        BOOST_CHECK_EQUAL( deck["GRID"].back().name(), "GRID" );
+    }
+    BOOST_CHECK( !deck.hasKeyword("PROPS") );
+
+    Deck copy(deck);
+    copy.addKeyword( DeckKeyword( parser.getKeyword("PROPS")));
+    BOOST_CHECK( copy.hasKeyword("PROPS") );
+    BOOST_CHECK( !deck.hasKeyword("PROPS") );
+    BOOST_CHECK( copy.index("PROPS") == std::vector<std::size_t>{ 200 } );
+
+    Deck moved(std::move(copy));
+    BOOST_CHECK_EQUAL( moved.count("GRID"), 100U );
+    BOOST_CHECK_EQUAL( moved.getKeywordList("PROPS").size(), 1U );
+}
+
+
 BOOST_AUTO_TEST_CASE(keywordList_getbyindexoutofbounds_exceptionthrown) {
     Parser parser;
     Deck deck;
@@ -486,6 +512,34 @@ BOOST_AUTO_TEST_CASE(StringsWithSpaceOK) {
     BOOST_CHECK_EQUAL(" VALUE " , deckRecord.getItem(0).get< std::string >(0));
 }
 
+BOOST_AUTO_TEST_CASE(ItemsShareParserItemName) {
+    ParserItem itemInt("INTITEM", ParserItem::itype::INT);
+    ParserRecord record;
+    ParseContext parseContext;
+    ErrorGuard errors;
+    UnitSystem active_unitsystem(UnitSystem::UnitType::UNIT_TYPE_LAB);
+    KeywordLocation loc;
+    record.addItem( itemInt );
+
+    RawRecord rawRecord1( " 10 ", loc );
+    RawRecord rawRecord2( " 7 ", loc );
+
+    const auto deckRecord1 = record.parse( parseContext, errors , rawRecord1, active_unitsystem, active_unitsystem, loc);
+    const auto deckRecord2 = record.parse( parseContext, errors , rawRecord2, active_unitsystem, active_unitsystem, loc);
+    const auto& item1 = deckRecord1.getItem(0);
+    const auto& item2 = deckRecord2.getItem(0);
+
+    BOOST_CHECK_EQUAL( "INTITEM", item1.name() );
+    BOOST_CHECK_EQUAL( &item1.name(), &item2.name() );
+    BOOST_CHECK( item1.getData< int >() == std::vector< int >{ 10 } );
+    BOOST_CHECK( item2.getData< int >() == std::vector< int >{ 7 } );
+    BOOST_CHECK_THROW( item1.getData< double >(), std::invalid_argument );
+
+    DeckItem copy = item2;
+    BOOST_CHECK( copy == item2 );
+    BOOST_CHECK( copy != item1 );
+}
+
 BOOST_AUTO_TEST_CASE(DataKeyword) {
     Parser parser;
     DeckKeyword kw(parser.getKeyword("GRID"));
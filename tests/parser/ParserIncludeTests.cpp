@@ -24,15 +24,20 @@
 #include <filesystem>
 #include <iostream>
 #include <opm/common/utility/OpmInputError.hpp>
+#include <opm/input/eclipse/Parser/DeckCache.hpp>
 #include <opm/input/eclipse/Parser/Parser.hpp>
 #include <opm/input/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/input/eclipse/Deck/Deck.hpp>
 #include <opm/input/eclipse/Parser/ParseContext.hpp>
 #include <opm/input/eclipse/Parser/ErrorGuard.hpp>
 #include <opm/input/eclipse/Parser/InputErrorAction.hpp>
+#include <opm/json/JsonObject.hpp>
 
+#include <fstream>
 #include <iostream>
 
+#include <tests/WorkArea.hpp>
+
 inline std::string prefix() {
     return boost::unit_test::framework::master_test_suite().argv[1];
 }
@@ -141,3 +146,195 @@ BOOST_AUTO_TEST_CASE(ParserKeyword_includeWrongCase) {
 #endif
 }
 
+
+BOOST_AUTO_TEST_CASE(ParseFile_equals_ParseString) {
+    // Files are cleaned line by line while parsing, strings are cleaned up
+    // front; the resulting decks should be identical.
+    const std::string include_string = R"(-- Comment line
+PORO   -- Comment after keyword
+  0.1 0.2   -- Comment in data
+  0.3 /
+
+MULTFLT
+  'F--1'  1.0 /
+  'F2'  2.0 /
+/)";   // No trailing newline
+
+    const std::string deck_string = R"(RUNSPEC
+DIMENS
+ 1 1 3 /
+TITLE
+Title with -- comment
+GRID
+)";
+
+    WorkArea work;
+    {
+        std::ofstream os("INCLUDE.inc");
+        os << include_string;
+    }
+    {
+        std::ofstream os("CASE.DATA");
+        os << deck_string << "INCLUDE\n 'INCLUDE.inc' /\nEDIT\n";
+    }
+
+    Opm::Parser parser;
+    const auto file_deck = parser.parseFile("CASE.DATA");
+    const auto string_deck = parser.parseString(deck_string + include_string + "\nEDIT\n");
+
+    BOOST_CHECK_EQUAL(file_deck.size(), string_deck.size());
+    for (std::size_t index = 0; index < file_deck.size(); index++)
+        BOOST_CHECK(file_deck[index].equal(string_deck[index], false, false));
+
+    BOOST_CHECK_EQUAL(file_deck["MULTFLT"].back().size(), 2U);
+    BOOST_CHECK_EQUAL(file_deck["PORO"].back().getRecord(0).getItem(0).data_size(), 3U);
+}
+
+
+BOOST_AUTO_TEST_CASE(DeckCache_follows_include_files) {
+    WorkArea work;
+    const auto write_include = [](double poro) {
+        std::ofstream os("PORO.inc");
+        os << "PORO\n  3*" << poro << " /\n";
+    };
+
+    write_include(0.25);
+    {
+        std::ofstream os("CASE.DATA");
+        os << "RUNSPEC\nDIMENS\n 1 1 3 /\nGRID\nINCLUDE\n 'PORO.inc' /\n";
+    }
+
+    Opm::Parser parser;
+    parser.setDeckCache("cache");
+    const auto deck = parser.parseFile("CASE.DATA");
+
+    const Opm::DeckCache cache("cache");
+    BOOST_CHECK( std::filesystem::is_regular_file(cache.cacheFile("CASE.DATA")) );
+
+    const auto cached_deck = parser.parseFile("CASE.DATA");
+    BOOST_CHECK( deck == cached_deck );
+    BOOST_CHECK_EQUAL( cached_deck.getDataFile(), deck.getDataFile() );
+    BOOST_CHECK( cached_deck.tree().includes("CASE.DATA", "PORO.inc") );
+    BOOST_CHECK_EQUAL( cached_deck["PORO"].back().getRecord(0).getItem(0).get<double>(2), 0.25 );
+
+    // The entry is only valid for the same parser configuration.
+    BOOST_CHECK( !cache.load("CASE.DATA", 0).has_value() );
+
+    write_include(0.5);
+    const auto updated_deck = parser.parseFile("CASE.DATA");
+    BOOST_CHECK_EQUAL( updated_deck["PORO"].back().getRecord(0).getItem(0).get<double>(2), 0.5 );
+}
+
+BOOST_AUTO_TEST_CASE(DeckCache_key_and_warnings) {
+    WorkArea work;
+    {
+        std::ofstream os("CASE.DATA");
+        os << "RUNSPEC\nDIMENS\n 1 1 3 /\nGRID\nFOOBAR\n";
+    }
+    BOOST_CHECK_EQUAL( Opm::DeckCache::contentHash("CASE.DATA"),
+                       Opm::DeckCache::hash("RUNSPEC\nDIMENS\n 1 1 3 /\nGRID\nFOOBAR\n") );
+
+    Opm::ParseContext parseContext;
+    parseContext.update(Opm::ParseContext::PARSE_UNKNOWN_KEYWORD, Opm::InputErrorAction::WARN);
+    Opm::Parser parser;
+    parser.setDeckCache("cache");
+
+    Opm::ErrorGuard errors;
+    const auto deck = parser.parseFile("CASE.DATA", parseContext, errors);
+    BOOST_CHECK( !deck.hasKeyword("FOOBAR") );
+    BOOST_CHECK_EQUAL( errors.warnings().size(), 1U );
+
+    // The warnings from the original parse are replayed from the cache.
+    const Opm::DeckCache cache("cache");
+    BOOST_CHECK( std::filesystem::is_regular_file(cache.cacheFile("CASE.DATA")) );
+    Opm::ErrorGuard cached_errors;
+    const auto cached_deck = parser.parseFile("CASE.DATA", parseContext, cached_errors);
+    BOOST_CHECK( deck == cached_deck );
+    BOOST_CHECK( cached_errors.warnings() == errors.warnings() );
+
+    // The entry is not used when the keyword definitions change.
+    parser.addParserKeyword( Json::JsonObject( R"({"name" : "FOOBAR", "sections" : ["GRID"], "size" : 0})" ) );
+    Opm::ErrorGuard new_errors;
+    const auto new_deck = parser.parseFile("CASE.DATA", parseContext, new_errors);
+    BOOST_CHECK( new_deck.hasKeyword("FOOBAR") );
+    BOOST_CHECK( new_errors.warnings().empty() );
+}
+
+BOOST_AUTO_TEST_CASE(DeckCache_failed_store) {
+    WorkArea work;
+    {
+        std::ofstream os("CASE.DATA");
+        os << "RUNSPEC\nDIMENS\n 1 1 3 /\n";
+    }
+
+    // A non-empty directory in place of the cache file makes the final
+    // rename fail.
+    const Opm::DeckCache cache("cache");
+    const auto cache_file = cache.cacheFile("CASE.DATA");
+    std::filesystem::create_directories(cache_file / "blocker");
+
+    Opm::Parser parser;
+    parser.setDeckCache("cache");
+    const auto deck = parser.parseFile("CASE.DATA");
+    BOOST_CHECK( deck.hasKeyword("DIMENS") );
+
+    for (const auto& entry : std::filesystem::directory_iterator("cache"))
+        BOOST_CHECK_MESSAGE( entry.path().extension() != ".tmp",
+                             "Temporary cache file " << entry.path() << " left behind" );
+}
+
+BOOST_AUTO_TEST_CASE(ParseSections_skips_include_files) {
+    WorkArea work;
+    {
+        std::ofstream os("PORO.inc");
+        os << "PORO\n  3*0.25 /\n";
+    }
+    {
+        std::ofstream os("PVTW.inc");
+        os << "PVTW\n  1 1 1 1 1 /\n";
+    }
+    {
+        std::ofstream os("CASE.DATA");
+        os << R"(RUNSPEC
+DIMENS
+ 1 1 3 /
+TABDIMS
+/
+GRID
+INCLUDE
+ 'PORO.inc' /
+PROPS   -- No REGIONS or SUMMARY section
+INCLUDE
+ 'PVTW.inc' /
+SOLUTION
+INCLUDE
+ 'MISSING_SOLUTION.inc' /
+SCHEDULE
+INCLUDE
+ 'MISSING_SCHEDULE.inc' /
+)";
+    }
+
+    // The include files in the skipped sections are never opened.
+    Opm::Parser parser;
+    Opm::ParseContext parseContext;
+    Opm::ErrorGuard errors;
+    parseContext.update(Opm::ParseContext::PARSE_MISSING_INCLUDE, Opm::InputErrorAction::THROW_EXCEPTION);
+    const auto grid_deck = parser.parseFile("CASE.DATA", parseContext, errors, {Opm::Ecl::GRID});
+    BOOST_CHECK( !errors );
+    BOOST_CHECK( grid_deck.hasKeyword("DIMENS") );
+    BOOST_CHECK( grid_deck.hasKeyword("GRID") );
+    BOOST_CHECK_EQUAL( grid_deck["PORO"].back().getRecord(0).getItem(0).get<double>(2), 0.25 );
+    BOOST_CHECK( !grid_deck.hasKeyword("PROPS") );
+    BOOST_CHECK( !grid_deck.hasKeyword("PVTW") );
+    BOOST_CHECK( !grid_deck.tree().includes("CASE.DATA", "PVTW.inc") );
+
+    const auto props_deck = parser.parseFile("CASE.DATA", parseContext, errors, {Opm::Ecl::PROPS});
+    BOOST_CHECK( !errors );
+    BOOST_CHECK( props_deck.hasKeyword("PROPS") );
+    BOOST_CHECK( props_deck.hasKeyword("PVTW") );
+    BOOST_CHECK( !props_deck.hasKeyword("GRID") );
+    BOOST_CHECK( !props_deck.hasKeyword("PORO") );
+
+    BOOST_CHECK_THROW( parser.parseFile("CASE.DATA", parseContext, errors, {Opm::Ecl::SOLUTION}), std::exception );
+}
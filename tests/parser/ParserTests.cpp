@@ -124,6 +124,49 @@ BOOST_AUTO_TEST_CASE(getKeyword_hasnotkeyword_getKeywordThrowsException) {
     BOOST_CHECK_THROW(parser.getParserKeywordFromDeckName("FJASS"), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(findParserKeyword_returnsStoredKeyword) {
+    Parser parser;
+    parser.addParserKeyword( createDynamicSized( "FJAS" ) );
+    const auto* keyword = parser.findParserKeyword("FJAS");
+    BOOST_REQUIRE(keyword != nullptr);
+    BOOST_CHECK_EQUAL(keyword, &parser.getParserKeywordFromDeckName("FJAS"));
+    BOOST_CHECK(parser.findParserKeyword("FJASS") == nullptr);
+    BOOST_CHECK(parser.findParserKeyword("fjas") == nullptr);
+
+    // Wildcard keywords are matched on the deck name.
+    BOOST_REQUIRE(parser.findParserKeyword("GUOPR") != nullptr);
+    BOOST_CHECK_EQUAL(parser.findParserKeyword("GUOPR")->getName(), "GROUP_PROBE");
+}
+
+BOOST_AUTO_TEST_CASE(lazyKeyword_constructedOnLookup) {
+    Parser parser( false );
+    parser.addLazyParserKeyword("FJAS", []() { return createDynamicSized("FJAS"); });
+    BOOST_CHECK_EQUAL(parser.size(), 1U);
+    BOOST_CHECK(parser.hasKeyword("FJAS"));
+
+    const auto* keyword = parser.findParserKeyword("FJAS");
+    BOOST_REQUIRE(keyword != nullptr);
+    BOOST_CHECK_EQUAL(keyword->getName(), "FJAS");
+    BOOST_CHECK_EQUAL(keyword, parser.findParserKeyword("FJAS"));
+    BOOST_CHECK_EQUAL(keyword, &parser.getKeyword("FJAS"));
+
+    // A keyword added later replaces the lazy keyword.
+    auto replacement = createFixedSized("FJAS", 1);
+    parser.addParserKeyword( replacement );
+    BOOST_CHECK_EQUAL(parser.size(), 1U);
+    BOOST_CHECK(parser.getKeyword("FJAS").hasFixedSize());
+}
+
+BOOST_AUTO_TEST_CASE(defaultKeywords_parsed) {
+    Parser parser;
+    BOOST_CHECK(parser.isRecognizedKeyword("PORO"));
+    BOOST_CHECK(parser.isRecognizedKeyword("PYINPUT"));
+    BOOST_CHECK_EQUAL(parser.getKeyword("PORO").getName(), "PORO");
+
+    const auto deck = parser.parseString("RUNSPEC\nDIMENS\n 1 1 2 /\nGRID\nPORO\n 2*0.25 /\n");
+    BOOST_CHECK_EQUAL(deck["PORO"].back().getRecord(0).getItem(0).get<double>(1), 0.25);
+}
+
 BOOST_AUTO_TEST_CASE(getAllDeckNames_hasTwoKeywords_returnsCompleteList) {
     Parser parser( false );
     std::cout << parser.getAllDeckNames().size() << std::endl;
@@ -696,6 +739,28 @@ BOOST_AUTO_TEST_CASE(Scan_All_WithDefaults) {
     BOOST_CHECK_EQUAL(25, deckIntItem.get< int >(21));
 }
 
+BOOST_AUTO_TEST_CASE(Scan_All_DoubleData) {
+    ParserItem itemDouble("ITEM", DOUBLE);
+    itemDouble.setSizeType(ParserItem::item_size::ALL);
+    itemDouble.setDefault(2.5);
+
+    RawRecord rawRecord( " 1.0  2*0.5 3* 1.5D+2\n-7 2*1.23456789012345678 ", KeywordLocation("KW", "File", 100) );
+    UnitSystem unit_system;
+    const auto item = itemDouble.scan(rawRecord, unit_system, unit_system);
+    BOOST_CHECK_EQUAL(rawRecord.size(), 0U);
+    BOOST_CHECK_EQUAL(10U, item.data_size());
+    BOOST_CHECK_EQUAL(1.0, item.get< double >(0));
+    BOOST_CHECK_EQUAL(0.5, item.get< double >(2));
+    BOOST_CHECK( item.defaultApplied(3) );
+    BOOST_CHECK_EQUAL(2.5, item.get< double >(5));
+    BOOST_CHECK_EQUAL(150.0, item.get< double >(6));
+    BOOST_CHECK_EQUAL(-7.0, item.get< double >(7));
+    BOOST_CHECK_CLOSE(1.23456789012345678, item.get< double >(9), 1e-12);
+
+    RawRecord badRecord( "1.0 2*1.0X", KeywordLocation("KW", "File", 100) );
+    BOOST_CHECK_THROW(itemDouble.scan(badRecord, unit_system, unit_system), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(Scan_SINGLE_CorrectIntSetInDeckItem) {
     ParserItem itemInt(std::string("ITEM2"), INT);
 
@@ -2964,3 +3029,111 @@ END
 }
 
 BOOST_AUTO_TEST_SUITE_END() // Parse_ROCK
+
+namespace {
+
+std::string large_data_deck(const std::string& permx_tail = "")
+{
+    std::ostringstream deck;
+    deck << R"(RUNSPEC
+OIL
+WATER
+DIMENS
+  20 20 40 /
+TABDIMS
+  2 /
+GRID
+PORO
+)";
+    for (std::size_t i = 0; i < 16000; ++i)
+        deck << "  " << 0.1 + (i % 1000) * 1.0e-4 << '\n';
+
+    deck << "/\nPERMX\n";
+    for (std::size_t i = 0; i < 15999; ++i)
+        deck << "  " << 100 + i << ".5\n";
+
+    deck << "  1000" << permx_tail << " /\n" << R"(NTG
+  16000*1.0 /
+PROPS
+SWOF
+  0.2 0.0 1.0 0.0
+  1.0 1.0 0.0 0.0 /
+  0.2 0.0 1.0 0.0
+  1.0 1.0 0.0 0.0 /
+END
+)";
+    return deck.str();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(Parse_Threaded_Same_Deck)
+{
+    const auto input = large_data_deck();
+    Parser parser;
+    BOOST_CHECK_EQUAL(parser.numThreads(), 1U);
+
+    const auto deck = parser.parseString(input);
+
+    parser.setNumThreads(4);
+    BOOST_CHECK_EQUAL(parser.numThreads(), 4U);
+    const auto threaded_deck = parser.parseString(input);
+
+    BOOST_CHECK_EQUAL(deck.size(), threaded_deck.size());
+    for (std::size_t index = 0; index < deck.size(); ++index)
+        BOOST_CHECK_EQUAL(deck[index].name(), threaded_deck[index].name());
+
+    BOOST_CHECK( deck == threaded_deck );
+    BOOST_CHECK( deck.getActiveUnitSystem() == threaded_deck.getActiveUnitSystem() );
+    BOOST_CHECK( deck.getDefaultUnitSystem() == threaded_deck.getDefaultUnitSystem() );
+    BOOST_CHECK( threaded_deck.getActiveUnitSystem().hasDimension("Permeability") );
+    BOOST_CHECK_EQUAL( threaded_deck["PORO"].back().getDataSize(), 16000U );
+    BOOST_CHECK_EQUAL( threaded_deck["PERMX"].back().getRecord(0).getItem(0).getSIDouble(15999),
+                       deck["PERMX"].back().getRecord(0).getItem(0).getSIDouble(15999) );
+    BOOST_CHECK_EQUAL( threaded_deck["SWOF"].back().size(), 2U );
+
+    parser.setNumThreads(0);
+    BOOST_CHECK_EQUAL(parser.numThreads(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(Parse_Threaded_Parse_Error)
+{
+    // MINPV has one item - the extra data is reported while the large data
+    // keywords before it are still pending.
+    auto input = large_data_deck();
+    input.insert(input.find("NTG\n"), "MINPV\n  1.0 2.0 /\n");
+
+    Parser parser;
+    BOOST_CHECK_THROW( parser.parseString(input), OpmInputError );
+
+    parser.setNumThreads(4);
+    BOOST_CHECK_THROW( parser.parseString(input), OpmInputError );
+
+    ParseContext parseContext;
+    parseContext.update(ParseContext::PARSE_EXTRA_DATA, InputErrorAction::WARN);
+    ErrorGuard errors;
+    ErrorGuard threaded_errors;
+
+    parser.setNumThreads(1);
+    const auto deck = parser.parseString(input, parseContext, errors);
+
+    parser.setNumThreads(4);
+    const auto threaded_deck = parser.parseString(input, parseContext, threaded_errors);
+
+    BOOST_CHECK( deck == threaded_deck );
+    BOOST_CHECK( deck.getActiveUnitSystem() == threaded_deck.getActiveUnitSystem() );
+    BOOST_CHECK( deck.getDefaultUnitSystem() == threaded_deck.getDefaultUnitSystem() );
+    BOOST_CHECK_EQUAL( errors.warnings().size(), 1U );
+    BOOST_CHECK( errors.warnings() == threaded_errors.warnings() );
+    BOOST_CHECK( !threaded_errors );
+}
+
+BOOST_AUTO_TEST_CASE(Parse_Threaded_Invalid_Data)
+{
+    const auto input = large_data_deck("X");
+    Parser parser;
+    BOOST_CHECK_THROW( parser.parseString(input), OpmInputError );
+
+    parser.setNumThreads(4);
+    BOOST_CHECK_THROW( parser.parseString(input), OpmInputError );
+}
@@ -33,6 +33,7 @@
 
 #include <opm/common/utility/ActiveGridCells.hpp>
 #include <opm/common/utility/TimeService.hpp>
+#include <opm/common/utility/shmatch.hpp>
 #include <opm/common/utility/OpmInputError.hpp>
 
 #include <opm/io/eclipse/ERst.hpp>
@@ -3740,6 +3741,21 @@ BOOST_AUTO_TEST_CASE(WellOrderTest) {
     BOOST_CHECK( !wo.has("G1"));
 }
 
+BOOST_AUTO_TEST_CASE(NameOrderPattern) {
+    NameOrder wo({"PROD2", "INJ1", "PROD10", "PROD1", "P", "INJ2"});
+
+    BOOST_CHECK( wo.names(ShellPattern("PROD*")) == std::vector<std::string>({"PROD2", "PROD10", "PROD1"}) );
+    BOOST_CHECK( wo.names(ShellPattern("PROD?")) == std::vector<std::string>({"PROD2", "PROD1"}) );
+    BOOST_CHECK( wo.names(ShellPattern("*1")) == std::vector<std::string>({"INJ1", "PROD1"}) );
+    BOOST_CHECK( wo.names(ShellPattern("P*")) == std::vector<std::string>({"PROD2", "PROD10", "PROD1", "P"}) );
+    BOOST_CHECK( wo.names(ShellPattern("INJ1")) == std::vector<std::string>({"INJ1"}) );
+    BOOST_CHECK( wo.names(ShellPattern("INJ")).empty() );
+    BOOST_CHECK( wo.names(ShellPattern("X*")).empty() );
+
+    wo.add("PROD0");
+    BOOST_CHECK( wo.names(ShellPattern("PROD?")) == std::vector<std::string>({"PROD2", "PROD1", "PROD0"}) );
+}
+
 BOOST_AUTO_TEST_CASE(GroupOrderTest) {
     const std::size_t max_groups = 9;
     GroupOrder go(max_groups);
@@ -3763,6 +3779,20 @@ BOOST_AUTO_TEST_CASE(GroupOrderTest) {
         BOOST_CHECK( !restart_groups[g].has_value() );
 }
 
+BOOST_AUTO_TEST_CASE(GroupOrderPattern) {
+    GroupOrder go(5);
+    go.add("G2");
+    go.add("G1");
+    go.add("PLAT");
+    go.add("G1");
+
+    BOOST_CHECK( go.names() == std::vector<std::string>({"FIELD", "G2", "G1", "PLAT"}) );
+    BOOST_CHECK( go.has("G1") );
+    BOOST_CHECK( !go.has("G3") );
+    BOOST_CHECK( go.names(ShellPattern("G*")) == std::vector<std::string>({"G2", "G1"}) );
+    BOOST_CHECK( go.names(ShellPattern("*L*")) == std::vector<std::string>({"FIELD", "PLAT"}) );
+}
+
 
 
 
@@ -125,3 +125,25 @@ BOOST_AUTO_TEST_CASE( readValueToken_basic_validity_tests ) {
     BOOST_CHECK_EQUAL( "123*456", Opm::readValueToken<std::string>( std::string( "123*456" ) ) );
     BOOST_CHECK_EQUAL( "123*456", Opm::readValueToken<std::string>( std::string( "'123*456'" ) ) );
 }
+
+BOOST_AUTO_TEST_CASE( tryReadValueToken_same_as_readValueToken ) {
+    for (const auto* token : { "0", "-0.0", "+3.3", "3.3d0", "3.3E-2", ".25", "7.", "1.5D+5", "123456789012345", "0.1e22", "-4.7e-21" }) {
+        double value = 0;
+        BOOST_CHECK_MESSAGE( Opm::tryReadValueToken<double>( token, value ), token );
+        BOOST_CHECK_EQUAL( value, Opm::readValueToken<double>( token ) );
+    }
+
+    for (const auto* token : { "1234567890123456", "1e23", "4.7e-22", "1.0E", "1.0.0", "nan", "3*", "'1.0'", "" }) {
+        double value = 0;
+        BOOST_CHECK_MESSAGE( !Opm::tryReadValueToken<double>( token, value ), token );
+    }
+
+    int ivalue = 0;
+    BOOST_CHECK( Opm::tryReadValueToken<int>( "+17", ivalue ) );
+    BOOST_CHECK_EQUAL( ivalue, 17 );
+    BOOST_CHECK( Opm::tryReadValueToken<int>( "-17", ivalue ) );
+    BOOST_CHECK_EQUAL( ivalue, -17 );
+    BOOST_CHECK( !Opm::tryReadValueToken<int>( "2147483647", ivalue ) );
+    BOOST_CHECK( !Opm::tryReadValueToken<int>( "3.3", ivalue ) );
+}
+
@@ -149,4 +149,42 @@ BOOST_AUTO_TEST_CASE(match_test) {
     BOOST_CHECK( !shmatch("NAME.*", "NAME") );
 }
 
+BOOST_AUTO_TEST_CASE(shell_pattern) {
+    const ShellPattern literal("OP_1");
+    BOOST_CHECK( literal.isLiteral() );
+    BOOST_CHECK_EQUAL( literal.literalPrefix(), "OP_1" );
+    BOOST_CHECK( literal.match("OP_1") );
+    BOOST_CHECK( !literal.match("OP_12") );
+
+    const ShellPattern prefix("OP*");
+    BOOST_CHECK( !prefix.isLiteral() );
+    BOOST_CHECK_EQUAL( prefix.literalPrefix(), "OP" );
+    BOOST_CHECK( prefix.match("OP") );
+    BOOST_CHECK( prefix.match("OP_1") );
+    BOOST_CHECK( !prefix.match("WOP") );
+
+    const ShellPattern stars("*A*B*");
+    BOOST_CHECK_EQUAL( stars.literalPrefix(), "" );
+    BOOST_CHECK( stars.match("AB") );
+    BOOST_CHECK( stars.match("XAXAXBX") );
+    BOOST_CHECK( !stars.match("BA") );
+
+    const ShellPattern backtrack("*AB?");
+    BOOST_CHECK( backtrack.match("AABAB1") );
+    BOOST_CHECK( !backtrack.match("AABAB") );
+
+    const ShellPattern sets("W[!0-4][ab-]");
+    BOOST_CHECK( sets.match("W5a") );
+    BOOST_CHECK( sets.match("W9-") );
+    BOOST_CHECK( !sets.match("W3a") );
+    BOOST_CHECK( !sets.match("W5c") );
+
+    BOOST_CHECK( shmatch("W[]]", "W]") );
+    BOOST_CHECK( shmatch("W[", "W[") );
+    BOOST_CHECK( shmatch("W\\*", "W*") );
+    BOOST_CHECK( !shmatch("W\\*", "W1") );
+    BOOST_CHECK( shmatch("", "") );
+    BOOST_CHECK( !shmatch("", "W") );
+}
+
 
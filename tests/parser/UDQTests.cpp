@@ -21,7 +21,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <opm/common/utility/MemPacker.hpp>
 #include <opm/common/utility/OpmInputError.hpp>
+#include <opm/common/utility/Serializer.hpp>
 #include <opm/common/utility/TimeService.hpp>
 
 #include <opm/input/eclipse/EclipseState/EclipseState.hpp>
@@ -33,12 +35,14 @@
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
 #include <opm/input/eclipse/Schedule/SummaryState.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQActive.hpp>
+#include <opm/input/eclipse/Schedule/UDQ/UDQASTNode.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQAssign.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQConfig.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQContext.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQEnums.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQFunction.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQFunctionTable.hpp>
+#include <opm/input/eclipse/Schedule/UDQ/UDQProgram.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQSet.hpp>
 #include <opm/input/eclipse/Schedule/UDQ/UDQState.hpp>
 #include <opm/input/eclipse/Schedule/Well/NameOrder.hpp>
@@ -143,6 +147,30 @@ BOOST_AUTO_TEST_CASE(SUBTRACT)
     BOOST_CHECK_EQUAL( res2[0].get(), 16.0);
 }
 
+BOOST_AUTO_TEST_CASE(UNPACK_RESETS_PROGRAM)
+{
+    KeywordLocation location;
+    UDQParams udqp;
+    UDQFunctionTable udqft;
+    UDQDefine def(udqp, "WU", 0, location, {"16", "-", "8", "-", "4", "-", "2", "-", "1"});
+    const UDQDefine scalar(udqp, "WU", 0, location, {"16"});
+
+    SummaryState st(TimeService::now());
+    UDQState udq_state(udqp.undefinedValue());
+    WellMatcher wm(NameOrder({"P1"}));
+    UDQContext context(udqft, wm, st, udq_state);
+
+    // Compiles and caches the program of the first expression.
+    BOOST_CHECK_EQUAL( def.eval(context)[0].get(), 1.0);
+
+    Serialization::MemPacker packer;
+    Serializer ser(packer);
+    ser.pack(scalar);
+    ser.unpack(def);
+
+    BOOST_CHECK_EQUAL( def.eval(context)[0].get(), 16.0);
+}
+
 BOOST_AUTO_TEST_CASE(TEST)
 {
     KeywordLocation location;
@@ -205,6 +233,108 @@ BOOST_AUTO_TEST_CASE(MIX_SCALAR) {
     BOOST_CHECK_EQUAL( res_add["P1"].get() , 2);
 }
 
+BOOST_AUTO_TEST_CASE(UDQ_PROGRAM) {
+    UDQParams udqp;
+    UDQFunctionTable udqft(udqp);
+    SummaryState st(TimeService::now());
+    UDQState udq_state(udqp.undefinedValue());
+    WellMatcher wm(NameOrder({"OP1", "OP2", "OP3", "OP4", "WI1", "WI2"}));
+    UDQContext context(udqft, wm, st, udq_state);
+
+    // OP3 has no WOPR value, and OP2 and WI1 have the same WOPR.
+    st.update_well_var("OP1", "WOPR", 100);
+    st.update_well_var("OP2", "WOPR", 50);
+    st.update_well_var("OP4", "WOPR", 0);
+    st.update_well_var("WI1", "WOPR", 50);
+    st.update_well_var("WI2", "WOPR", 250);
+    st.update_well_var("OP1", "WWCT", 0.25);
+    st.update_well_var("OP2", "WWCT", 0.5);
+    st.update_well_var("OP3", "WWCT", 0.75);
+    st.update_well_var("OP4", "WWCT", 0.5);
+    st.update_well_var("WI1", "WWCT", 1);
+    st.update_well_var("WI2", "WWCT", 0.125);
+    st.update_group_var("G1", "GOPR", 150);
+    st.update_group_var("G2", "GOPR", 250);
+    st.update_group_var("FIELD", "GOPR", 400);
+    st.update("FOPR", 400);
+
+    using TT = UDQTokenType;
+    const auto wopr = UDQASTNode(TT::ecl_expr, "WOPR", std::vector<std::string>{});
+    const auto wwct = UDQASTNode(TT::ecl_expr, "WWCT", std::vector<std::string>{});
+    const auto gopr = UDQASTNode(TT::ecl_expr, "GOPR", std::vector<std::string>{});
+    const auto fopr = UDQASTNode(TT::ecl_expr, "FOPR", std::vector<std::string>{});
+    const auto wopr_op = UDQASTNode(TT::ecl_expr, "WOPR", std::vector<std::string>{"OP*"});
+    const auto wopr_op1 = UDQASTNode(TT::ecl_expr, "WOPR", std::vector<std::string>{"OP1"});
+    const auto binary = [](TT type, const std::string& op, const UDQASTNode& lhs, const UDQASTNode& rhs)
+    {
+        return UDQASTNode(type, op, lhs, rhs);
+    };
+    const auto func = [](TT type, const std::string& name, const UDQASTNode& arg)
+    {
+        return UDQASTNode(type, name, arg);
+    };
+
+    const auto check = [&context](const UDQASTNode& ast, const UDQVarType target)
+    {
+        const UDQProgram program(ast, target);
+        BOOST_REQUIRE( program.valid() );
+
+        const auto compiled = program.eval(context);
+        BOOST_REQUIRE( compiled.has_value() );
+
+        auto expected = ast.eval(target, context);
+        expected.name(compiled->name());
+        BOOST_CHECK( *compiled == expected );
+    };
+
+    const auto well = UDQVarType::WELL_VAR;
+    check( binary(TT::binary_op_add, "+", wopr, binary(TT::binary_op_mul, "*", UDQASTNode(2.0), wwct)), well );
+    check( binary(TT::binary_op_div, "/", -1.0 * wwct, wopr), well );
+    check( binary(TT::binary_op_sub, "-", wopr_op, wopr_op1), well );
+    check( binary(TT::binary_op_pow, "^", wopr, UDQASTNode(2.0)), well );
+    check( binary(TT::binary_op_uadd, "UADD", wopr_op, wwct), well );
+    check( binary(TT::binary_op_umin, "UMIN", wopr, wwct), well );
+    check( binary(TT::binary_op_umax, "UMAX", wopr_op, wopr), well );
+    check( binary(TT::binary_op_umul, "UMUL", wopr_op, wwct), well );
+    check( binary(TT::binary_cmp_gt, ">", wopr, UDQASTNode(50.0)), well );
+    check( binary(TT::binary_cmp_lt, "<", wopr, wopr_op1), well );
+    check( binary(TT::binary_cmp_le, "<=", wwct, UDQASTNode(0.5)), well );
+    check( binary(TT::binary_cmp_ge, ">=", wwct, UDQASTNode(0.5)), well );
+    check( binary(TT::binary_cmp_eq, "==", wwct, UDQASTNode(0.5)), well );
+    check( binary(TT::binary_cmp_ne, "!=", wwct, UDQASTNode(0.5)), well );
+    check( func(TT::elemental_func_sorta, "SORTA", wopr), well );
+    check( func(TT::elemental_func_sortd, "SORTD", wopr), well );
+    check( func(TT::elemental_func_undef, "UNDEF", wopr_op), well );
+    check( func(TT::elemental_func_idv, "IDV", wopr_op), well );
+    check( func(TT::elemental_func_def, "DEF", wopr), well );
+    check( func(TT::elemental_func_abs, "ABS", -1.0 * wopr), well );
+    check( func(TT::elemental_func_nint, "NINT", binary(TT::binary_op_mul, "*", wwct, UDQASTNode(10.0))), well );
+    check( func(TT::elemental_func_exp, "EXP", wwct), well );
+    check( func(TT::elemental_func_ln, "LN", wwct), well );
+    check( func(TT::elemental_func_log, "LOG", wwct), well );
+
+    check( binary(TT::binary_op_mul, "*", func(TT::scalar_func_sum, "SUM", wopr), UDQASTNode(1.25)), well );
+    check( binary(TT::binary_op_sub, "-", wopr, func(TT::scalar_func_avea, "AVEA", wopr)), well );
+    for (const auto& [type, name] : std::vector<std::pair<TT, std::string>> {
+            {TT::scalar_func_sum, "SUM"}, {TT::scalar_func_avea, "AVEA"}, {TT::scalar_func_aveg, "AVEG"},
+            {TT::scalar_func_aveh, "AVEH"}, {TT::scalar_func_max, "MAX"}, {TT::scalar_func_min, "MIN"},
+            {TT::scalar_func_norm1, "NORM1"}, {TT::scalar_func_norm2, "NORM2"}, {TT::scalar_func_normi, "NORMI"},
+            {TT::scalar_func_prod, "PROD"}})
+    {
+        check( func(type, name, wwct), UDQVarType::FIELD_VAR );
+    }
+
+    check( binary(TT::binary_op_add, "+", gopr, UDQASTNode(2.0)), UDQVarType::GROUP_VAR );
+    check( binary(TT::binary_op_div, "/", fopr, func(TT::scalar_func_sum, "SUM", gopr)), UDQVarType::FIELD_VAR );
+    check( func(TT::scalar_func_sum, "SUM", func(TT::elemental_func_undef, "UNDEF", wwct)), UDQVarType::FIELD_VAR );
+
+    // Relative comparison with zero on the left hand side, and function
+    // arguments out of range, are left to the expression tree.
+    BOOST_CHECK( ! UDQProgram(binary(TT::binary_cmp_eq, "==", wopr, UDQASTNode(1.0)), well).eval(context).has_value() );
+    BOOST_CHECK( ! UDQProgram(func(TT::elemental_func_ln, "LN", wopr), well).eval(context).has_value() );
+    BOOST_CHECK( ! UDQProgram(func(TT::elemental_func_randn, "RANDN", wopr), well).valid() );
+}
+
 BOOST_AUTO_TEST_CASE(UDQ_TABLE_EXCEPTION) {
     UDQParams udqp;
     KeywordLocation location;
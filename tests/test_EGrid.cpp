@@ -344,3 +344,66 @@ BOOST_AUTO_TEST_CASE(lgr_1) {
         BOOST_CHECK_EQUAL(grid1.ijk_from_global_index(hostcells_gind[n]) == hostcells_ijk[n], true);
 }
 
+
+BOOST_AUTO_TEST_CASE(geometry_cache) {
+
+    using GridFile = std::pair<std::string, std::string>;
+
+    for (const auto& [filename, grid_name] : { GridFile{"SPE1CASE1.EGRID", "global"}, GridFile{"LGR_TESTMOD.EGRID", "global"},
+                                               GridFile{"LGR_TESTMOD.EGRID", "LGR1"}, GridFile{"LGR_TESTMOD.EGRID", "LGR2"} }) {
+
+        EGrid ref_grid(filename, grid_name);
+        const auto nijk = ref_grid.dimension();
+
+        std::vector<std::array<int, 3>> ijk_list;
+
+        // cells in reverse order, visiting rows of cells in all layers
+        for (int k = nijk[2] - 1; k >= 0; k--)
+            for (int j = nijk[1] - 1; j >= 0; j--)
+                for (int i = nijk[0] - 1; i >= 0; i--)
+                    ijk_list.push_back({i, j, k});
+
+        // a cache which only holds the tiles of one cell, and one which holds the complete grid
+        for (const std::size_t max_bytes : { std::size_t{1}, std::size_t{1} << 20 }) {
+            EGrid grid(filename, grid_name);
+            grid.setGeometryCacheSize(max_bytes);
+
+            std::vector<std::array<double,8>> X, Y, Z;
+            grid.getCellCorners(ijk_list, X, Y, Z);
+
+            BOOST_REQUIRE_EQUAL(X.size(), ijk_list.size());
+
+            std::array<double,8> ref_X, ref_Y, ref_Z;
+            std::array<double,8> X1, Y1, Z1;
+
+            for (size_t n = 0; n < ijk_list.size(); n++) {
+                ref_grid.getCellCorners(ijk_list[n], ref_X, ref_Y, ref_Z);
+                grid.getCellCorners(ijk_list[n], X1, Y1, Z1);
+
+                BOOST_CHECK(X[n] == ref_X);
+                BOOST_CHECK(Y[n] == ref_Y);
+                BOOST_CHECK(Z[n] == ref_Z);
+
+                BOOST_CHECK(X1 == ref_X);
+                BOOST_CHECK(Y1 == ref_Y);
+                BOOST_CHECK(Z1 == ref_Z);
+            }
+
+            EGrid ref_layer_grid(filename, grid_name);
+            const std::array<int, 4> box = {0, nijk[0] - 1, nijk[1] / 2, nijk[1] - 1};
+
+            for (const bool bottom : { false, true }) {
+                const auto xyz = grid.getXYZ_layer(nijk[2] - 1, box, bottom);
+                const auto ref_xyz = ref_layer_grid.getXYZ_layer(nijk[2] - 1, box, bottom);
+
+                BOOST_CHECK(xyz == ref_xyz);
+            }
+        }
+    }
+
+    EGrid grid("SPE1CASE1.EGRID");
+    grid.setGeometryCacheSize(1 << 20);
+
+    std::vector<std::array<double,8>> X, Y, Z;
+    BOOST_CHECK_THROW(grid.getCellCorners(std::vector<std::array<int, 3>>{{0, 10, 0}}, X, Y, Z), std::invalid_argument);
+}
@@ -32,6 +32,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <math.h>
 #include <stdio.h>
 #include <tuple>
@@ -420,6 +421,75 @@ BOOST_AUTO_TEST_CASE(TestESmry_5) {
 
 
 
+BOOST_AUTO_TEST_CASE(TestESmry_loadData_subset) {
+
+    // Large enough for the PARAMS arrays to span several binary blocks, and
+    // for the requested vectors to be read with more than one read per ministep.
+    const int nParams = 12000;
+    const int nSteps = 3;
+
+    std::vector<std::string> keywords(nParams, "WBHP");
+    std::vector<std::string> wgnames(nParams);
+    std::vector<std::string> units(nParams, "BARSA");
+    std::vector<int> nums(nParams, 0);
+
+    keywords[0] = "TIME";
+    wgnames[0] = ":+:+:+:+";
+    units[0] = "DAYS";
+    for (int i = 1; i < nParams; i++)
+        wgnames[i] = "W" + std::to_string(i);
+
+    WorkArea work;
+    for (const bool formatted : { false, true }) {
+        const std::string smspecFile = formatted ? "TMP1.FSMSPEC" : "TMP1.SMSPEC";
+        {
+            Opm::EclIO::EclOutput smspec(smspecFile, formatted);
+            smspec.write<int>("INTEHEAD", {1,100});
+            std::vector<std::string> restart (9,"");
+            smspec.write("RESTART", restart);
+            smspec.write<int>("DIMENS", {nParams, 13, 22, 11, 0, 0});
+            smspec.write("KEYWORDS", keywords);
+            smspec.write("WGNAMES", wgnames);
+            smspec.write("NUMS", nums);
+            smspec.write("UNITS", units);
+            smspec.write<int>("STARTDAT", {1, 11, 2018, 0, 0, 0});
+        }
+
+        {
+            Opm::EclIO::EclOutput unsmry(formatted ? "TMP1.FUNSMRY" : "TMP1.UNSMRY", formatted);
+            for (int step = 0; step < nSteps; step++) {
+                std::vector<float> params(nParams);
+                params[0] = step + 1;
+                for (int i = 1; i < nParams; i++)
+                    params[i] = 0.25f * step + i;
+
+                unsmry.write<int>("SEQHDR", {step});
+                unsmry.write<int>("MINISTEP", {step});
+                unsmry.write<float>("PARAMS", params);
+            }
+        }
+
+        ESmry full(smspecFile);
+        full.loadData();
+
+        const std::vector<std::string> subset = {"WBHP:W11999", "TIME", "WBHP:W1", "WBHP:W1000", "WBHP:W1001", "WBHP:W1"};
+        ESmry partial(smspecFile);
+        partial.loadData(subset);
+
+        for (const auto& key : subset)
+            BOOST_CHECK_MESSAGE(partial.get(key) == full.get(key), "Vector " << key << " differs");
+
+        BOOST_CHECK_EQUAL(partial.get("WBHP:W1000").size(), static_cast<std::size_t>(nSteps));
+        BOOST_CHECK_CLOSE(partial.get("WBHP:W1000")[2], 1000.5f, 1e-6);
+
+        ESmry all(smspecFile);
+        all.loadData(all.keywordList());
+        for (const auto& key : full.keywordList())
+            BOOST_REQUIRE_MESSAGE(all.get(key) == full.get(key), "Vector " << key << " differs");
+    }
+}
+
+
 namespace fs = std::filesystem;
 BOOST_AUTO_TEST_CASE(TestCreateRSM) {
     ESmry smry1("SPE1CASE1.SMSPEC");
@@ -673,3 +743,117 @@ BOOST_AUTO_TEST_CASE(Test_all_available_w_restart) {
 }
 
 
+BOOST_AUTO_TEST_CASE(TestESmry_update) {
+
+    WorkArea work;
+    work.copyIn("SPE1CASE1.SMSPEC");
+    work.copyIn("SPE1CASE1.UNSMRY");
+
+    std::vector<char> unsmry;
+    {
+        std::ifstream file("SPE1CASE1.UNSMRY", std::ios::binary);
+        unsmry.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    ESmry ref("SPE1CASE1.SMSPEC");
+
+    auto write_unsmry = [&unsmry](std::size_t size)
+    {
+        std::ofstream file("SPE1CASE1.UNSMRY", std::ios::binary | std::ios::trunc);
+        file.write(unsmry.data(), size);
+    };
+
+    // the file is cut inside arrays, as when reading the output from an active run
+    write_unsmry(unsmry.size() / 3 + 17);
+
+    ESmry smry("SPE1CASE1.SMSPEC");
+
+    const auto nstep_0 = smry.numberOfTimeSteps();
+    BOOST_CHECK(nstep_0 > 0);
+    BOOST_CHECK(nstep_0 < ref.numberOfTimeSteps());
+    BOOST_CHECK_EQUAL(smry.update(), 0);
+
+    // loaded before update, extended by update()
+    BOOST_CHECK_EQUAL(smry.get("FGOR").size(), nstep_0);
+
+    std::size_t nstep = nstep_0;
+    for (const auto size : { unsmry.size() / 2 + 5, unsmry.size() * 3 / 4 + 101, unsmry.size() }) {
+        write_unsmry(size);
+        nstep += smry.update();
+        BOOST_CHECK_EQUAL(smry.numberOfTimeSteps(), nstep);
+        BOOST_CHECK_EQUAL(smry.get("FGOR").size(), nstep);
+    }
+
+    BOOST_CHECK_EQUAL(smry.numberOfTimeSteps(), ref.numberOfTimeSteps());
+
+    for (const auto& key : { "TIME", "FGOR", "WBHP:PROD", "BPR:1,1,1" }) {
+        const auto& vect = smry.get(key);
+        const auto& ref_vect = ref.get(key);
+        BOOST_CHECK(range_equal(vect.begin(), vect.end(), ref_vect.begin(), ref_vect.end()));
+
+        const auto rstep = smry.get_at_rstep(key);
+        const auto ref_rstep = ref.get_at_rstep(key);
+        BOOST_CHECK(range_equal(rstep.begin(), rstep.end(), ref_rstep.begin(), ref_rstep.end()));
+    }
+
+    BOOST_CHECK_EQUAL(smry.all_steps_available(), ref.all_steps_available());
+
+    // non-unified files, a new file for each report step
+    {
+        Opm::EclIO::EclOutput smspec1("TMP2.SMSPEC", false);
+        smspec1.write<int>("INTEHEAD", {1,100});
+        smspec1.write("RESTART", std::vector<std::string>(9, ""));
+        smspec1.write<int>("DIMENS", {2, 10, 10, 3, 0, 0});
+        smspec1.write<std::string>("KEYWORDS", {"TIME", "FOPR"});
+        smspec1.write<std::string>("WGNAMES", {":+:+:+:+", ":+:+:+:+"});
+        smspec1.write<int>("NUMS", {0, 0});
+        smspec1.write<std::string>("UNITS", {"DAYS", "SM3/DAY"});
+        smspec1.write<int>("STARTDAT", {1, 11, 2018, 0, 0, 0});
+    }
+
+    {
+        Opm::EclIO::EclOutput s0001("TMP2.S0001", false);
+        s0001.write<int>("SEQHDR", {1});
+        s0001.write<int>("MINISTEP", {0});
+        s0001.write<float>("PARAMS", {1, 10});
+        s0001.write<int>("MINISTEP", {1});
+        s0001.write<float>("PARAMS", {2, 20});
+    }
+
+    ESmry smry2("TMP2.SMSPEC");
+    BOOST_CHECK_EQUAL(smry2.numberOfTimeSteps(), 2);
+    BOOST_CHECK_EQUAL(smry2.get_at_rstep("FOPR").size(), 1);
+
+    {
+        Opm::EclIO::EclOutput s0001("TMP2.S0001", false, std::ios::app);
+        s0001.write<int>("MINISTEP", {2});
+        s0001.write<float>("PARAMS", {3, 30});
+
+        Opm::EclIO::EclOutput s0002("TMP2.S0002", false);
+        s0002.write<int>("SEQHDR", {2});
+        s0002.write<int>("MINISTEP", {3});
+        s0002.write<float>("PARAMS", {4, 40});
+        s0002.write<int>("MINISTEP", {4});
+    }
+
+    BOOST_CHECK_EQUAL(smry2.update(), 2);
+
+    const std::vector<float> fopr_ref = {10, 20, 30, 40};
+    const auto& fopr = smry2.get("FOPR");
+    BOOST_CHECK(range_equal(fopr.begin(), fopr.end(), fopr_ref.begin(), fopr_ref.end()));
+
+    const std::vector<float> fopr_rstep_ref = {30, 40};
+    const auto fopr_rstep = smry2.get_at_rstep("FOPR");
+    BOOST_CHECK(range_equal(fopr_rstep.begin(), fopr_rstep.end(), fopr_rstep_ref.begin(), fopr_rstep_ref.end()));
+
+    // the PARAMS array of the last MINISTEP is written
+    {
+        Opm::EclIO::EclOutput s0002("TMP2.S0002", false, std::ios::app);
+        s0002.write<float>("PARAMS", {5, 50});
+    }
+
+    BOOST_CHECK_EQUAL(smry2.update(), 1);
+    BOOST_CHECK_EQUAL(smry2.get("TIME").back(), 5.0f);
+    BOOST_CHECK_EQUAL(smry2.get_at_rstep("TIME").size(), 2);
+    BOOST_CHECK_EQUAL(smry2.all_steps_available(), true);
+}
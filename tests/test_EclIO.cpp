@@ -28,6 +28,10 @@
 #include <tuple>
 #include <cmath>
 #include <numeric>
+#include <random>
+#include <sstream>
+#include <cstring>
+#include <iterator>
 
 #include <opm/io/eclipse/EclFile.hpp>
 #include <opm/io/eclipse/EclUtil.hpp>
@@ -195,6 +199,60 @@ BOOST_AUTO_TEST_CASE(TestEclFile_BINARY) {
 }
 
 
+BOOST_AUTO_TEST_CASE(TestEclFile_BINARY_threads) {
+
+    WorkArea work;
+    {
+        EclOutput eclTest("TEST.DAT", false);
+        for (int n = 0; n < 20; n++) {
+            eclTest.write("INTE", std::vector<int>(1000 * n + 7, n));
+            eclTest.write("REAL", std::vector<float>(100 * n, 0.5f * n));
+            eclTest.write("DOUB", std::vector<double>(2001, 0.25 * n));
+            eclTest.write("LOGI", std::vector<bool>(n, n % 2 == 0));
+            eclTest.write("CHAR", std::vector<std::string>(n + 1, "C" + std::to_string(n)));
+        }
+    }
+
+    EclFile file1("TEST.DAT");
+    file1.loadData();
+
+    EclFile file2("TEST.DAT");
+    file2.setNumThreads(4);
+    BOOST_CHECK_EQUAL(file2.numThreads(), 4U);
+    file2.loadData();
+
+    EclFile file3("TEST.DAT");
+    file3.setNumThreads(3);
+    file3.loadData(std::vector<int>{ 99, 3, 50, 3, 0, 61, 99 });
+    file3.loadData("REAL");
+
+    for (std::size_t index = 0; index < file1.size(); index++) {
+        switch (std::get<1>(file1.getList()[index])) {
+        case INTE:
+            BOOST_CHECK(file2.get<int>(index) == file1.get<int>(index));
+            BOOST_CHECK(file3.get<int>(index) == file1.get<int>(index));
+            break;
+        case REAL:
+            BOOST_CHECK(file2.get<float>(index) == file1.get<float>(index));
+            BOOST_CHECK(file3.get<float>(index) == file1.get<float>(index));
+            break;
+        case DOUB:
+            BOOST_CHECK(file2.get<double>(index) == file1.get<double>(index));
+            BOOST_CHECK(file3.get<double>(index) == file1.get<double>(index));
+            break;
+        case LOGI:
+            BOOST_CHECK(file2.get<bool>(index) == file1.get<bool>(index));
+            BOOST_CHECK(file3.get<bool>(index) == file1.get<bool>(index));
+            break;
+        default:
+            BOOST_CHECK(file2.get<std::string>(index) == file1.get<std::string>(index));
+            BOOST_CHECK(file3.get<std::string>(index) == file1.get<std::string>(index));
+            break;
+        }
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(TestEclFile_FORMATTED) {
 
     std::string testFile1="ECLFILE.INIT";
@@ -300,6 +358,34 @@ BOOST_AUTO_TEST_CASE(TestEcl_Write_binary) {
     BOOST_CHECK_EQUAL(compare_files(inputFile, testFile), true);
 }
 
+BOOST_AUTO_TEST_CASE(TestEcl_Write_binary_multiple_blocks) {
+
+    // Sizes around the 1000 element record size for INTE, REAL and DOUB arrays.
+    WorkArea work;
+    for (const int size : { 0, 1, 999, 1000, 1001, 2500 }) {
+        std::vector<int> inte(size);
+        std::vector<float> real(size);
+        std::vector<double> doub(size);
+        for (int i = 0; i < size; i++) {
+            inte[i] = (i % 2 == 0) ? i : -i * 7919;
+            real[i] = 1.0f / (i + 3) - 0.5f * i;
+            doub[i] = std::sqrt(static_cast<double>(i)) - 1.0e10 * (i % 3);
+        }
+
+        {
+            EclOutput eclTest("TEST.DAT", false);
+            eclTest.write("INTE", inte);
+            eclTest.write("REAL", real);
+            eclTest.write("DOUB", doub);
+        }
+
+        EclFile file1("TEST.DAT");
+        BOOST_CHECK(file1.get<int>("INTE") == inte);
+        BOOST_CHECK(file1.get<float>("REAL") == real);
+        BOOST_CHECK(file1.get<double>("DOUB") == doub);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(TestEcl_Write_formatted) {
 
     std::string inputFile="ECLFILE.FINIT";
@@ -358,6 +444,195 @@ BOOST_AUTO_TEST_CASE(TestEcl_Write_formatted_not_finite) {
 }
 
 
+namespace {
+
+// The snprintf() based formatting which was used by EclOutput originally.
+std::string reference_real_ecl(float value)
+{
+    if (value == 0.0)
+        return "0.00000000E+00";
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof buffer, "%10.7E", value);
+    std::string tmpstr(buffer);
+
+    const int exp = value < 0.0 ? std::stoi(tmpstr.substr(11, 3)) : std::stoi(tmpstr.substr(10, 3));
+    if (value < 0.0)
+        tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 7) + "E";
+    else
+        tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 7) + "E";
+
+    std::snprintf(buffer, sizeof buffer, "%+03i", exp + 1);
+    return tmpstr + buffer;
+}
+
+std::string reference_doub_ecl(double value)
+{
+    if (value == 0.0)
+        return "0.00000000000000D+00";
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof buffer, "%19.13E", value);
+    std::string tmpstr(buffer);
+
+    const int exp = value < 0.0 ? std::stoi(tmpstr.substr(17, 4)) : std::stoi(tmpstr.substr(16, 4));
+    const std::string exp_char = ((exp >= -100) && (exp < 99)) ? "D" : "";
+    if (value < 0.0)
+        tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 13) + exp_char;
+    else
+        tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 13) + exp_char;
+
+    std::snprintf(buffer, sizeof buffer, "%+03i", exp + 1);
+    return tmpstr + buffer;
+}
+
+std::vector<std::string> formatted_tokens(const std::string& fname)
+{
+    std::ifstream stream(fname);
+    std::vector<std::string> tokens;
+    std::string line;
+
+    while (std::getline(stream, line)) {
+        if (line.find('\'') != std::string::npos)
+            continue;
+
+        std::istringstream line_stream(line);
+        std::string token;
+        while (line_stream >> token)
+            tokens.push_back(token);
+    }
+
+    return tokens;
+}
+
+std::string file_content(const std::string& fname)
+{
+    std::ifstream stream(fname);
+    return { std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(TestEcl_Write_formatted_reference) {
+    WorkArea work;
+
+    std::mt19937_64 gen(42);
+    std::vector<float> real { 1.0f, -1.0f, 0.5f, 9.9999999e9f, 1.23456789e-30f,
+                              std::numeric_limits<float>::max(),
+                              std::numeric_limits<float>::min(),
+                              std::numeric_limits<float>::denorm_min(),
+                              -std::numeric_limits<float>::denorm_min() };
+    std::vector<double> doub { 1.0, -1.0, 0.1, 9.99999999999995e98, 1.0e99, 1.0e-100, 1.0e-101,
+                               -2.5e-101, 1.0e200, -3.0e-250,
+                               std::numeric_limits<double>::max(),
+                               std::numeric_limits<double>::denorm_min() };
+
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-30, 30);
+    std::uniform_int_distribution<std::uint64_t> bits;
+    while (real.size() < 5000) {
+        real.push_back(static_cast<float>(mantissa(gen) * std::pow(10.0, exponent(gen))));
+
+        double value;
+        const auto value_bits = bits(gen);
+        std::memcpy(&value, &value_bits, sizeof value);
+        if (std::isfinite(value))
+            doub.push_back(value);
+    }
+
+    {
+        EclOutput eclTest("TEST1.FDAT", true);
+        eclTest.write("REAL", real);
+        eclTest.write("DOUB", doub);
+    }
+
+    const auto tokens = formatted_tokens("TEST1.FDAT");
+    BOOST_REQUIRE_EQUAL(tokens.size(), real.size() + doub.size());
+
+    for (std::size_t i = 0; i < real.size(); i++)
+        BOOST_CHECK_EQUAL(tokens[i], reference_real_ecl(real[i]));
+
+    for (std::size_t i = 0; i < doub.size(); i++)
+        BOOST_CHECK_EQUAL(tokens[real.size() + i], reference_doub_ecl(doub[i]));
+
+    // Threaded formatting must give the same file.
+    std::vector<int> inte(50000);
+    std::iota(inte.begin(), inte.end(), -100);
+    std::vector<bool> logi(3001);
+    logi[7] = true;
+
+    for (const auto fname : { "TEST1.FDAT", "TEST2.FDAT" }) {
+        EclOutput eclTest(fname, true);
+        if (std::string(fname) == "TEST2.FDAT")
+            eclTest.setNumThreads(3);
+
+        eclTest.write("REAL", real);
+        eclTest.write("DOUB", doub);
+        eclTest.write("INTE", inte);
+        eclTest.write("LOGI", logi);
+    }
+
+    BOOST_CHECK(file_content("TEST1.FDAT") == file_content("TEST2.FDAT"));
+}
+
+
+BOOST_AUTO_TEST_CASE(TestEclFile_FORMATTED_threads) {
+    WorkArea work;
+
+    std::mt19937_64 gen(17);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-150, 150);
+
+    std::vector<int> inte(200000);
+    std::vector<float> real(inte.size());
+    std::vector<double> doub(inte.size());
+    std::vector<bool> logi(inte.size());
+    for (std::size_t i = 0; i < inte.size(); i++) {
+        inte[i] = static_cast<int>(i) - 1000;
+        real[i] = static_cast<float>(mantissa(gen) * std::pow(10.0, exponent(gen) / 5));
+        doub[i] = mantissa(gen) * std::pow(10.0, exponent(gen));
+        logi[i] = (i % 3) == 0;
+    }
+
+    {
+        EclOutput eclTest("TEST.FINIT", true);
+        eclTest.write("INTE", inte);
+        eclTest.write("REAL", real);
+        eclTest.write("DOUB", doub);
+        eclTest.write("LOGI", logi);
+    }
+
+    EclFile file1("TEST.FINIT");
+    file1.loadData();
+
+    EclFile file2("TEST.FINIT");
+    file2.setNumThreads(4);
+    file2.loadData();
+
+    BOOST_CHECK(file1.get<int>("INTE") == inte);
+    BOOST_CHECK(file2.get<int>("INTE") == inte);
+    BOOST_CHECK(file1.get<bool>("LOGI") == logi);
+    BOOST_CHECK(file2.get<bool>("LOGI") == logi);
+    BOOST_CHECK(file1.get<float>("REAL") == file2.get<float>("REAL"));
+    BOOST_CHECK(file1.get<double>("DOUB") == file2.get<double>("DOUB"));
+
+    const auto& doub1 = file1.get<double>("DOUB");
+    BOOST_REQUIRE_EQUAL(doub1.size(), doub.size());
+    for (std::size_t i = 0; i < doub.size(); i++)
+        BOOST_CHECK_CLOSE(doub1[i], doub[i], 1.0e-11);
+
+    const std::string values = " 0.50000000000000D+01 -0.10000000000000-100  0.10000000000000+101\n  0.25E+00";
+    const auto parsed = readFormattedDoubArray(values, 4, 0);
+    BOOST_CHECK_EQUAL(parsed[0], 5.0);
+    BOOST_CHECK_EQUAL(parsed[1], -1.0e-101);
+    BOOST_CHECK_EQUAL(parsed[2], 1.0e100);
+    BOOST_CHECK_EQUAL(parsed[3], 0.25);
+
+    BOOST_CHECK_THROW(readFormattedDoubArray(" 0.1D+01  X.Y", 2, 0), std::invalid_argument);
+    BOOST_CHECK_THROW(readFormattedInteArray(" 1 2", 3, 0), std::runtime_error);
+}
+
+
 BOOST_AUTO_TEST_CASE(TestEcl_getList) {
 
     std::string inputFile="ECLFILE.INIT";
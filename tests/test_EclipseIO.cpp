@@ -44,11 +44,13 @@
 #include <opm/io/eclipse/EclFile.hpp>
 #include <opm/io/eclipse/EGrid.hpp>
 #include <opm/io/eclipse/ERst.hpp>
+#include <opm/io/eclipse/ESmry.hpp>
 
 #include <opm/common/utility/TimeService.hpp>
 
 #include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <map>
 #include <numeric>
 #include <string>
@@ -232,6 +234,12 @@ void checkRestartFile( int timeStepIdx ) {
     }
 }
 
+std::vector<char> readFile(const std::string& fname)
+{
+    std::ifstream file( fname, std::ios::binary );
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
 time_t ecl_util_make_date( const int day, const int month, const int year )
 {
     const auto ymd = Opm::TimeStampUTC::YMD{ year, month, day };
@@ -395,3 +403,90 @@ BOOST_AUTO_TEST_CASE(EclipseIOIntegration) {
      */
     BOOST_CHECK_EQUAL( file_size, write_and_check( 3, 5 ) );
 }
+
+BOOST_AUTO_TEST_CASE(EclipseIOAsyncOutput) {
+    const char *deckString =
+        "RUNSPEC\n"
+        "UNIFOUT\n"
+        "OIL\n"
+        "GAS\n"
+        "WATER\n"
+        "METRIC\n"
+        "DIMENS\n"
+        "3 3 3/\n"
+        "GRID\n"
+        "DXV\n"
+        "1.0 2.0 3.0 /\n"
+        "DYV\n"
+        "4.0 5.0 6.0 /\n"
+        "DZV\n"
+        "7.0 8.0 9.0 /\n"
+        "TOPS\n"
+        "9*100 /\n"
+        "PORO \n"
+        "  27*0.15 /\n"
+        "PERMX\n"
+        "27*1 /\n"
+        "SOLUTION\n"
+        "RPTRST\n"
+        "BASIC=2\n"
+        "/\n"
+        "SUMMARY\n"
+        "FOPR\n"
+        "SCHEDULE\n"
+        "TSTEP\n"
+        "1.0 2.0 3.0 4.0 5.0 /\n";
+
+    const auto deck = Parser().parseString( deckString );
+
+    auto write_steps = [&deck](const std::string& base_name, const std::size_t max_pending_steps) {
+        auto es = EclipseState( deck );
+        const auto& eclGrid = es.getInputGrid();
+        Schedule schedule(deck, es, std::make_shared<Python>());
+        SummaryConfig summary_config( deck, schedule, es.fieldProps(), es.aquifer());
+        es.getIOConfig().setBaseName( base_name );
+
+        EclipseIO eclWriter( es, eclGrid , schedule, summary_config);
+        eclWriter.setAsyncOutput(max_pending_steps);
+
+        const auto start_time = ecl_util_make_date( 10, 10, 2008 );
+        SummaryState st(TimeService::from_time_t(start_time));
+        for (int i = 1; i < static_cast<int>(schedule.size()); ++i) {
+            st.update("FOPR", 100.0 * i);
+
+            Action::State action_state;
+            WellTestState wtest_state;
+            UDQState udq_state(1);
+            RestartValue restart_value(createBlackoilState( i, 3 * 3 * 3 ), {}, {}, {});
+            eclWriter.writeTimeStep( action_state,
+                                     wtest_state,
+                                     st,
+                                     udq_state,
+                                     i,
+                                     false,
+                                     86400.0 * i,
+                                     std::move(restart_value));
+
+            // The state passed in has been copied, and can be changed
+            // before the step is written.
+            st.update("FOPR", -1.0);
+        }
+    };
+
+    WorkArea work_area("test_ecl_writer_async");
+    write_steps("SYNC", 0);
+    write_steps("ASYNC", 2);
+
+    for (const auto* ext : { ".UNRST", ".SMSPEC", ".UNSMRY" }) {
+        const auto sync_file = readFile(std::string { "SYNC" } + ext);
+        const auto async_file = readFile(std::string { "ASYNC" } + ext);
+
+        BOOST_CHECK_MESSAGE( !sync_file.empty(), std::string { "Missing output file SYNC" } + ext );
+        BOOST_CHECK_MESSAGE( sync_file == async_file, std::string { "Output files differ for " } + ext );
+    }
+
+    EclIO::ESmry smry("ASYNC.SMSPEC");
+    const auto& fopr = smry.get("FOPR");
+    BOOST_REQUIRE_EQUAL( fopr.size(), 5U );
+    BOOST_CHECK_CLOSE( fopr.back(), 500.0, 1.0e-6 );
+}
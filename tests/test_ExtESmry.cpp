@@ -20,6 +20,8 @@
 
 #include <opm/io/eclipse/ESmry.hpp>
 #include <opm/io/eclipse/ExtESmry.hpp>
+#include <opm/io/eclipse/ExtSmryOutput.hpp>
+#include <opm/io/eclipse/SmryCompression.hpp>
 #include <opm/common/utility/FileSystem.hpp>
 
 #define BOOST_TEST_MODULE Test EclIO
@@ -28,11 +30,18 @@
 #include <opm/io/eclipse/EclFile.hpp>
 #include <opm/io/eclipse/EclOutput.hpp>
 
+#include <opm/input/eclipse/Deck/Deck.hpp>
+#include <opm/input/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/input/eclipse/Parser/Parser.hpp>
+#include <opm/common/utility/TimeService.hpp>
+
 #include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <math.h>
 #include <stdio.h>
 #include <tuple>
@@ -40,8 +49,10 @@
 #include "tests/WorkArea.hpp"
 
 
+using Opm::EclIO::EclOutput;
 using Opm::EclIO::ESmry;
 using Opm::EclIO::ExtESmry;
+using Opm::EclIO::ExtSmryOutput;
 
 template<typename InputIterator1, typename InputIterator2>
 bool
@@ -415,3 +426,405 @@ BOOST_AUTO_TEST_CASE(TestESmry_3) {
     for (size_t n = 63; n < fopt.size(); n++)
         BOOST_REQUIRE_CLOSE(fopt[n], fopt_rst_ref[n-63], 0.01);
 }
+
+BOOST_AUTO_TEST_CASE(TestExtSmryOutput_chunks) {
+    const auto deck = Opm::Parser{}.parseString(R"(RUNSPEC
+DIMENS
+ 1 1 1 /
+START
+ 1 JAN 2000 /
+GRID
+DX
+ 1*100 /
+DY
+ 1*100 /
+DZ
+ 1*10 /
+TOPS
+ 1*2000 /
+PORO
+ 1*0.2 /
+)");
+
+    WorkArea work;
+
+    Opm::EclipseState es(deck);
+    es.getIOConfig().setOutputDir(".");
+    es.getIOConfig().setBaseName("CHUNKS");
+
+    const auto start_time = Opm::asTimeT(Opm::TimeStampUTC{ Opm::TimeStampUTC::YMD{ 2000, 1, 1 }});
+
+    ExtSmryOutput smry_out({"TIME", "FOPT", "WOPR:PROD"}, {"DAYS", "SM3", "SM3/DAY"}, es, start_time, false, true);
+
+    auto write_steps = [&smry_out](int from, int to)
+    {
+        for (int n = from; n < to; n++)
+            smry_out.write({static_cast<float>(n), 10.0f * n, 100.0f + n}, n % 2, n == to - 1);
+    };
+
+    // two chunks, the file is only appended to after the first chunk
+    write_steps(0, 4);
+    const auto size_first_chunk = std::filesystem::file_size("CHUNKS.ESMRY");
+    write_steps(4, 6);
+    BOOST_CHECK(std::filesystem::file_size("CHUNKS.ESMRY") > size_first_chunk);
+
+    {
+        ExtESmry esmry("CHUNKS.ESMRY");
+
+        BOOST_CHECK_EQUAL(esmry.numberOfTimeSteps(), 6);
+        BOOST_CHECK_EQUAL(esmry.numberOfVectors(), 3);
+
+        const auto& fopt = esmry.get("FOPT");
+        const auto& wopr = esmry.get("WOPR:PROD");
+
+        BOOST_REQUIRE_EQUAL(fopt.size(), 6);
+        for (int n = 0; n < 6; n++) {
+            BOOST_CHECK_EQUAL(fopt[n], 10.0f * n);
+            BOOST_CHECK_EQUAL(wopr[n], 100.0f + n);
+        }
+
+        BOOST_CHECK_EQUAL(esmry.get_at_rstep("TIME").size(), 3);
+        BOOST_CHECK_EQUAL(esmry.get_unit("FOPT"), "SM3");
+    }
+
+    // a chunk which is only partly written, as after a crash, is not used
+    {
+        EclOutput outFile("CHUNKS.ESMRY", false, std::ios::app);
+        outFile.write<int>("CHUNK", {5, 3});
+        outFile.write<int>("RSTEP", {0, 0, 0, 0, 0});
+    }
+
+    {
+        ExtESmry esmry("CHUNKS.ESMRY");
+
+        BOOST_CHECK_EQUAL(esmry.numberOfTimeSteps(), 6);
+        BOOST_CHECK_EQUAL(esmry.get("FOPT").back(), 50.0f);
+    }
+
+    // the writer removes the partly written chunk before the next chunk is appended
+    write_steps(6, 7);
+
+    {
+        ExtESmry esmry("CHUNKS.ESMRY");
+
+        BOOST_CHECK_EQUAL(esmry.numberOfTimeSteps(), 7);
+
+        const auto& time = esmry.get("TIME");
+        for (int n = 0; n < 7; n++)
+            BOOST_CHECK_EQUAL(time[n], static_cast<float>(n));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestExtSmryOutput_classic) {
+    const std::string deck_string = R"(RUNSPEC
+DIMENS
+ 1 1 1 /
+START
+ 1 JAN 2000 /
+GRID
+DX
+ 1*100 /
+DY
+ 1*100 /
+DZ
+ 1*10 /
+TOPS
+ 1*2000 /
+PORO
+ 1*0.2 /
+)";
+
+    WorkArea work;
+
+    Opm::EclipseState es(Opm::Parser{}.parseString(deck_string));
+    es.getIOConfig().setOutputDir(".");
+    es.getIOConfig().setBaseName("CLASSIC");
+
+    const auto start_time = Opm::asTimeT(Opm::TimeStampUTC{ Opm::TimeStampUTC::YMD{ 2000, 1, 1 }});
+
+    {
+        ExtSmryOutput smry_out({"TIME", "FOPT"}, {"DAYS", "SM3"}, es, start_time);
+
+        for (int n = 0; n < 4; n++)
+            smry_out.write({static_cast<float>(n), 10.0f * n}, 1, n == 1 || n == 3);
+    }
+
+    // the default layout has a single RSTEP, TSTEP and V0 .. Vn array
+    Opm::EclIO::EclFile file("CLASSIC.ESMRY");
+    const auto arrays = file.getList();
+
+    BOOST_CHECK(std::none_of(arrays.begin(), arrays.end(),
+                             [](const auto& array) { return std::get<0>(array) == "CHUNK"; }));
+    BOOST_CHECK_EQUAL(file.count("RSTEP"), 1);
+    BOOST_CHECK_EQUAL(file.get<float>("V1").size(), 4);
+
+    ExtESmry esmry("CLASSIC.ESMRY");
+    BOOST_CHECK_EQUAL(esmry.numberOfTimeSteps(), 4);
+    BOOST_CHECK_EQUAL(esmry.get("FOPT").back(), 30.0f);
+
+    // the chunked layout is not supported for formatted output
+    Opm::EclipseState fmt_es(Opm::Parser{}.parseString("RUNSPEC\nFMTOUT\n" + deck_string.substr(8)));
+    fmt_es.getIOConfig().setOutputDir(".");
+    BOOST_CHECK_THROW(ExtSmryOutput({"TIME"}, {"DAYS"}, fmt_es, start_time, false, true), std::invalid_argument);
+    BOOST_CHECK_THROW(ExtSmryOutput({"TIME"}, {"DAYS"}, fmt_es, start_time, true), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestExtESmry_update) {
+    const auto deck = Opm::Parser{}.parseString(R"(RUNSPEC
+DIMENS
+ 1 1 1 /
+START
+ 1 JAN 2000 /
+GRID
+DX
+ 1*100 /
+DY
+ 1*100 /
+DZ
+ 1*10 /
+TOPS
+ 1*2000 /
+PORO
+ 1*0.2 /
+)");
+
+    WorkArea work;
+
+    Opm::EclipseState es(deck);
+    es.getIOConfig().setOutputDir(".");
+
+    const auto start_time = Opm::asTimeT(Opm::TimeStampUTC{ Opm::TimeStampUTC::YMD{ 2000, 1, 1 }});
+
+    for (const bool compressed : { false, true }) {
+        const std::string rootName = compressed ? "FOLLOW_COMPRESSED" : "FOLLOW";
+        es.getIOConfig().setBaseName(rootName);
+
+        ExtSmryOutput smry_out({"TIME", "FOPT"}, {"DAYS", "SM3"}, es, start_time, compressed, true);
+
+        auto write_steps = [&smry_out](int from, int to)
+        {
+            for (int n = from; n < to; n++)
+                smry_out.write({static_cast<float>(n), 10.0f * n}, n % 3 == 0, n == to - 1);
+        };
+
+        write_steps(0, 4);
+
+        ExtESmry esmry(rootName + ".ESMRY");
+
+        BOOST_CHECK_EQUAL(esmry.get("FOPT").size(), 4);
+        BOOST_CHECK_EQUAL(esmry.update(), 0);
+
+        write_steps(4, 7);
+
+        BOOST_CHECK_EQUAL(esmry.update(), 3);
+        BOOST_CHECK_EQUAL(esmry.numberOfTimeSteps(), 7);
+
+        // a chunk which is only partly written is read by a later update
+        {
+            EclOutput outFile(rootName + ".ESMRY", false, std::ios::app);
+            outFile.write<int>("CHUNK", {5, 2});
+            outFile.write<int>("RSTEP", {0, 0, 0, 0, 0});
+        }
+
+        BOOST_CHECK_EQUAL(esmry.update(), 0);
+
+        write_steps(7, 9);
+
+        BOOST_CHECK_EQUAL(esmry.update(), 2);
+        BOOST_CHECK_EQUAL(esmry.numberOfTimeSteps(), 9);
+
+        const auto& fopt = esmry.get("FOPT");
+        const auto& time = esmry.get("TIME");
+
+        BOOST_REQUIRE_EQUAL(fopt.size(), 9);
+        BOOST_REQUIRE_EQUAL(time.size(), 9);
+
+        for (int n = 0; n < 9; n++) {
+            BOOST_CHECK_EQUAL(fopt[n], 10.0f * n);
+            BOOST_CHECK_EQUAL(time[n], static_cast<float>(n));
+        }
+
+        ExtESmry ref(rootName + ".ESMRY");
+        const auto rstep = esmry.get_at_rstep("FOPT");
+        const auto ref_rstep = ref.get_at_rstep("FOPT");
+
+        BOOST_CHECK_EQUAL(rstep.size(), 3);
+        BOOST_CHECK(range_equal(rstep.begin(), rstep.end(), ref_rstep.begin(), ref_rstep.end()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestSmryCompression_roundtrip) {
+    const auto bits = [](float value)
+    {
+        std::uint32_t b;
+        std::memcpy(&b, &value, sizeof b);
+        return b;
+    };
+
+    std::vector<std::vector<float>> vectors;
+
+    vectors.push_back(std::vector<float>(1000, 1200.0f));
+
+    std::vector<float> cumulative { 0.0f };
+    for (int n = 1; n < 1000; n++)
+        cumulative.push_back(cumulative.back() + 100.0f + 0.37f * (n % 17));
+
+    vectors.push_back(cumulative);
+
+    std::vector<float> mixed { 1.0f, -0.0f, 0.0f, std::numeric_limits<float>::quiet_NaN(),
+                               std::numeric_limits<float>::infinity(), 1.0e-40f, -3.5e38f, 7.0f };
+    for (std::uint32_t n = 0; n < 500; n++) {
+        const std::uint32_t b = n * 2654435761u;
+        float value;
+        std::memcpy(&value, &b, sizeof value);
+        mixed.push_back(value);
+    }
+
+    vectors.push_back(mixed);
+    vectors.push_back({3.0f});
+
+    for (const auto& vect : vectors) {
+        const auto words = Opm::EclIO::compressSmryVector(vect.data(), vect.size());
+
+        std::vector<float> decoded { 42.0f };
+        Opm::EclIO::decompressSmryVector(words.data(), words.size(), vect.size(), decoded);
+
+        BOOST_REQUIRE_EQUAL(decoded.size(), vect.size() + 1);
+        BOOST_CHECK_EQUAL(decoded[0], 42.0f);
+
+        for (size_t n = 0; n < vect.size(); n++)
+            BOOST_CHECK_EQUAL(bits(decoded[n + 1]), bits(vect[n]));
+    }
+
+    // constant vector, one bit pr time step after the first value
+    const auto words = Opm::EclIO::compressSmryVector(vectors[0].data(), vectors[0].size());
+    BOOST_CHECK_EQUAL(words.size(), 1 + (999 + 31) / 32);
+
+    // missing data
+    std::vector<float> decoded;
+    BOOST_CHECK_THROW(Opm::EclIO::decompressSmryVector(words.data(), 2, 1000, decoded), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(TestExtESmry_compressed) {
+    WorkArea work;
+    work.copyIn("SPE1CASE1.SMSPEC");
+    work.copyIn("SPE1CASE1.UNSMRY");
+
+    ESmry smry1("SPE1CASE1.SMSPEC");
+    smry1.make_esmry_file();
+    std::filesystem::rename("SPE1CASE1.ESMRY", "SPE1CASE1_PLAIN.ESMRY");
+    smry1.make_esmry_file(true);
+
+    BOOST_CHECK(std::filesystem::file_size("SPE1CASE1.ESMRY") < std::filesystem::file_size("SPE1CASE1_PLAIN.ESMRY") / 2);
+
+    ExtESmry esmry1("SPE1CASE1.ESMRY");
+    ExtESmry esmry2("SPE1CASE1_PLAIN.ESMRY");
+
+    BOOST_CHECK_EQUAL(esmry1.numberOfTimeSteps(), 123);
+    BOOST_CHECK_EQUAL(esmry1.numberOfVectors(), esmry2.numberOfVectors());
+    BOOST_CHECK_EQUAL(esmry1.get_at_rstep("TIME") == esmry2.get_at_rstep("TIME"), true);
+
+    BOOST_CHECK_EQUAL(esmry1.get("WBHP:PROD") == smry1.get("WBHP:PROD"), true);
+
+    esmry1.loadData();
+
+    for (const auto& key : esmry2.keywordList())
+        BOOST_CHECK_MESSAGE(esmry1.get(key) == esmry2.get(key), "compressed vector " + key + " differs");
+}
+
+BOOST_AUTO_TEST_CASE(TestExtESmry_corrupt_vindex) {
+    WorkArea work;
+
+    const std::vector<float> time { 0.0f, 1.0f, 2.0f };
+    const std::vector<float> fopt { 0.0f, 10.0f, 20.0f };
+
+    std::vector<int> vdata;
+    for (const auto& vect : { time, fopt }) {
+        const auto words = Opm::EclIO::compressSmryVector(vect.data(), vect.size());
+        vdata.insert(vdata.end(), words.begin(), words.end());
+    }
+
+    const int time_size = static_cast<int>(Opm::EclIO::compressSmryVector(time.data(), time.size()).size());
+    const int vdata_size = static_cast<int>(vdata.size());
+
+    const auto write_file = [&vdata](const std::string& fileName, const std::vector<int>& vindex)
+    {
+        EclOutput outFile(fileName, false, std::ios::out);
+        outFile.write<int>("START", {1, 1, 2000, 0, 0, 0, 0});
+        outFile.write<std::string>("KEYCHECK", {"TIME", "FOPT"});
+        outFile.write<std::string>("UNITS", {"DAYS", "SM3"});
+        outFile.write<int>("CHUNK", {3, 2, static_cast<int>(Opm::EclIO::SmryCodec::XorFloat)});
+        outFile.write<int>("RSTEP", {1, 1, 1});
+        outFile.write<int>("TSTEP", {0, 1, 2});
+        outFile.write<int>("VINDEX", vindex);
+        outFile.write<int>("VDATA", vdata);
+    };
+
+    write_file("VALID.ESMRY", {0, time_size, vdata_size});
+    {
+        ExtESmry esmry("VALID.ESMRY");
+        BOOST_CHECK(esmry.get("FOPT") == fopt);
+    }
+
+    // too short, decreasing, and past the end of VDATA
+    for (const auto& vindex : std::vector<std::vector<int>> { {0, time_size},
+                                                              {0, vdata_size, time_size},
+                                                              {0, time_size, vdata_size + 100} })
+    {
+        write_file("CORRUPT.ESMRY", vindex);
+        BOOST_CHECK_THROW(ExtESmry("CORRUPT.ESMRY").get("FOPT"), std::runtime_error);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestExtSmryOutput_compressed_chunks) {
+    const auto deck = Opm::Parser{}.parseString(R"(RUNSPEC
+DIMENS
+ 1 1 1 /
+START
+ 1 JAN 2000 /
+GRID
+DX
+ 1*100 /
+DY
+ 1*100 /
+DZ
+ 1*10 /
+TOPS
+ 1*2000 /
+PORO
+ 1*0.2 /
+)");
+
+    WorkArea work;
+
+    Opm::EclipseState es(deck);
+    es.getIOConfig().setOutputDir(".");
+    es.getIOConfig().setBaseName("COMPRESSED");
+
+    const auto start_time = Opm::asTimeT(Opm::TimeStampUTC{ Opm::TimeStampUTC::YMD{ 2000, 1, 1 }});
+
+    ExtSmryOutput smry_out({"TIME", "FOPR", "FOPT"}, {"DAYS", "SM3/DAY", "SM3"}, es, start_time, true);
+
+    const int num_tstep = 2 * Opm::EclIO::compressedSmryChunkSize + 10;
+
+    for (int n = 0; n < num_tstep; n++)
+        smry_out.write({static_cast<float>(n), 1000.0f, 1000.0f * n}, n % 10 == 0, n == num_tstep - 1);
+
+    ExtESmry esmry("COMPRESSED.ESMRY");
+
+    BOOST_CHECK_EQUAL(esmry.numberOfTimeSteps(), num_tstep);
+
+    const auto& time = esmry.get("TIME");
+    const auto& fopr = esmry.get("FOPR");
+    const auto& fopt = esmry.get("FOPT");
+
+    BOOST_REQUIRE_EQUAL(fopt.size(), num_tstep);
+
+    for (int n = 0; n < num_tstep; n++) {
+        BOOST_CHECK_EQUAL(time[n], static_cast<float>(n));
+        BOOST_CHECK_EQUAL(fopr[n], 1000.0f);
+        BOOST_CHECK_EQUAL(fopt[n], 1000.0f * n);
+    }
+
+    BOOST_CHECK_EQUAL(esmry.get_at_rstep("FOPT").size(), 53);
+}
@@ -811,6 +811,105 @@ BOOST_AUTO_TEST_CASE(Unformatted_Unified)
     }
 }
 
+BOOST_AUTO_TEST_CASE(Unformatted_Unified_Rewrite)
+{
+    const auto rset = RSet("CASE");
+    const auto fmt  = ::Opm::EclIO::OutputStream::Formatted{ false };
+    const auto unif = ::Opm::EclIO::OutputStream::Unified  { true };
+
+    const auto fname = ::Opm::EclIO::OutputStream::
+        outputFileName(rset, "UNRST");
+
+    auto writeStep = [&rset, &fmt, &unif](const int seqnum)
+    {
+        auto rst = ::Opm::EclIO::OutputStream::Restart {
+            rset, seqnum, fmt, unif
+        };
+
+        rst.write("I", std::vector<int>   (seqnum, seqnum));
+        rst.write("D", std::vector<double>(1000 + seqnum, 0.5 * seqnum));
+    };
+
+    auto checkSteps = [&fname](const std::vector<int>& expect_seqnum)
+    {
+        auto rst = ::Opm::EclIO::ERst{fname};
+
+        const auto seqnum = rst.listOfReportStepNumbers();
+        BOOST_CHECK_EQUAL_COLLECTIONS(seqnum.begin(), seqnum.end(),
+                                      expect_seqnum.begin(),
+                                      expect_seqnum.end());
+
+        for (const auto& step : seqnum) {
+            rst.loadReportStepNumber(step);
+
+            const auto& I = rst.getRestartData<int>("I", step, 0);
+            BOOST_CHECK_EQUAL(I.size(), static_cast<std::size_t>(step));
+
+            const auto& D = rst.getRestartData<double>("D", step, 0);
+            BOOST_REQUIRE_EQUAL(D.size(), static_cast<std::size_t>(1000 + step));
+            BOOST_CHECK_EQUAL(D.back(), 0.5 * step);
+        }
+    };
+
+    for (const auto& seqnum : {1, 2, 3, 4}) {
+        writeStep(seqnum);
+    }
+
+    checkSteps({1, 2, 3, 4});
+
+    // Rewrite from report step 3 and continue.
+    writeStep(3);
+    checkSteps({1, 2, 3});
+
+    writeStep(4);
+    writeStep(6);
+    checkSteps({1, 2, 3, 4, 6});
+
+    // Report step appended by someone else must be taken into account.
+    {
+        auto out = ::Opm::EclIO::EclOutput{ fname, false, std::ios::app };
+
+        out.write("SEQNUM", std::vector<int>{ 7 });
+        out.write("I", std::vector<int>(7, 7));
+        out.write("D", std::vector<double>(1007, 3.5));
+    }
+
+    writeStep(8);
+    checkSteps({1, 2, 3, 4, 6, 7, 8});
+
+    writeStep(7);
+    checkSteps({1, 2, 3, 4, 6, 7});
+
+    // Moved-from stream must not affect the index.
+    {
+        auto rst1 = ::Opm::EclIO::OutputStream::Restart {
+            rset, 9, fmt, unif
+        };
+
+        auto rst2 = std::move(rst1);
+
+        rst2.write("I", std::vector<int>   (9, 9));
+        rst2.write("D", std::vector<double>(1009, 4.5));
+    }
+
+    writeStep(10);
+    checkSteps({1, 2, 3, 4, 6, 7, 9, 10});
+
+    // File removed and created again.  The positions of the report steps
+    // in the old file must not be used.
+    std::filesystem::remove(fname);
+
+    writeStep(5);
+    writeStep(6);
+    checkSteps({5, 6});
+
+    writeStep(2);
+    checkSteps({2});
+
+    writeStep(3);
+    checkSteps({2, 3});
+}
+
 BOOST_AUTO_TEST_CASE(Formatted_Separate)
 {
     const auto rset = RSet("CASE.T01.");
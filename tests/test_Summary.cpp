@@ -30,6 +30,10 @@
 #include <cctype>
 #include <ctime>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
 
 #include <fmt/format.h>
 
@@ -47,6 +51,9 @@
 #include <opm/input/eclipse/Units/UnitSystem.hpp>
 #include <opm/input/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/input/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/input/eclipse/Schedule/Action/ActionX.hpp>
+#include <opm/input/eclipse/Schedule/Action/Actions.hpp>
+#include <opm/input/eclipse/Schedule/Action/SimulatorUpdate.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
 #include <opm/input/eclipse/Schedule/Well/PAvgCalculatorCollection.hpp>
 #include <opm/input/eclipse/Schedule/Well/Well.hpp>
@@ -56,8 +63,10 @@
 #include <opm/input/eclipse/Units/Units.hpp>
 #include <opm/input/eclipse/Units/UnitSystem.hpp>
 
+#include <opm/io/eclipse/EclFile.hpp>
 #include <opm/io/eclipse/ESmry.hpp>
 #include <opm/io/eclipse/ERsm.hpp>
+#include <opm/io/eclipse/ExtESmry.hpp>
 
 #include <tests/WorkArea.hpp>
 
@@ -2482,6 +2491,115 @@ BOOST_AUTO_TEST_CASE(efficiency_factor) {
         BOOST_CHECK_CLOSE( 200.1 * 0.2 * 0.01, ecl_sum_get_well_connection_var( resp, 1, "W_2", "COPT", 2, 1, 1 ), 1e-5 );
 }
 
+BOOST_AUTO_TEST_CASE(efficiency_factor_cache) {
+    // SUMMARY_EFF_FAC.DATA with an action which changes WEFAC of W_3.
+    std::string deck_string;
+    {
+        std::ifstream is("SUMMARY_EFF_FAC.DATA");
+        deck_string.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+    deck_string.insert(deck_string.find("\nTSTEP"), R"(
+ACTIONX
+  'EFAC' /
+  WWCT 'W_3' > 0.75 /
+/
+WEFAC
+  'W_3' 0.5 /
+/
+ENDACTIO
+)");
+
+    const auto deck = Parser{}.parseString(deck_string);
+    const EclipseState es(deck);
+    Schedule schedule(deck, es, std::make_shared<Python>());
+    const SummaryConfig config(deck, schedule, es.fieldProps(), es.aquifer());
+    const auto wells = result_wells(false);
+    const auto grp_nwrk = result_group_nwrk();
+    WorkArea ta("summary_test");
+
+    out::Summary writer( es, config, es.getInputGrid(), schedule, "TEST_EFFICIENCY_FACTOR_CACHE" );
+    SummaryState st(TimeService::now());
+
+    writer.eval( st, 1, 1 * day, wells, grp_nwrk, {}, {}, {}, {});
+    BOOST_CHECK_CLOSE( 0.3 * 0.02 * 0.03, st.get_well_var("W_3", "WEFFG"), 1e-5 );
+    BOOST_CHECK_CLOSE( 30.1 * 0.3 * 0.02, st.get_group_var("G_4", "GOIR"), 1e-5 );
+    BOOST_CHECK_CLOSE( 30.1 * 0.3 * 0.02 * 0.03, st.get("FOIR"), 1e-5 );
+
+    // GEFAC of G_4 changes at report step 2.
+    writer.eval( st, 2, 2 * day, wells, grp_nwrk, {}, {}, {}, {});
+    BOOST_CHECK_CLOSE( 0.3 * 0.02 * 0.04, st.get_well_var("W_3", "WEFFG"), 1e-5 );
+    BOOST_CHECK_CLOSE( 30.1 * 0.3 * 0.02, st.get_group_var("G_4", "GOIR"), 1e-5 );
+    BOOST_CHECK_CLOSE( 30.1 * 0.3 * 0.02 * 0.04, st.get("FOIR"), 1e-5 );
+    const auto foit = st.get("FOIT");
+
+    // The action replaces the well objects of the step evaluated for report
+    // step 2.
+    const auto& action = schedule[1].actions.get()["EFAC"];
+    schedule.applyAction(1, action, {}, {});
+
+    writer.eval( st, 2, 3 * day, wells, grp_nwrk, {}, {}, {}, {});
+    BOOST_CHECK_CLOSE( 0.5, st.get_well_var("W_3", "WEFF"), 1e-5 );
+    BOOST_CHECK_CLOSE( 0.5 * 0.02 * 0.04, st.get_well_var("W_3", "WEFFG"), 1e-5 );
+    BOOST_CHECK_CLOSE( 30.1 * 0.5 * 0.02, st.get_group_var("G_4", "GOIR"), 1e-5 );
+    BOOST_CHECK_CLOSE( 30.1 * 0.5 * 0.02 * 0.04, st.get("FOIR"), 1e-5 );
+    BOOST_CHECK_CLOSE( foit + 30.1 * 0.5 * 0.02 * 0.04, st.get("FOIT"), 1e-5 );
+
+    // Going back to an earlier report step uses the factors of that step.
+    writer.eval( st, 1, 4 * day, wells, grp_nwrk, {}, {}, {}, {});
+    BOOST_CHECK_CLOSE( 0.3 * 0.02 * 0.03, st.get_well_var("W_3", "WEFFG"), 1e-5 );
+    BOOST_CHECK_CLOSE( 30.1 * 0.3 * 0.02 * 0.03, st.get("FOIR"), 1e-5 );
+}
+
+BOOST_AUTO_TEST_CASE(esmry_layout) {
+    for (const bool chunked : { false, true }) {
+        setup cfg( "test_summary_esmry" );
+        cfg.es.getIOConfig().setOutputDir(".");
+        cfg.es.getIOConfig().setBaseName(cfg.name);
+        cfg.es.getIOConfig().setChunkedESMRY(chunked);
+
+        SummaryState st(TimeService::now());
+        out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name, true );
+        for (int step = 0; step < 3; ++step) {
+            writer.eval(st, step, step*day, cfg.wells, cfg.grp_nwrk, {}, {}, {}, {});
+            writer.add_timestep( st, step, false);
+        }
+        writer.write(true);
+
+        BOOST_CHECK_EQUAL( EclIO::EclFile(cfg.name + ".ESMRY").hasKey("CHUNK"), chunked );
+
+        EclIO::ExtESmry esmry(cfg.name + ".ESMRY");
+        const auto& wopr = esmry.get("WOPR:W_1");
+        BOOST_REQUIRE_EQUAL( wopr.size(), 3U );
+        BOOST_CHECK_CLOSE( wopr[2], 10.1, 1e-5 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(multithreaded_eval) {
+    setup cfg( "test_multithreaded_eval" );
+
+    const auto start = TimeService::now();
+    SummaryState st_serial(start);
+    SummaryState st_threaded(start);
+
+    out::Summary serial( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    out::Summary threaded( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    threaded.setNumThreads(4);
+
+    const auto block_values = out::Summary::BlockValues {
+        {{"BPR", 1}, 123.0}, {{"BPR", 2}, 456.0}
+    };
+
+    for (int step = 0; step < 3; step++) {
+        serial.eval( st_serial, step, step * day, cfg.wells, cfg.grp_nwrk, {}, {}, {}, {}, {}, block_values);
+        threaded.eval( st_threaded, step, step * day, cfg.wells, cfg.grp_nwrk, {}, {}, {}, {}, {}, block_values);
+
+        BOOST_CHECK_EQUAL( st_serial.size(), st_threaded.size() );
+        BOOST_CHECK( st_serial == st_threaded );
+    }
+
+    BOOST_CHECK_CLOSE( 2 * 10.0, st_threaded.get_well_var("W_1", "WWPT"), 1e-5 );
+}
+
 
 
 
@@ -4414,6 +4532,61 @@ BOOST_AUTO_TEST_CASE(SummaryState_TOTAL) {
 }
 
 
+BOOST_AUTO_TEST_CASE(SummaryState_handles) {
+    SummaryState st(TimeService::now());
+    BOOST_CHECK( !st.handle("FOPR").has_value() );
+    BOOST_CHECK( !st.well_var_handle("OP1", "WOPT").has_value() );
+
+    st.update("FOPR", 100);
+    st.update_well_var("OP1", "WOPT", 100);
+    st.update_conn_var("OP1", "COPR", 7, 10);
+    st.update_segment_var("OP1", "SOFR", 2, 20);
+
+    const auto fopr = st.handle("FOPR");
+    const auto wopt = st.well_var_handle("OP1", "WOPT");
+    const auto copr = st.conn_var_handle("OP1", "COPR", 7);
+    const auto sofr = st.segment_var_handle("OP1", "SOFR", 2);
+    BOOST_REQUIRE( fopr.has_value() && wopt.has_value() && copr.has_value() && sofr.has_value() );
+    BOOST_CHECK( !st.conn_var_handle("OP1", "COPR", 8).has_value() );
+    BOOST_CHECK( !st.group_var_handle("OP1", "WOPT").has_value() );
+
+    const auto layout = st.layout_id();
+    st.update(*fopr, 200);
+    st.update(*wopt, 50);
+    st.update(*copr, 11);
+    st.update(*sofr, 21);
+    BOOST_CHECK_EQUAL( st.layout_id(), layout );
+
+    BOOST_CHECK_EQUAL( st.get(*fopr), 200 );
+    BOOST_CHECK_EQUAL( st.get("FOPR"), 200 );
+    BOOST_CHECK_EQUAL( st.get_well_var("OP1", "WOPT"), 150 );
+    BOOST_CHECK_EQUAL( st.get("WOPT:OP1"), 150 );
+    BOOST_CHECK_EQUAL( st.get_conn_var("OP1", "COPR", 7), 11 );
+    BOOST_CHECK_EQUAL( st.get("COPR:OP1:7"), 11 );
+    BOOST_CHECK_EQUAL( st.get_segment_var("OP1", "SOFR", 2), 21 );
+    BOOST_CHECK_EQUAL( st.slot_values()[sofr->slot], 21 );
+
+    // Copies share the slot layout.
+    auto copy = st;
+    BOOST_CHECK_EQUAL( copy.layout_id(), layout );
+    copy.update(*wopt, 50);
+    BOOST_CHECK_EQUAL( copy.get_well_var("OP1", "WOPT"), 200 );
+    BOOST_CHECK_EQUAL( st.get_well_var("OP1", "WOPT"), 150 );
+
+    st.update("FGPR", 1);
+    BOOST_CHECK( st.layout_id() != layout );
+    BOOST_CHECK( copy.layout_id() == layout );
+
+    const auto before_erase = st.layout_id();
+    BOOST_CHECK( st.erase("WOPT:OP1") );
+    BOOST_CHECK( st.layout_id() != before_erase );
+
+    // The general key starts from zero again when it is added back.
+    st.update_well_var("OP1", "WOPT", 10);
+    BOOST_CHECK_EQUAL( st.get_well_var("OP1", "WOPT"), 160 );
+    BOOST_CHECK_EQUAL( st.get("WOPT:OP1"), 10 );
+}
+
 BOOST_AUTO_TEST_CASE(append_summary_state) {
     auto now = TimeService::now();
     SummaryState st1(now);
@@ -4438,5 +4611,62 @@ BOOST_AUTO_TEST_CASE(append_summary_state) {
     BOOST_CHECK_EQUAL(st_both.get_group_var("G1", "WOPR"), 3000);
 }
 
+BOOST_AUTO_TEST_CASE(SummaryState_slot_reuse) {
+    SummaryState st(TimeService::now());
+    st.update("FOPR", 1);
+    st.update_well_var("OP1", "WOPR", 2);
+    st.update_conn_var("OP1", "COPR", 7, 3);
+    const auto num_slots = st.slot_values().size();
+
+    for (int i = 0; i < 10; ++i) {
+        BOOST_CHECK( st.erase("FOPR") );
+        BOOST_CHECK( st.erase_well_var("OP1", "WOPR") );
+        st.update("FOPR", i);
+        st.update_well_var("OP1", "WOPR", 2*i);
+    }
+    BOOST_CHECK_EQUAL( st.slot_values().size(), num_slots );
+    BOOST_CHECK_EQUAL( st.get("FOPR"), 9 );
+    BOOST_CHECK_EQUAL( st.get("WOPR:OP1"), 18 );
+    BOOST_CHECK_EQUAL( st.get_well_var("OP1", "WOPR"), 18 );
+
+    // The values which are not in the buffer are dropped, and their slots
+    // are reused for the values in the next buffer.
+    for (int i = 0; i < 10; ++i) {
+        SummaryState buffer(TimeService::now());
+        const auto well = "OP" + std::to_string(i);
+        buffer.update("FOPR", i);
+        buffer.update_well_var(well, "WOPR", 2*i);
+        buffer.update_conn_var(well, "COPR", 7, 3*i);
+        st.append(buffer);
+
+        BOOST_CHECK_EQUAL( st.get("FOPR"), i );
+        BOOST_CHECK_EQUAL( st.get_well_var(well, "WOPR"), 2*i );
+        BOOST_CHECK_EQUAL( st.get_conn_var(well, "COPR", 7), 3*i );
+        BOOST_CHECK( !st.has("WOPR:OP1") || (i == 1) );
+        BOOST_CHECK( !st.has_conn_var("OP1", "COPR", 7) || (i == 1) );
+
+        st.update_well_var(well, "WOPR", 1);
+        BOOST_CHECK_EQUAL( st.get("WOPR:" + well), 1 );
+    }
+    BOOST_CHECK_EQUAL( st.slot_values().size(), num_slots );
+}
+
+BOOST_AUTO_TEST_CASE(SummaryState_iterator) {
+    SummaryState st(TimeService::now());
+    st.update("FOPR", 1);
+    st.update("FGPR", 2);
+
+    SummaryState::const_iterator iter{};
+    iter = st.begin();
+
+    std::map<std::string, double> values;
+    for (; iter != st.end(); ++iter)
+        values.emplace(iter->first, iter->second);
+
+    BOOST_CHECK_EQUAL( values.size(), 2U );
+    BOOST_CHECK_EQUAL( values.at("FOPR"), 1 );
+    BOOST_CHECK_EQUAL( values.at("FGPR"), 2 );
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()